@@ -0,0 +1,111 @@
+/**
+  * @file BatchFrame.h
+  * @brief Packs every reading of one polling window into a single MQTT message.
+  *
+  * Publishing one message per reading costs a topic string, an MQTT header and
+  * a broker round of routing each time, far more than the 20 byte reading
+  * itself. A batched frame carries all readings of the window, each tagged with
+  * its sensor id, and is published once on "drones/data/<esp_id>/_batch".
+  *
+  * Layout, all fields little endian:
+  *
+  *   offset  size  field
+  *   0       1     magic, BATCH_FRAME_MAGIC
+  *   1       1     version, BATCH_FRAME_VERSION
+  *   2       1     entry count
+  *   3       1     reserved, 0
+  *
+  * followed by the entries, back to back:
+  *
+  *   0       1     sensor id length n, 1 to BATCH_MAX_SENSOR_ID
+  *   1       n     sensor id, without terminating zero
+  *   1 + n   20    the reading, in the binary payload layout of DroneSensor.h
+  *
+  * The Pi side decoder lives in PiDrone/SensorModel.h, keep both in sync.
+  * Nothing in here depends on the Arduino core, so the encoder also builds on
+  * a host with the shim in PiDrone/bench/arduino_shim.
+*/
+
+#pragma once
+
+#include "DroneSensor.h"
+
+const uint8_t BATCH_FRAME_MAGIC = 0xD6;
+const uint8_t BATCH_FRAME_VERSION = 1;
+const size_t BATCH_FRAME_HEADER_SIZE = 4;
+const size_t BATCH_MAX_SENSOR_ID = 63;
+const size_t BATCH_MAX_ENTRIES = 255;
+// PubSubClient's default packet buffer is 256 bytes, this leaves room for the topic and the MQTT header.
+const size_t BATCH_FRAME_CAPACITY = 192;
+
+/**
+  * @class BatchFrameBuilder
+  * @brief Accumulates readings into a batched frame held in a fixed buffer.
+*/
+class BatchFrameBuilder {
+  public:
+    BatchFrameBuilder() {
+      clear();
+    }
+
+    /**
+      * @brief Starts a new, empty frame.
+    */
+    void clear() {
+      buffer_[0] = BATCH_FRAME_MAGIC;
+      buffer_[1] = BATCH_FRAME_VERSION;
+      buffer_[2] = 0;
+      buffer_[3] = 0;
+      size_ = BATCH_FRAME_HEADER_SIZE;
+    }
+
+    /**
+      * @brief Appends the latest reading of a sensor.
+      *
+      * The sensor's binary payload, and with it its sequence number, is only
+      * built once the entry is known to fit.
+      *
+      * @return bool false if the frame is full, publish and clear() it, then add again.
+      * Also false if the sensor id is empty or too long, that one never fits.
+    */
+    bool add(DroneSensor& sensor) {
+      const char* sensorId = sensor.getSensorId();
+      size_t idLength = strlen(sensorId);
+      if (idLength == 0 || idLength > BATCH_MAX_SENSOR_ID || !fits(idLength)) {
+        return false;
+      }
+      buffer_[size_] = (uint8_t)idLength;
+      memcpy(buffer_ + size_ + 1, sensorId, idLength);
+      size_t written = sensor.buildBinaryPayload(buffer_ + size_ + 1 + idLength, BINARY_PAYLOAD_SIZE);
+      if (written != BINARY_PAYLOAD_SIZE) {
+        return false;
+      }
+      size_ += 1 + idLength + BINARY_PAYLOAD_SIZE;
+      buffer_[2]++;
+      return true;
+    }
+
+    bool empty() const {
+      return buffer_[2] == 0;
+    }
+
+    size_t count() const {
+      return buffer_[2];
+    }
+
+    const uint8_t* data() const {
+      return buffer_;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+  private:
+    uint8_t buffer_[BATCH_FRAME_CAPACITY];
+    size_t size_;
+
+    bool fits(size_t idLength) const {
+      return count() < BATCH_MAX_ENTRIES && size_ + 1 + idLength + BINARY_PAYLOAD_SIZE <= BATCH_FRAME_CAPACITY;
+    }
+};
\ No newline at end of file
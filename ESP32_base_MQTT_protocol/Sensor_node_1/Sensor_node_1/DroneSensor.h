@@ -10,6 +10,35 @@
 #pragma once
 
 #include <ArduinoJson.h>
+#include <string.h>
+
+/**
+  * @brief Fixed layout binary payload, the compact alternative to the JSON payload.
+  *
+  * All fields little endian, 20 bytes in total:
+  *
+  *   offset  size  field
+  *   0       1     magic, BINARY_PAYLOAD_MAGIC (never the first byte of a JSON document)
+  *   1       1     version, BINARY_PAYLOAD_VERSION
+  *   2       1     sensor type, see SensorType
+  *   3       1     flags, bit 0 = presence
+  *   4       4     sequence number, per sensor, wraps around
+  *   8       4     timestamp_ms, millis() of the reading
+  *   12      4     range_m, float
+  *   16      4     speed_ms, float
+  *
+  * The Pi side decoder lives in PiDrone/SensorModel.h, keep both in sync.
+*/
+const uint8_t BINARY_PAYLOAD_MAGIC = 0xD5;
+const uint8_t BINARY_PAYLOAD_VERSION = 1;
+const size_t BINARY_PAYLOAD_SIZE = 20;
+const uint8_t BINARY_FLAG_PRESENCE = 0x01;
+
+enum SensorType : uint8_t {
+  SENSOR_TYPE_UNKNOWN = 0,
+  SENSOR_TYPE_C4001 = 1,
+  SENSOR_TYPE_RCWL = 2
+};
 
 /**
   * @struct SensorData
@@ -36,11 +65,38 @@ class DroneSensor {
 
     virtual void buildJsonPayload(JsonDocument& doc) = 0;
 
+    /**
+      * @brief Serializes the latest reading into the binary payload layout.
+      * @return size_t Number of bytes written, 0 if the buffer is too small
+    */
+    size_t buildBinaryPayload(uint8_t* buffer, size_t size) {
+      if (size < BINARY_PAYLOAD_SIZE) {
+        return 0;
+      }
+      uint32_t sequence = sequence_++;
+      uint32_t timestamp = (uint32_t)latestData_.timestamp_ms;
+      float range = latestData_.presence ? latestData_.range_m : 0.0f;
+      float speed = latestData_.presence ? latestData_.speed_ms : 0.0f;
+
+      buffer[0] = BINARY_PAYLOAD_MAGIC;
+      buffer[1] = BINARY_PAYLOAD_VERSION;
+      buffer[2] = sensorType_;
+      buffer[3] = latestData_.presence ? BINARY_FLAG_PRESENCE : 0;
+      // The ESP32 is little endian, so the fields can be copied as they are.
+      memcpy(buffer + 4, &sequence, 4);
+      memcpy(buffer + 8, &timestamp, 4);
+      memcpy(buffer + 12, &range, 4);
+      memcpy(buffer + 16, &speed, 4);
+      return BINARY_PAYLOAD_SIZE;
+    }
+
     const char* getSensorId() const {
       return sensorId_;
     }
 
   protected:
     const char* sensorId_;
+    uint8_t sensorType_ = SENSOR_TYPE_UNKNOWN;
+    uint32_t sequence_ = 0;
     SensorData latestData_;
 };
\ No newline at end of file
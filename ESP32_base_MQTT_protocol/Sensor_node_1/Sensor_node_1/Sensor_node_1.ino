@@ -11,7 +11,9 @@
   *
   * It uses an OOP approach to handle sensors and FreeRTOS to manage sensor polling
   * and network communication independently. Data is published to a central MQTT
-  * broker in a structured JSON format.
+  * broker in a structured JSON format, or in the compact binary layout from
+  * DroneSensor.h when USE_BINARY_PAYLOAD is set. With USE_BATCH_FRAMES every
+  * reading of a window is packed into one message instead, see BatchFrame.h.
 */
 
 // --- Dependencies ---
@@ -19,6 +21,7 @@
 #include <PubSubClient.h>
 #include <ArduinoJson.h>
 #include "Sensors.h" // custom header with sensor class implementations
+#include "BatchFrame.h" // batched frame encoder
 // --- End dependencies ---
 
 // --- Hardware pin definitions ---
@@ -40,6 +43,12 @@ const int MQTT_PORT = 1883; // base mqtt port
 // --- Node Config ---
 // Each ESP32 must have a unique Identifier
 const char* ESP_ID = "esp32_1";
+// Publish the 20 byte binary payload instead of JSON, the Pi detects the format per message.
+const bool USE_BINARY_PAYLOAD = false;
+// Publish one batched frame per window on drones/data/<ESP_ID>/_batch instead of a message per reading.
+const bool USE_BATCH_FRAMES = false;
+// Batching window, 0 publishes the frame at the end of every polling cycle.
+const unsigned long BATCH_WINDOW_MS = 0;
 // --- End Node Config ---
 
 // --- Sensor Config ---
@@ -50,6 +59,7 @@ DroneSensor* sensors[NUM_SENSORS]; // Array of pointers to base sensor classes
 // --- Global Objects ---
 WiFiClient espClient;
 PubSubClient mqttClient(espClient);
+char batchTopic[64]; // built once in setup()
 // --- End Global Objects ---
 
 // --- Functions ---
@@ -91,6 +101,24 @@ void reconnect_mqtt() {
   }
 }
 
+/**
+  * @brief Publishes a batched frame, if it holds any reading, and starts a new one.
+*/
+void publishBatch(BatchFrameBuilder& batch) {
+  if (batch.empty()) {
+    return;
+  }
+  Serial.print("Publishing to ");
+  Serial.print(batchTopic);
+  Serial.print(": ");
+  Serial.print(batch.count());
+  Serial.print(" readings, ");
+  Serial.print(batch.size());
+  Serial.println(" bytes");
+  mqttClient.publish(batchTopic, batch.data(), batch.size());
+  batch.clear();
+}
+
 /**
   * @brief FreeRTOS task to poll all sensors and publish data.
   *
@@ -102,8 +130,18 @@ void reconnect_mqtt() {
 */
 void sensorProcessingTask(void *pvParameters) {
   Serial.println("Sensor Processing Task started.");
+  BatchFrameBuilder batch;
+  unsigned long windowStart = millis();
   for (;;) { // infinite loop
     for (int i = 0; i < NUM_SENSORS; i++) {
+      if (USE_BATCH_FRAMES) {
+        if (sensors[i]->readData() && !batch.add(*sensors[i])) {
+          // Frame full, send what we have and start the next one with this reading.
+          publishBatch(batch);
+          batch.add(*sensors[i]);
+        }
+        continue;
+      }
       if (sensors[i]->readData()) {
         // 1 create the MQTT topic string
         String topic = "drones/data/";
@@ -111,22 +149,38 @@ void sensorProcessingTask(void *pvParameters) {
         topic += "/";
         topic += sensors[i]->getSensorId();
 
-        // 2 Buld the payload
-        StaticJsonDocument<256> doc;
-        sensors[i]->buildJsonPayload(doc);
-        
-        char payload[256];
-        serializeJson(doc, payload);
-
-        // 3 publish data
-        Serial.print("Publishing to ");
-        Serial.print(topic);
-        Serial.print(": ");
-        Serial.println(payload);
-        mqttClient.publish(topic.c_str(), payload);
+        // 2 Buld the payload and 3 publish data
+        if (USE_BINARY_PAYLOAD) {
+          uint8_t payload[BINARY_PAYLOAD_SIZE];
+          size_t length = sensors[i]->buildBinaryPayload(payload, sizeof(payload));
+
+          Serial.print("Publishing to ");
+          Serial.print(topic);
+          Serial.print(": ");
+          Serial.print(length);
+          Serial.println(" bytes");
+          mqttClient.publish(topic.c_str(), payload, length);
+        } else {
+          StaticJsonDocument<256> doc;
+          sensors[i]->buildJsonPayload(doc);
+
+          char payload[256];
+          serializeJson(doc, payload);
+
+          Serial.print("Publishing to ");
+          Serial.print(topic);
+          Serial.print(": ");
+          Serial.println(payload);
+          mqttClient.publish(topic.c_str(), payload);
+        }
       }
     }
 
+    if (USE_BATCH_FRAMES && millis() - windowStart >= BATCH_WINDOW_MS) {
+      publishBatch(batch);
+      windowStart = millis();
+    }
+
     vTaskDelay(100 / portTICK_PERIOD_MS);
   }
 }
@@ -158,6 +212,8 @@ void setup() {
     }
   }
 
+  snprintf(batchTopic, sizeof(batchTopic), "drones/data/%s/_batch", ESP_ID);
+
   setup_wifi();
   mqttClient.setServer(MQTT_SERVER, MQTT_PORT);
 
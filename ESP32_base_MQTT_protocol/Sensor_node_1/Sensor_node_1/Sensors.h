@@ -24,6 +24,7 @@ public:
   RadarC4001(const char* id, HardwareSerial& serial, long baud, uint8_t rx, uint8_t tx)
     : radar_instance_(&serial, baud, rx, tx) {
     sensorId_ = id;
+    sensorType_ = SENSOR_TYPE_C4001;
     latestData_.presence = false;
   }
 
@@ -84,6 +85,7 @@ private:
 public:
   RadarRCWL(const char* id, uint8_t pin) : pin_(pin) {
     sensorId_ = id;
+    sensorType_ = SENSOR_TYPE_RCWL;
     latestData_.presence = false;
   }
 
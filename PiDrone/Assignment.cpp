@@ -0,0 +1,84 @@
+/**
+    * @file Assignment.cpp
+    * @brief Hungarian algorithm with row and column potentials.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "Assignment.h"
+#include <limits>
+#include <stdexcept>
+// --- End Imports ---
+
+/**
+    * @brief Adds the rows one at a time, each along a shortest augmenting path.
+    *
+    * Index 0 of the internal arrays is a virtual row/column, real rows and
+    * columns are 1-based there.
+*/
+double AssignmentSolver::solve(const std::vector<double>& cost, size_t rows, size_t cols, std::vector<size_t>& row_to_col) {
+    if (rows > cols) {
+        throw std::runtime_error("AssignmentSolver needs rows <= cols");
+    }
+    const double inf = std::numeric_limits<double>::infinity();
+    const size_t none = 0;
+
+    u_.assign(rows + 1, 0.0);
+    v_.assign(cols + 1, 0.0);
+    match_.assign(cols + 1, none);
+    way_.assign(cols + 1, none);
+
+    for (size_t row = 1; row <= rows; ++row) {
+        match_[0] = row;
+        size_t col0 = 0;
+        min_to_.assign(cols + 1, inf);
+        used_.assign(cols + 1, 0);
+
+        do {
+            used_[col0] = 1;
+            const size_t row0 = match_[col0];
+            const double* cost_row = cost.data() + (row0 - 1) * cols;
+            double delta = inf;
+            size_t col1 = 0;
+            for (size_t col = 1; col <= cols; ++col) {
+                if (used_[col]) continue;
+                const double reduced = cost_row[col - 1] - u_[row0] - v_[col];
+                if (reduced < min_to_[col]) {
+                    min_to_[col] = reduced;
+                    way_[col] = col0;
+                }
+                if (min_to_[col] < delta) {
+                    delta = min_to_[col];
+                    col1 = col;
+                }
+            }
+            for (size_t col = 0; col <= cols; ++col) {
+                if (used_[col]) {
+                    u_[match_[col]] += delta;
+                    v_[col] -= delta;
+                } else {
+                    min_to_[col] -= delta;
+                }
+            }
+            col0 = col1;
+        } while (match_[col0] != none);
+
+        // Flip the augmenting path.
+        do {
+            const size_t col1 = way_[col0];
+            match_[col0] = match_[col1];
+            col0 = col1;
+        } while (col0 != 0);
+    }
+
+    row_to_col.assign(rows, 0);
+    double total = 0.0;
+    for (size_t col = 1; col <= cols; ++col) {
+        if (match_[col] != none) {
+            row_to_col[match_[col] - 1] = col - 1;
+            total += cost[(match_[col] - 1) * cols + (col - 1)];
+        }
+    }
+    return total;
+}
@@ -0,0 +1,39 @@
+/**
+    * @file Assignment.h
+    * @brief Minimum cost assignment (Hungarian / Kuhn-Munkres) on a dense cost matrix.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * O(n^2 m) shortest augmenting path formulation with potentials. It is run on
+    * one small cluster of competing tracks and fixes at a time, so n stays tiny
+    * even when the total number of tracks is large. Buffers are kept between
+    * calls so a solver reused every scan does not allocate.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <cstddef>
+#include <vector>
+
+class AssignmentSolver {
+    // --- Private var declaration to be used ---
+    private:
+        std::vector<double> u_;
+        std::vector<double> v_;
+        std::vector<double> min_to_;
+        std::vector<size_t> match_;
+        std::vector<size_t> way_;
+        std::vector<char> used_;
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @brief Assigns every row to a distinct column minimizing the total cost.
+            * @param cost Row-major rows x cols matrix, rows <= cols
+            * @param row_to_col Output, the column chosen for each row
+            * @return double The total cost of the assignment
+        */
+        double solve(const std::vector<double>& cost, size_t rows, size_t cols, std::vector<size_t>& row_to_col);
+};
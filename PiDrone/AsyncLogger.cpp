@@ -0,0 +1,265 @@
+/**
+    * @file AsyncLogger.cpp
+    * @brief Rate limiting, the background writer and the three output formats.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "AsyncLogger.h"
+#include <cmath>
+#include <cstdarg>
+#include <cstring>
+#include <unistd.h>
+#include "ConsoleColors.h"
+// --- End Imports ---
+
+namespace {
+
+const char* const CATEGORY_NAMES[LOG_CATEGORY_COUNT] = {"system", "node", "sensor", "location", "track", "target"};
+const char* const LEVEL_NAMES[] = {"info", "warning", "error"};
+
+void append(std::string& out, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+void append(std::string& out, const char* fmt, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, fmt);
+    const int n = std::vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (n > 0) out.append(line, static_cast<size_t>(n) < sizeof(line) ? static_cast<size_t>(n) : sizeof(line) - 1);
+}
+
+// JSON has no NaN or infinity.
+void append_number(std::string& out, const char* key, double value) {
+    if (std::isfinite(value)) append(out, ",\"%s\":%.4f", key, value);
+    else append(out, ",\"%s\":null", key);
+}
+
+void append_string(std::string& out, const char* key, std::string_view value) {
+    append(out, ",\"%s\":\"", key);
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            append(out, "\\u%04x", static_cast<unsigned>(c));
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// Splits the "esp_id/sensor_id" source of a sensor update.
+std::pair<std::string_view, std::string_view> split_source(const char* text) {
+    std::string_view source(text);
+    const size_t slash = source.find('/');
+    if (slash == std::string_view::npos) return {source, {}};
+    return {source.substr(0, slash), source.substr(slash + 1)};
+}
+
+} // namespace
+
+void LogRecord::set_text(std::string_view s) {
+    const size_t n = s.size() < LOG_TEXT_SIZE - 1 ? s.size() : LOG_TEXT_SIZE - 1;
+    std::memcpy(text, s.data(), n);
+    text[n] = '\0';
+}
+
+void LogRecord::set_text(std::string_view a, std::string_view b) {
+    size_t n = a.size() < LOG_TEXT_SIZE - 1 ? a.size() : LOG_TEXT_SIZE - 1;
+    std::memcpy(text, a.data(), n);
+    if (n < LOG_TEXT_SIZE - 1) text[n++] = '/';
+    const size_t m = b.size() < LOG_TEXT_SIZE - 1 - n ? b.size() : LOG_TEXT_SIZE - 1 - n;
+    std::memcpy(text + n, b.data(), m);
+    text[n + m] = '\0';
+}
+
+AsyncLogger::AsyncLogger(AsyncLoggerConfig config)
+    : config_(config),
+      color_(config.color == AsyncLoggerConfig::Color::Always
+             || (config.color == AsyncLoggerConfig::Color::Auto && isatty(fileno(config.out)))),
+      ring_(config.capacity) {
+    buffer_.reserve(WRITE_BLOCK + 1024);
+    if (config_.format == LogFormat::Binary) {
+        const uint16_t record_size = sizeof(LogRecord);
+        std::fwrite(LOG_BINARY_MAGIC, 1, sizeof(LOG_BINARY_MAGIC), config_.out);
+        std::fwrite(&LOG_BINARY_VERSION, sizeof(LOG_BINARY_VERSION), 1, config_.out);
+        std::fwrite(&record_size, sizeof(record_size), 1, config_.out);
+    }
+    writer_ = std::thread([this] { writer_loop(); });
+}
+
+AsyncLogger::~AsyncLogger() {
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+}
+
+/**
+    * @brief Applies the category's sampling and one second rate window.
+    *
+    * Lock-free and approximate: when several threads cross a window boundary
+    * together a few records may be let through or held back at the edge.
+*/
+bool AsyncLogger::admit(LogCategory category, int64_t now) {
+    const LogLimit& limit = config_.limits[static_cast<size_t>(category)];
+    CategoryState& state = categories_[static_cast<size_t>(category)];
+
+    if (limit.sample_every > 1 && state.seen.fetch_add(1, std::memory_order_relaxed) % limit.sample_every != 0) {
+        state.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (limit.max_per_second > 0) {
+        int64_t start = state.window_start_ns.load(std::memory_order_relaxed);
+        if (now - start >= 1000000000LL && state.window_start_ns.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+            state.window_count.store(0, std::memory_order_relaxed);
+        }
+        if (state.window_count.fetch_add(1, std::memory_order_relaxed) >= limit.max_per_second) {
+            state.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    return true;
+}
+
+void AsyncLogger::format(const LogRecord& record) {
+    switch (config_.format) {
+        case LogFormat::Text:
+            format_text(record);
+            break;
+        case LogFormat::JsonLines:
+            format_json(record);
+            break;
+        case LogFormat::Binary:
+            buffer_.append(reinterpret_cast<const char*>(&record), sizeof(LogRecord));
+            break;
+    }
+}
+
+// Same lines the tracker used to print straight to std::cout.
+void AsyncLogger::format_text(const LogRecord& r) {
+    auto ansi = [this](const std::string& code) { return color_ ? code.c_str() : ""; };
+    const char* reset = ansi(STYLE_RESET);
+    switch (r.kind) {
+        case LogKind::Message: {
+            const char* color = r.level == LogLevel::Error ? ansi(FORE_RED) : r.level == LogLevel::Warning ? ansi(FORE_YELLOW) : "";
+            append(buffer_, "%s%s%s\n", color, r.text, reset);
+            break;
+        }
+        case LogKind::SensorUpdate: {
+            auto [esp, sensor] = split_source(r.text);
+            append(buffer_, "%sUPDATE | ESP: %-10.*s | Sensor: %-9.*s | Range: %-6.2f m | Speed: %-5.2f m/s%s\n",
+                   ansi(FORE_CYAN), static_cast<int>(esp.size()), esp.data(),
+                   static_cast<int>(sensor.size()), sensor.data(), r.values[0], r.values[1], reset);
+            break;
+        }
+        case LogKind::Location:
+            // The zone is only named when the site has more than one.
+            append(buffer_, "%s%s>>>>>> LOCATION (X,Y): (%6.2f, %6.2f) | Sensors: %u | Residual: %.2f m | Cond: %.1f%s%s%s\n",
+                   ansi(STYLE_BRIGHT), ansi(FORE_GREEN), r.values[0], r.values[1], r.count,
+                   r.values[2], r.values[3], r.text[0] ? " | Zone: " : "", r.text, reset);
+            break;
+        case LogKind::Track: {
+            // "<filter>/<zone>", the filter is named when it is not the TrackFilter, the zone when the site has several.
+            auto [filter, zone] = split_source(r.text);
+            append(buffer_, "%s%s====== TRACK (X,Y): (%6.2f, %6.2f) | Vel: (%5.2f, %5.2f) m/s | Sigma: %.2f m%s%.*s%s%.*s%s\n",
+                   ansi(STYLE_BRIGHT), ansi(FORE_YELLOW), r.values[0], r.values[1], r.values[2],
+                   r.values[3], r.values[4], filter.empty() ? "" : " | Filter: ", static_cast<int>(filter.size()), filter.data(),
+                   zone.empty() ? "" : " | Zone: ", static_cast<int>(zone.size()), zone.data(), reset);
+            break;
+        }
+        case LogKind::TargetEvent:
+            append(buffer_, "%s%s%s | ID: %llu | (X,Y): (%.2f, %.2f) | Hits: %u%s%s%s\n",
+                   ansi(STYLE_BRIGHT), ansi(r.flag ? FORE_GREEN : FORE_RED),
+                   r.flag ? "++++++ TARGET CONFIRMED" : "------ TARGET LOST", static_cast<unsigned long long>(r.id),
+                   r.values[0], r.values[1], r.count, r.text[0] ? " | Zone: " : "", r.text, reset);
+            break;
+    }
+}
+
+void AsyncLogger::format_json(const LogRecord& r) {
+    append(buffer_, "{\"t\":%.6f,\"category\":\"%s\"", static_cast<double>(r.time_ns) * 1e-9,
+           CATEGORY_NAMES[static_cast<size_t>(r.category)]);
+    switch (r.kind) {
+        case LogKind::Message:
+            append(buffer_, ",\"level\":\"%s\"", LEVEL_NAMES[static_cast<size_t>(r.level)]);
+            append_string(buffer_, "message", r.text);
+            break;
+        case LogKind::SensorUpdate: {
+            auto [esp, sensor] = split_source(r.text);
+            append_string(buffer_, "esp", esp);
+            append_string(buffer_, "sensor", sensor);
+            append_number(buffer_, "range", r.values[0]);
+            append_number(buffer_, "speed", r.values[1]);
+            break;
+        }
+        case LogKind::Location:
+            append_number(buffer_, "x", r.values[0]);
+            append_number(buffer_, "y", r.values[1]);
+            append(buffer_, ",\"sensors\":%u", r.count);
+            append_number(buffer_, "residual", r.values[2]);
+            append_number(buffer_, "condition", r.values[3]);
+            if (r.text[0]) append_string(buffer_, "zone", r.text);
+            break;
+        case LogKind::Track:
+            append_number(buffer_, "x", r.values[0]);
+            append_number(buffer_, "y", r.values[1]);
+            append_number(buffer_, "vx", r.values[2]);
+            append_number(buffer_, "vy", r.values[3]);
+            append_number(buffer_, "sigma", r.values[4]);
+            if (r.text[0]) {
+                auto [filter, zone] = split_source(r.text);
+                if (!filter.empty()) append_string(buffer_, "filter", filter);
+                if (!zone.empty()) append_string(buffer_, "zone", zone);
+            }
+            break;
+        case LogKind::TargetEvent:
+            append(buffer_, ",\"event\":\"%s\",\"id\":%llu", r.flag ? "confirmed" : "lost",
+                   static_cast<unsigned long long>(r.id));
+            append_number(buffer_, "x", r.values[0]);
+            append_number(buffer_, "y", r.values[1]);
+            append(buffer_, ",\"hits\":%u", r.count);
+            if (r.text[0]) append_string(buffer_, "zone", r.text);
+            break;
+    }
+    buffer_ += "}\n";
+}
+
+void AsyncLogger::write_buffer() {
+    if (buffer_.empty()) return;
+    std::fwrite(buffer_.data(), 1, buffer_.size(), config_.out);
+    buffer_.clear();
+}
+
+void AsyncLogger::writer_loop() {
+    uint64_t pending = 0;
+    for (;;) {
+        const size_t n = ring_.drain([&](LogRecord& record) {
+            format(record);
+            ++pending;
+            if (buffer_.size() >= WRITE_BLOCK) write_buffer();
+        });
+        if (n > 0) continue;
+
+        // Caught up, push everything out before going idle.
+        if (pending > 0) {
+            write_buffer();
+            std::fflush(config_.out);
+            written_.fetch_add(pending, std::memory_order_release);
+            pending = 0;
+        }
+        if (stop_.load(std::memory_order_acquire)) {
+            if (ring_.empty()) break;
+            continue;
+        }
+        std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
+
+void AsyncLogger::flush() {
+    const uint64_t target = enqueued_.load(std::memory_order_relaxed);
+    while (written_.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
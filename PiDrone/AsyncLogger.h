@@ -0,0 +1,199 @@
+/**
+    * @file AsyncLogger.h
+    * @brief Asynchronous, rate-limited log sink for the tracker's console output.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The worker threads never format or write anything. A log call checks the
+    * category's sampling and rate limit, copies a handful of numbers into a
+    * fixed size LogRecord claimed in a lock-free MPSC ring and returns. A
+    * background thread drains the ring, formats the records as colored text,
+    * JSON lines or raw binary records and writes them in large blocks, flushing
+    * once whenever it catches up. When the writer falls behind, the ring fills
+    * and further records are dropped and counted, the pipeline is never held up.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include "MpscRing.h"
+
+enum class LogCategory : uint8_t {
+    System,
+    Node,
+    Sensor,
+    Location,
+    Track,
+    Target,
+    Count
+};
+
+constexpr size_t LOG_CATEGORY_COUNT = static_cast<size_t>(LogCategory::Count);
+
+/**
+    * What a record holds, and so how it is formatted:
+    *
+    *   Message       text
+    *   SensorUpdate  text "esp_id/sensor_id", values range, speed
+    *   Location      values x, y, residual, condition number, count sensors used
+    *   Track         values x, y, vx, vy, position sigma, text "<filter>/<zone>", filter unless the TrackFilter
+    *   TargetEvent   values x, y, id, count hits, flag 1 if confirmed, 0 if lost, text zone
+*/
+enum class LogKind : uint8_t {
+    Message,
+    SensorUpdate,
+    Location,
+    Track,
+    TargetEvent
+};
+
+enum class LogLevel : uint8_t {
+    Info,
+    Warning,
+    Error
+};
+
+enum class LogFormat : uint8_t {
+    Text,
+    JsonLines,
+    // A LOG_BINARY_HEADER followed by the LogRecords exactly as they are in memory.
+    Binary
+};
+
+constexpr size_t LOG_TEXT_SIZE = 96;
+constexpr char LOG_BINARY_MAGIC[4] = {'P', 'D', 'L', 'G'};
+constexpr uint16_t LOG_BINARY_VERSION = 1;
+
+struct LogRecord {
+    int64_t time_ns = 0; // system clock, since the epoch
+    LogCategory category = LogCategory::System;
+    LogKind kind = LogKind::Message;
+    LogLevel level = LogLevel::Info;
+    uint8_t flag = 0;
+    uint32_t count = 0;
+    uint64_t id = 0;
+    double values[5] = {};
+    char text[LOG_TEXT_SIZE] = {}; // NUL terminated, truncated to fit
+
+    void set_text(std::string_view s);
+    // "<a>/<b>", for the source of a sensor update.
+    void set_text(std::string_view a, std::string_view b);
+};
+
+static_assert(std::is_trivially_copyable<LogRecord>::value, "binary log output writes records as raw bytes");
+
+/**
+    * @struct LogLimit
+    * @brief Per category sampling and rate limit, records past either are suppressed.
+*/
+struct LogLimit {
+    uint32_t sample_every = 1;   // keep one record in N
+    uint32_t max_per_second = 0; // 0 = unlimited
+};
+
+struct AsyncLoggerConfig {
+    LogFormat format = LogFormat::Text;
+    // Not owned, must outlive the logger.
+    FILE* out = stdout;
+    // ANSI colors in text output, by default only when out is a terminal.
+    enum class Color { Auto, Always, Never } color = Color::Auto;
+    size_t capacity = 16384;
+    std::array<LogLimit, LOG_CATEGORY_COUNT> limits{};
+};
+
+class AsyncLogger {
+    // --- Private var declaration to be used ---
+    private:
+        struct alignas(CACHE_LINE_SIZE) CategoryState {
+            std::atomic<uint64_t> seen{0};
+            std::atomic<int64_t> window_start_ns{0};
+            std::atomic<uint32_t> window_count{0};
+            std::atomic<uint64_t> suppressed{0};
+        };
+
+        static constexpr size_t WRITE_BLOCK = 64 * 1024;
+        static constexpr auto IDLE_SLEEP = std::chrono::milliseconds(1);
+
+        AsyncLoggerConfig config_;
+        bool color_;
+        MpscRing<LogRecord> ring_;
+        std::array<CategoryState, LOG_CATEGORY_COUNT> categories_;
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> enqueued_{0};
+        std::atomic<uint64_t> dropped_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> written_{0};
+        std::atomic<bool> stop_{false};
+        std::string buffer_;
+        std::thread writer_;
+
+        static int64_t now_ns() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        bool admit(LogCategory category, int64_t now);
+        void format(const LogRecord& record);
+        void format_text(const LogRecord& record);
+        void format_json(const LogRecord& record);
+        void write_buffer();
+        void writer_loop();
+
+    // --- Public method declarations ---
+    public:
+        explicit AsyncLogger(AsyncLoggerConfig config = {});
+        // Writes out everything that was accepted before returning.
+        ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        /**
+            * @brief Hot path entry, fill(LogRecord&) sets the kind specific fields in place.
+            *
+            * The record arrives with time, category and kind set and everything
+            * else cleared. fill must not throw and is not called at all if the
+            * record is suppressed or the ring is full.
+            *
+            * @return true if the record was queued.
+        */
+        template <typename Fill>
+        bool log(LogCategory category, LogKind kind, Fill&& fill) {
+            const int64_t now = now_ns();
+            if (!admit(category, now)) return false;
+            const bool queued = ring_.try_emplace([&](LogRecord& record) {
+                record = LogRecord{};
+                record.time_ns = now;
+                record.category = category;
+                record.kind = kind;
+                fill(record);
+            });
+            if (queued) enqueued_.fetch_add(1, std::memory_order_relaxed);
+            else dropped_.fetch_add(1, std::memory_order_relaxed);
+            return queued;
+        }
+
+        bool message(LogCategory category, LogLevel level, std::string_view text) {
+            return log(category, LogKind::Message, [&](LogRecord& record) {
+                record.level = level;
+                record.set_text(text);
+            });
+        }
+
+        // Blocks until every record queued before the call has been written and flushed.
+        void flush();
+
+        uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+        uint64_t suppressed(LogCategory category) const {
+            return categories_[static_cast<size_t>(category)].suppressed.load(std::memory_order_relaxed);
+        }
+};
@@ -0,0 +1,245 @@
+/**
+    * @file BatchMultilateration.cpp
+    * @brief Scalar, SSE2 and AVX2 kernels for bulk multilateration.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * All kernels compute exactly the same thing as SubsetSolver::solve(), laid out
+    * so the epoch loop is the vectorized one. The AVX2 kernel is compiled with a
+    * target attribute, so the rest of the program stays buildable for any x86-64.
+*/
+
+// --- Imports ---
+#include "BatchMultilateration.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define DRONE_HAVE_X86_SIMD 1
+#endif
+// --- End Imports ---
+
+namespace {
+
+/**
+    * @struct KernelArgs
+    * @brief The subset geometry flattened into plain arrays for the kernels.
+*/
+struct KernelArgs {
+    size_t sensors;
+    const double* const* ranges;
+    const double* m_x;
+    const double* m_y;
+    const double* k;
+    std::vector<double> pos_x;
+    std::vector<double> pos_y;
+    double inv_sensors;
+    double max_residual;
+    // False when the caller neither wants residuals nor filters on them.
+    bool need_residual;
+};
+
+size_t kernel_scalar(const KernelArgs& a, PositionBatch& out, size_t begin, size_t end) {
+    const double inf = std::numeric_limits<double>::infinity();
+    size_t valid_count = 0;
+
+    for (size_t e = begin; e < end; ++e) {
+        const double d0 = a.ranges[0][e];
+        bool ok = d0 > 0.0 && d0 < inf;
+        const double d0_sq = d0 * d0;
+
+        double x = 0.0, y = 0.0;
+        for (size_t i = 1; i < a.sensors; ++i) {
+            const double di = a.ranges[i][e];
+            ok = ok && di > 0.0 && di < inf;
+            const double b = d0_sq - di * di + a.k[i - 1];
+            x += a.m_x[i - 1] * b;
+            y += a.m_y[i - 1] * b;
+        }
+
+        double residual = 0.0;
+        if (a.need_residual) {
+            double sum_sq = 0.0;
+            for (size_t i = 0; i < a.sensors; ++i) {
+                const double dx = x - a.pos_x[i];
+                const double dy = y - a.pos_y[i];
+                const double err = std::sqrt(dx * dx + dy * dy) - a.ranges[i][e];
+                sum_sq += err * err;
+            }
+            residual = std::sqrt(sum_sq * a.inv_sensors);
+            ok = ok && residual <= a.max_residual;
+        }
+
+        out.x[e] = x;
+        out.y[e] = y;
+        if (out.residual_rms) out.residual_rms[e] = residual;
+        out.valid[e] = ok ? 1 : 0;
+        valid_count += ok ? 1 : 0;
+    }
+    return valid_count;
+}
+
+#if DRONE_HAVE_X86_SIMD
+
+size_t kernel_sse2(const KernelArgs& a, PositionBatch& out, size_t count) {
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d inf = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    const __m128d inv_n = _mm_set1_pd(a.inv_sensors);
+    const __m128d max_res = _mm_set1_pd(a.max_residual);
+    size_t valid_count = 0;
+
+    size_t e = 0;
+    for (; e + 2 <= count; e += 2) {
+        const __m128d d0 = _mm_loadu_pd(a.ranges[0] + e);
+        __m128d ok = _mm_and_pd(_mm_cmpgt_pd(d0, zero), _mm_cmplt_pd(d0, inf));
+        const __m128d d0_sq = _mm_mul_pd(d0, d0);
+
+        __m128d x = zero, y = zero;
+        for (size_t i = 1; i < a.sensors; ++i) {
+            const __m128d di = _mm_loadu_pd(a.ranges[i] + e);
+            ok = _mm_and_pd(ok, _mm_and_pd(_mm_cmpgt_pd(di, zero), _mm_cmplt_pd(di, inf)));
+            const __m128d b = _mm_add_pd(_mm_sub_pd(d0_sq, _mm_mul_pd(di, di)), _mm_set1_pd(a.k[i - 1]));
+            x = _mm_add_pd(x, _mm_mul_pd(_mm_set1_pd(a.m_x[i - 1]), b));
+            y = _mm_add_pd(y, _mm_mul_pd(_mm_set1_pd(a.m_y[i - 1]), b));
+        }
+
+        __m128d residual = zero;
+        if (a.need_residual) {
+            __m128d sum_sq = zero;
+            for (size_t i = 0; i < a.sensors; ++i) {
+                const __m128d dx = _mm_sub_pd(x, _mm_set1_pd(a.pos_x[i]));
+                const __m128d dy = _mm_sub_pd(y, _mm_set1_pd(a.pos_y[i]));
+                const __m128d dist = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+                const __m128d err = _mm_sub_pd(dist, _mm_loadu_pd(a.ranges[i] + e));
+                sum_sq = _mm_add_pd(sum_sq, _mm_mul_pd(err, err));
+            }
+            residual = _mm_sqrt_pd(_mm_mul_pd(sum_sq, inv_n));
+            ok = _mm_and_pd(ok, _mm_cmple_pd(residual, max_res));
+        }
+
+        _mm_storeu_pd(out.x + e, x);
+        _mm_storeu_pd(out.y + e, y);
+        if (out.residual_rms) _mm_storeu_pd(out.residual_rms + e, residual);
+        const int mask = _mm_movemask_pd(ok);
+        out.valid[e] = mask & 1;
+        out.valid[e + 1] = (mask >> 1) & 1;
+        valid_count += __builtin_popcount(mask);
+    }
+    return valid_count + kernel_scalar(a, out, e, count);
+}
+
+__attribute__((target("avx2,fma")))
+size_t kernel_avx2(const KernelArgs& a, PositionBatch& out, size_t count) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    const __m256d inv_n = _mm256_set1_pd(a.inv_sensors);
+    const __m256d max_res = _mm256_set1_pd(a.max_residual);
+    size_t valid_count = 0;
+
+    size_t e = 0;
+    for (; e + 4 <= count; e += 4) {
+        const __m256d d0 = _mm256_loadu_pd(a.ranges[0] + e);
+        __m256d ok = _mm256_and_pd(_mm256_cmp_pd(d0, zero, _CMP_GT_OQ), _mm256_cmp_pd(d0, inf, _CMP_LT_OQ));
+        const __m256d d0_sq = _mm256_mul_pd(d0, d0);
+
+        __m256d x = zero, y = zero;
+        for (size_t i = 1; i < a.sensors; ++i) {
+            const __m256d di = _mm256_loadu_pd(a.ranges[i] + e);
+            ok = _mm256_and_pd(ok, _mm256_and_pd(_mm256_cmp_pd(di, zero, _CMP_GT_OQ),
+                                                 _mm256_cmp_pd(di, inf, _CMP_LT_OQ)));
+            const __m256d b = _mm256_add_pd(_mm256_fnmadd_pd(di, di, d0_sq), _mm256_set1_pd(a.k[i - 1]));
+            x = _mm256_fmadd_pd(_mm256_set1_pd(a.m_x[i - 1]), b, x);
+            y = _mm256_fmadd_pd(_mm256_set1_pd(a.m_y[i - 1]), b, y);
+        }
+
+        __m256d residual = zero;
+        if (a.need_residual) {
+            __m256d sum_sq = zero;
+            for (size_t i = 0; i < a.sensors; ++i) {
+                const __m256d dx = _mm256_sub_pd(x, _mm256_set1_pd(a.pos_x[i]));
+                const __m256d dy = _mm256_sub_pd(y, _mm256_set1_pd(a.pos_y[i]));
+                const __m256d dist = _mm256_sqrt_pd(_mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy)));
+                const __m256d err = _mm256_sub_pd(dist, _mm256_loadu_pd(a.ranges[i] + e));
+                sum_sq = _mm256_fmadd_pd(err, err, sum_sq);
+            }
+            residual = _mm256_sqrt_pd(_mm256_mul_pd(sum_sq, inv_n));
+            ok = _mm256_and_pd(ok, _mm256_cmp_pd(residual, max_res, _CMP_LE_OQ));
+        }
+
+        _mm256_storeu_pd(out.x + e, x);
+        _mm256_storeu_pd(out.y + e, y);
+        if (out.residual_rms) _mm256_storeu_pd(out.residual_rms + e, residual);
+        const int mask = _mm256_movemask_pd(ok);
+        for (int j = 0; j < 4; ++j) {
+            out.valid[e + j] = (mask >> j) & 1;
+        }
+        valid_count += __builtin_popcount(mask);
+    }
+    return valid_count + kernel_scalar(a, out, e, count);
+}
+
+#endif
+
+} // namespace
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+SimdLevel detect_simd_level() {
+#if DRONE_HAVE_X86_SIMD
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::SSE2;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+size_t multilaterate_batch(const SubsetSolver& solver, const RangeBatch& input, PositionBatch& output,
+                           double max_residual, SimdLevel level) {
+    if (!solver.valid()) {
+        for (size_t e = 0; e < input.count; ++e) {
+            output.valid[e] = 0;
+        }
+        return 0;
+    }
+
+    KernelArgs args;
+    args.sensors = solver.positions().size();
+    args.ranges = input.ranges;
+    args.m_x = solver.operator_x().data();
+    args.m_y = solver.operator_y().data();
+    args.k = solver.offsets().data();
+    for (const Point& p : solver.positions()) {
+        args.pos_x.push_back(p.x);
+        args.pos_y.push_back(p.y);
+    }
+    args.inv_sensors = 1.0 / static_cast<double>(args.sensors);
+    args.max_residual = max_residual;
+    args.need_residual = output.residual_rms != nullptr || max_residual < std::numeric_limits<double>::infinity();
+
+    // Never run a kernel the CPU cannot execute.
+    if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        level = detect_simd_level();
+    }
+
+    switch (level) {
+#if DRONE_HAVE_X86_SIMD
+        case SimdLevel::AVX2: return kernel_avx2(args, output, input.count);
+        case SimdLevel::SSE2: return kernel_sse2(args, output, input.count);
+#endif
+        default: return kernel_scalar(args, output, 0, input.count);
+    }
+}
@@ -0,0 +1,68 @@
+/**
+    * @file BatchMultilateration.h
+    * @brief Bulk multilateration over many epochs for replay and reprocessing.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Inputs and outputs are structure-of-arrays: one contiguous range array per
+    * sensor and one output array per field, so the kernel processes 2 (SSE2) or
+    * 4 (AVX2) epochs per instruction. The widest kernel the CPU supports is picked
+    * at runtime, anything that is not x86-64 uses the scalar kernel.
+    *
+    * The geometry comes from a cached SubsetSolver, so every epoch shares the same
+    * precomputed least-squares operator.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "Multilateration.h"
+
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+const char* simd_level_name(SimdLevel level);
+
+// Best level supported by the running CPU.
+SimdLevel detect_simd_level();
+
+/**
+    * @struct RangeBatch
+    * @brief Ranges of count epochs, ranges[i] holds the ranges of the i-th sensor of the subset.
+*/
+struct RangeBatch {
+    const double* const* ranges = nullptr;
+    size_t count = 0;
+};
+
+/**
+    * @struct PositionBatch
+    * @brief Output arrays, each at least count long. residual_rms may be null.
+    *
+    * valid[e] is 1 when every range of epoch e was finite and positive and the
+    * RMS residual did not exceed max_residual, 0 otherwise. Residuals are only
+    * computed when residual_rms is set or max_residual is finite.
+*/
+struct PositionBatch {
+    double* x = nullptr;
+    double* y = nullptr;
+    double* residual_rms = nullptr;
+    uint8_t* valid = nullptr;
+};
+
+/**
+    * @brief Solves every epoch of the batch with the given subset geometry.
+    *
+    * @param level Kernel to use, defaults to the best one the CPU supports
+    * @return Number of valid epochs
+*/
+size_t multilaterate_batch(const SubsetSolver& solver, const RangeBatch& input, PositionBatch& output,
+                           double max_residual = std::numeric_limits<double>::infinity(),
+                           SimdLevel level = detect_simd_level());
@@ -0,0 +1,17 @@
+/**
+    * @file ConsoleColors.h
+    * @brief ANSI escape sequences shared by everything that prints to the console.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <string>
+
+inline const std::string FORE_GREEN    = "\033[32m";
+inline const std::string FORE_YELLOW   = "\033[33m";
+inline const std::string FORE_CYAN     = "\033[36m";
+inline const std::string FORE_RED      = "\033[31m";
+inline const std::string STYLE_BRIGHT  = "\033[1m";
+inline const std::string STYLE_RESET   = "\033[0m";
@@ -10,69 +10,206 @@
     * once a complete set of data is available. 
     *
     * Designed to be thread-safe to handle concurrent updates from different NodeManager threads.
+    * Updates never take a lock, the solve runs on a snapshot of the latest ranges.
+    * The geometry is swapped by reload() without stopping them.
 */
 
 // --- Imports ---
 #include "DroneTracker.h"
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
 // --- End Imports ---
 
+namespace {
+
+// Half of MultilaterationEngine's solver cache.
+constexpr size_t SOLVER_WARMUP = 512;
+
+} // namespace
+
 /**
-    * @brief Map to hold the fixed positions of the sensors
+    * @brief Map to hold the positions of the sensors
     *
-    * This method should be called whenever you need to validate a sensors position
+    * Every "esp_id/sensor_id" key is interned in the registry so updates can be
+    * looked up by SensorHandle instead of by string.
     *
-    * @param Map of sensors current positions
+    * @param sensor_positions Map of sensors current positions
+    * @param registry Registry the sensor ids are interned into
+    * @param selection Which sensors take part in a fix, see SubsetGrid.h
 */
-DroneTracker::DroneTracker(const std::map<std::string, Point>& sensor_positions)
-    : sensor_positions_(sensor_positions) {
+DroneTracker::DroneTracker(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry,
+                           const SubsetSelectionConfig& selection)
+    : selection_(selection), slots_(new SensorSlot[MAX_SENSORS]) {
+        geometry_.store(build_geometry(sensor_positions, registry).release(), std::memory_order_release);
+    }
+
+// Nothing may be updating by now, so the current geometry goes straight away.
+DroneTracker::~DroneTracker() {
+    delete geometry_.load(std::memory_order_relaxed);
+}
+
+std::unique_ptr<const DroneTracker::Geometry> DroneTracker::build_geometry(
+        const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry) const {
+    const Geometry* current = geometry_.load(std::memory_order_acquire);
+    auto next = std::make_unique<Geometry>();
+    std::vector<Point> positions;
+    if (current) {
+        next->slot_of_handle = current->slot_of_handle;
+        next->slot_count = current->slot_count;
+        positions = current->engine->positions();
+    }
+
+    for (const auto& pair : sensor_positions) {
+        SensorHandle handle = registry.intern_sensor(pair.first);
+        if (handle == INVALID_SENSOR) continue;
 
-        // populate the map
-        for (const auto& pair : sensor_positions_) {
-            required_sensor_ids_.push_back(pair.first);
+        if (handle >= next->slot_of_handle.size()) {
+            next->slot_of_handle.resize(handle + 1, NO_SLOT);
         }
+        uint8_t& slot = next->slot_of_handle[handle];
+        if (slot == NO_SLOT) {
+            if (next->slot_count >= MAX_SENSORS) {
+                throw std::runtime_error("DroneTracker supports at most " + std::to_string(MAX_SENSORS)
+                                         + " sensors over its lifetime, restart to add " + pair.first);
+            }
+            slot = static_cast<uint8_t>(next->slot_count++);
+            positions.resize(next->slot_count);
+        }
+        positions[slot] = pair.second;
+        next->required_mask |= uint64_t(1) << slot;
     }
 
+    if (selection_.grid && __builtin_popcountll(next->required_mask) >= static_cast<int>(MIN_SENSORS)) {
+        next->grid = std::make_unique<SubsetGrid>(positions, next->required_mask, selection_);
+    }
+    next->engine = std::make_unique<MultilaterationEngine>(std::move(positions));
+    // The subsets updates have been solving with, minus sensors that are gone.
+    if (__builtin_popcountll(next->required_mask) >= static_cast<int>(MIN_SENSORS)) {
+        next->engine->solver(next->required_mask);
+    }
+    // And the ones the grid will pick, as many as leave half the solver cache for outages.
+    if (next->grid) {
+        const std::vector<uint64_t> masks = next->grid->best_masks();
+        for (size_t i = 0; i < masks.size() && i < SOLVER_WARMUP; ++i) next->engine->solver(masks[i]);
+    }
+    if (current) {
+        for (uint64_t mask : current->engine->cached_masks()) {
+            mask &= next->required_mask;
+            if (__builtin_popcountll(mask) >= static_cast<int>(MIN_SENSORS)) next->engine->solver(mask);
+        }
+    }
+    return next;
+}
+
+void DroneTracker::publish(std::unique_ptr<const Geometry> geometry) {
+    const Geometry* old = geometry_.exchange(geometry.release(), std::memory_order_acq_rel);
+    epoch_domain().retire(old);
+}
+
 /**
     * @brief Aggregates data to ensure consitency and accurate calculation of positon.
     * This method is called when a new distance measurement is received
-    * from a sensor. It stores the distance and then checks if a reading has been
-    * received from all the required sensors. If a complete dataset is available,
-    * it performs the trilateration calculation.
+    * from a sensor. It stores the distance and then checks how many of the required
+    * sensors have reported. With at least MIN_SENSORS of them it performs a
+    * least-squares multilateration, using the cached geometry factorization for
+    * that sensor subset: over all of them until there is a fix, after that over
+    * the subset the SubsetGrid picks for the cell of the last fix. A range of a
+    * sensor outside that subset changes nothing and gives no fix.
+    *
+    * The store is a seqlock write into the sensor's own slot, the completeness
+    * check is one load and compare of the fresh mask, and the solve runs on a
+    * snapshot taken without blocking any other updater.
     *
-    * @param full_sensor_id The unique identifier for the sensor
+    * @param sensor Handle of the sensor, as interned in the SensorRegistry
     * @param distance The measured distance from the sensor to the target, in meters (change to cm maybe?)
+    * @param timestamp_ms Sensor timestamp of the reading
+    * @param received_at When the reading arrived, ranges that arrived stale_after_s before it are left out
     *
-    * @return std::optional<Point> If the calculation is successful, it returns an
-    * optional contained the calculated (x,y) Point. If there is not enough
-    * data, or if the calculation fails (mayber collinear sensors) it
-    * returns std::nullopt.
+    * @return std::optional<Fix> If the calculation is successful, it returns an
+    * optional contained the calculated (x,y) Point with its residual and condition
+    * number. If there is not enough data, or if the calculation fails (mayber
+    * collinear sensors) it returns std::nullopt.
 */
-std::optional<Point> DroneTracker::updateAndCalculate(const std::string& full_sensor_id, double distance) {
-    std::lock_guard<std::mutex> lock(data_mutex_);
-
-    if (sensor_positions_.find(full_sensor_id) == sensor_positions_.end()) {
+std::optional<Fix> DroneTracker::updateAndCalculate(SensorHandle sensor, double distance, long long timestamp_ms,
+                                                    IngestClock::time_point received_at) {
+    // One geometry for the whole update, a reload meanwhile takes effect from the next one.
+    EpochDomain::Guard guard;
+    const Geometry& geometry = *geometry_.load(std::memory_order_acquire);
+    if (!geometry.tracks(sensor)) {
         return std::nullopt;
     }
 
-    latest_distances_[full_sensor_id] = distance;
+    const uint8_t slot = geometry.slot_of_handle[sensor];
+    const int64_t received_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(received_at.time_since_epoch()).count();
+    slots_[slot].latest.store(RangeSample{distance, timestamp_ms});
+    slots_[slot].received_ns.store(received_ns, std::memory_order_relaxed);
+
+    const uint64_t bit = uint64_t(1) << slot;
+    uint64_t fresh = fresh_mask_.load(std::memory_order_acquire);
+    if (!(fresh & bit)) {
+        fresh = fresh_mask_.fetch_or(bit, std::memory_order_acq_rel) | bit;
+    }
 
-    if (latest_distance_.size() < required_sensor)ids_.size() {
+    uint64_t active = fresh & geometry.required_mask;
+    if (static_cast<size_t>(__builtin_popcountll(active)) < MIN_SENSORS) {
         return std::nullopt;
     }
 
-    for (const auto& id : required_sensor_ids_) {
-        if (latest_distances.find(id) == latest_distances_.end()) {
-            return std::nullopt;
+    // Snapshot, each read is consistent on its own and never blocks the writers.
+    const int64_t stale_ns = received_ns != 0 ? static_cast<int64_t>(selection_.stale_after_s * 1e9) : 0;
+    double ranges[MAX_SENSORS];
+    for (uint64_t bits = active; bits; bits &= bits - 1) {
+        const int i = __builtin_ctzll(bits);
+        ranges[i] = slots_[i].latest.load().range;
+        const int64_t received = slots_[i].received_ns.load(std::memory_order_relaxed);
+        if (stale_ns > 0 && received != 0 && received_ns - received > stale_ns) {
+            active &= ~(uint64_t(1) << i);
         }
     }
+    if (static_cast<size_t>(__builtin_popcountll(active)) < MIN_SENSORS) {
+        return std::nullopt;
+    }
 
-    const auto& id1 = required_sensor_ids_[0];
-    const auto& id2 = required_sensor_ids_[1];
-    const auto& id3 = required_sensor_ids_[2];
+    SubsetGrid* grid = geometry.grid.get();
+    if (!grid) {
+        return geometry.engine->solve(active, ranges);
+    }
 
-    return trilaterate(
-        sensor_positions_.at(id1), latest_distances_.at(id1),
-        sensor_positions_.at(id2), latest_distances_.at(id2),
-        sensor_positions_.at(id3), latest_distances_.at(id3)
-    );
+    uint64_t mask = active;
+    double dop = 0.0;
+    const uint32_t cell = grid->last_cell();
+    if (cell != SubsetGrid::NO_CELL) {
+        const SubsetGrid::Choice choice = grid->choose(cell, active);
+        // Every subset degenerate, all of them is still worth a try.
+        if (std::isfinite(choice.dop)) {
+            if (!(choice.mask & bit)) {
+                return std::nullopt;
+            }
+            mask = choice.mask;
+            dop = choice.dop;
+        }
+    }
+
+    std::optional<Fix> fix = geometry.engine->solve(mask, ranges);
+    if (fix) {
+        fix->dop = dop;
+        grid->note_fix(fix->position);
+    }
+    return fix;
+}
+
+void DroneTracker::withdraw(SensorHandle sensor) {
+    if (!selection_.drop_lost) {
+        return;
+    }
+    EpochDomain::Guard guard;
+    const Geometry& geometry = *geometry_.load(std::memory_order_acquire);
+    if (!geometry.tracks(sensor)) {
+        return;
+    }
+    const uint64_t bit = uint64_t(1) << geometry.slot_of_handle[sensor];
+    if (fresh_mask_.load(std::memory_order_relaxed) & bit) {
+        fresh_mask_.fetch_and(~bit, std::memory_order_acq_rel);
+    }
 }
@@ -9,19 +9,44 @@
     * responsible for receiving distance measurements from multiple sensors,
     * storing the latest reading from each, and triggering a trilateration
     * calculation once a complete set of data is available. It is designed to be
-    * thread-safe to handle concurrent updates from different NodeManager threads.
+    * thread-safe to handle concurrent updates from different NodeManager threads
+    * without any lock: every sensor owns a cache-line sized slot guarded by a
+    * seqlock, and completeness is tracked in a single atomic bitmask.
+    *
+    * The sensor positions and everything derived from them can be replaced
+    * while updates are running, see reload().
+    *
+    * Which of the sensors with a range take part in a fix is decided per
+    * position by a SubsetGrid built with the geometry, see SubsetGrid.h, and
+    * sensors that lost the target or went quiet are left out of it.
 */
 
 // --- ensure single compilation ---
 #pragma once
 
 // --- import statements ---
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
-#include <mutex>
 #include "SensorModel.h"
-#include "Trilateration.h"
+#include "SensorRegistry.h"
+#include "SeqLock.h"
+#include "Epoch.h"
+#include "Multilateration.h"
+#include "SubsetGrid.h"
+#include "IngestSource.h"
+
+/**
+    * @struct RangeSample
+    * @brief Latest range reported by one sensor, as published to the solver.
+*/
+struct RangeSample {
+    double range = 0.0;
+    long long timestamp_ms = 0;
+};
 
 /**
     * @class DroneTracker
@@ -29,21 +54,114 @@
     *
     * The DroneTracker class acts as the central brain for the trilateration system.
     * It maintains the state of the latest distance reading from each requuired sensor.
-    * Upon receiving a new data point, it checks if it has a complete set of readings
-    * and if so, invokes the trilateration algorithm to compute the drone's (x,y) coordinates
+    * Upon receiving a new data point, it checks if it has readings from at least three
+    * sensors and if so, runs a least-squares multilateration over every sensor that has
+    * reported to compute the drone's (x,y) coordinates, or over the subset of them
+    * the SubsetGrid picks for the drone's last position.
     * This class is designed to be thread-safe.
+    *
+    * All state lives in flat arrays indexed by a small per-tracker slot number, so
+    * one tracker handles at most MAX_SENSORS sensors. Each sensor must only be
+    * updated from one thread at a time, which NodeManager guarantees.
+    *
+    * The geometry (which sensor has which slot, their positions and the cached
+    * solvers) is one immutable Geometry object behind an atomic pointer. An
+    * update loads it once inside an epoch guard and uses that one geometry
+    * for its store and solve, reload() builds the next one on the calling
+    * thread and swaps it in, the old one is freed by epoch_domain().reclaim()
+    * once no update can still be using it. A sensor keeps its slot, and its
+    * latest range, for the tracker's lifetime, even if a reload removes it
+    * for a while: slots are never handed to another sensor, so a late update
+    * through an old geometry can never land in another sensor's slot.
 */
 class DroneTracker {
+    public:
+        static constexpr size_t MAX_SENSORS = SubsetSolver::MAX_SENSORS;
+        static constexpr size_t MIN_SENSORS = 3;
+
+        // Everything derived from the sensor positions, never changed once published.
+        struct Geometry {
+            // SensorHandle -> slot, of every sensor ever given one, NO_SLOT for the others.
+            std::vector<uint8_t> slot_of_handle;
+            // Slots of the sensors in this geometry, removed sensors keep theirs but are not in the mask.
+            uint64_t required_mask = 0;
+            size_t slot_count = 0;
+            std::unique_ptr<MultilaterationEngine> engine;
+            // Null when subset selection is off or there are fewer than MIN_SENSORS sensors.
+            std::unique_ptr<SubsetGrid> grid;
+
+            bool tracks(SensorHandle sensor) const {
+                return sensor < slot_of_handle.size() && slot_of_handle[sensor] != NO_SLOT
+                    && (required_mask >> slot_of_handle[sensor] & 1);
+            }
+        };
+
     // --- Private var declaration to be used ---
     private:
-        std::mutex data_mutex_;
-        std::map<std::string, Point> sensor_positions_;
-        std::map<std::string, double> latest_distances_;
-        std::vector<std::string> required_sensor_ids_;
+        static constexpr uint8_t NO_SLOT = 0xFF;
+
+        // One cache line per sensor so updaters of different sensors never share a line.
+        struct alignas(CACHE_LINE_SIZE) SensorSlot {
+            SeqLock<RangeSample> latest;
+            // IngestClock time the latest range arrived at, 0 if the caller did not say.
+            // Outside the seqlock: only the age is needed, and a bigger payload costs every update.
+            std::atomic<int64_t> received_ns{0};
+        };
+
+        SubsetSelectionConfig selection_;
+        std::unique_ptr<SensorSlot[]> slots_;
+        std::atomic<const Geometry*> geometry_{nullptr};
+        // Bit i is set once slot i has reported at least one range.
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> fresh_mask_{0};
 
     // --- Public method declarations ---
     public:
-        DroneTracker(const std::map<std::string, Point>& sensor_positions);
+        DroneTracker(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry,
+                     const SubsetSelectionConfig& selection = {});
+        ~DroneTracker();
+
+        DroneTracker(const DroneTracker&) = delete;
+        DroneTracker& operator=(const DroneTracker&) = delete;
+
+        std::optional<Fix> updateAndCalculate(SensorHandle sensor, double distance, long long timestamp_ms = 0,
+                                              IngestClock::time_point received_at = {});
+
+        /**
+            * @brief The sensor reported it no longer sees the target.
+            *
+            * Its last range is left out of every fix until it reports a new one.
+            * Same threading rule as updateAndCalculate(), does nothing unless
+            * SubsetSelectionConfig::drop_lost is set.
+        */
+        void withdraw(SensorHandle sensor);
+
+        bool tracks(SensorHandle sensor) const {
+            EpochDomain::Guard guard;
+            return geometry_.load(std::memory_order_acquire)->tracks(sensor);
+        }
+
+        /**
+            * @brief Builds the geometry for new sensor positions, without publishing it.
+            *
+            * Sensors already known keep their slot, new ones get the next free one,
+            * and every subset the current solver cache holds is solved for up front,
+            * so the first updates after the swap do not build solvers themselves.
+            * Throws std::runtime_error, leaving the tracker unchanged, if the
+            * sensors would need more than MAX_SENSORS slots over the tracker's life.
+        */
+        std::unique_ptr<const Geometry> build_geometry(const std::map<std::string, Point>& sensor_positions,
+                                                       SensorRegistry& registry) const;
+        // Swaps geometry in and retires the old one. Must come from build_geometry() on the current geometry.
+        void publish(std::unique_ptr<const Geometry> geometry);
 
-        std::optional<Point> updateAndCalculate(const std::string& full_sensor_id, double distance);
+        /**
+            * @brief Replaces the sensor positions while updates keep running.
+            *
+            * Updates never wait for it, each one solves entirely on either the old
+            * or the new geometry. Must not run concurrently with another reload of
+            * the same tracker. Throws like build_geometry().
+        */
+        void reload(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry) {
+            publish(build_geometry(sensor_positions, registry));
+        }
 };
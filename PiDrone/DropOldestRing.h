@@ -0,0 +1,176 @@
+/**
+    * @file DropOldestRing.h
+    * @brief Bounded single-producer/single-consumer ring that can evict its oldest element.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Same contract as SpscRing, plus push_evict(): when the ring is full the
+    * producer takes the oldest element out itself instead of waiting for the
+    * consumer, so memory stays fixed and the producer never blocks on a slow
+    * consumer.
+    *
+    * Because both sides may now remove elements, the head index is claimed
+    * with a compare-and-swap, and every slot carries a sequence number that
+    * says whose turn it is (the scheme of Vyukov's bounded queue): slot i is
+    * free for the producer at position p when its sequence is p, and is handed
+    * back with sequence p + capacity once its element has been moved out. The
+    * consumer claims up to DRAIN_CHUNK elements with one CAS and moves them
+    * out before processing them, so a slot is only ever held for the time of
+    * a few moves and that is all the producer can ever wait for.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include "SpscRing.h"
+
+template <typename T>
+class DropOldestRing {
+    public:
+        static constexpr size_t DRAIN_CHUNK = 32;
+
+    // --- Private var declaration to be used ---
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence{0};
+            T value{};
+        };
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+        const size_t capacity_;
+        const size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+        // Consumer only, elements of the current chunk after they left their slots.
+        T chunk_[DRAIN_CHUNK];
+
+        static size_t round_up_pow2(size_t n) {
+            size_t p = 1;
+            while (p < n) p <<= 1;
+            return p;
+        }
+
+        // Producer side: position tail is free once the element that last used the slot has been moved out.
+        void wait_for_slot(size_t tail) {
+            while (slots_[tail & mask_].sequence.load(std::memory_order_acquire) != tail) {
+                cpu_relax();
+            }
+        }
+
+        void publish(size_t tail, T&& value) {
+            Slot& slot = slots_[tail & mask_];
+            slot.value = std::move(value);
+            slot.sequence.store(tail + 1, std::memory_order_release);
+            tail_.store(tail + 1, std::memory_order_release);
+        }
+
+        // Hands the slot of a claimed position back to the producer, its element may be left in place to be overwritten.
+        void release(size_t position) {
+            slots_[position & mask_].sequence.store(position + capacity_, std::memory_order_release);
+        }
+
+    // --- Public method declarations ---
+    public:
+        explicit DropOldestRing(size_t capacity)
+            : capacity_(round_up_pow2(capacity < 2 ? 2 : capacity)),
+              mask_(capacity_ - 1),
+              slots_(new Slot[capacity_]) {
+            for (size_t i = 0; i < capacity_; ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        DropOldestRing(const DropOldestRing&) = delete;
+        DropOldestRing& operator=(const DropOldestRing&) = delete;
+
+        /**
+            * @brief Producer side. Moves value into the ring if there is room.
+            *
+            * @return false if the ring is full, value is left untouched in that case.
+        */
+        bool try_push(T&& value) {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_.load(std::memory_order_acquire) >= capacity_) {
+                return false;
+            }
+            wait_for_slot(tail);
+            publish(tail, std::move(value));
+            return true;
+        }
+
+        /**
+            * @brief Producer side. Moves value into the ring, evicting the oldest element if it is full.
+            *
+            * @return Number of elements evicted, 0 or 1.
+        */
+        size_t push_evict(T&& value) {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            size_t evicted = 0;
+            size_t head = head_.load(std::memory_order_acquire);
+            while (tail - head >= capacity_) {
+                // The consumer may claim the same element meanwhile, then there is room anyway.
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    release(head);
+                    evicted = 1;
+                    break;
+                }
+            }
+            wait_for_slot(tail);
+            publish(tail, std::move(value));
+            return evicted;
+        }
+
+        /**
+            * @brief Consumer side. Moves up to max_items elements out and hands them to fn, oldest first.
+            *
+            * fn receives a T& it may move from. Elements are taken DRAIN_CHUNK at a
+            * time and their slots are free for the producer again before fn runs, so
+            * a long fn never holds up push_evict().
+            *
+            * @return Number of elements consumed.
+        */
+        template <typename Fn>
+        size_t drain(Fn&& fn, size_t max_items = std::numeric_limits<size_t>::max()) {
+            size_t total = 0;
+            while (total < max_items) {
+                size_t head = head_.load(std::memory_order_acquire);
+                size_t count;
+                do {
+                    const size_t available = tail_.load(std::memory_order_acquire) - head;
+                    if (available == 0) return total;
+                    count = available < max_items - total ? available : max_items - total;
+                    if (count > DRAIN_CHUNK) count = DRAIN_CHUNK;
+                } while (!head_.compare_exchange_weak(head, head + count, std::memory_order_acq_rel, std::memory_order_acquire));
+
+                // Swapped rather than moved, whatever chunk_ held last time is spent and gets overwritten.
+                for (size_t i = 0; i < count; ++i) {
+                    std::swap(chunk_[i], slots_[(head + i) & mask_].value);
+                    release(head + i);
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    fn(chunk_[i]);
+                }
+                total += count;
+            }
+            return total;
+        }
+
+        // Safe to call from either side, the answer may be stale by the time it is used.
+        bool empty() const {
+            return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+        }
+
+        size_t size_approx() const {
+            const size_t tail = tail_.load(std::memory_order_acquire);
+            const size_t head = head_.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        size_t capacity() const { return capacity_; }
+};
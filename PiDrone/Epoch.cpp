@@ -0,0 +1,98 @@
+/**
+    * @file Epoch.cpp
+    * @brief Reader slot claiming, retirement and reclamation of the epoch domain.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "Epoch.h"
+#include <stdexcept>
+#ifdef __linux__
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+// --- End Imports ---
+
+EpochDomain::EpochDomain() {
+#if defined(__linux__) && defined(__NR_membarrier)
+    asymmetric_ = syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+#endif
+}
+
+EpochDomain::~EpochDomain() {
+    for (Retired& r : retired_) {
+        r.deleter();
+    }
+}
+
+void EpochDomain::heavy_fence() {
+#if defined(__linux__) && defined(__NR_membarrier)
+    if (asymmetric_ && syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0) == 0) return;
+    // Registered but failing would leave readers unfenced, never expected after a successful registration.
+    if (asymmetric_) throw std::runtime_error("membarrier failed after registering for it");
+#endif
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+EpochDomain::ReaderSlot* EpochDomain::claim_slot() {
+    // Gives the slot back when the thread exits.
+    struct Release {
+        ReaderSlot* slot = nullptr;
+        ~Release() {
+            if (slot) slot->claimed.store(false, std::memory_order_release);
+            local_reader_.slot = nullptr;
+        }
+    };
+    thread_local Release release;
+
+    for (ReaderSlot& slot : readers_) {
+        bool expected = false;
+        if (!slot.claimed.load(std::memory_order_relaxed)
+            && slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            release.slot = &slot;
+            return &slot;
+        }
+    }
+    throw std::runtime_error("More than " + std::to_string(MAX_READERS) + " threads read epoch-protected objects");
+}
+
+void EpochDomain::retire(std::function<void()> deleter) {
+    // Readers that load the incremented epoch (acquire) load the pointer after it was swapped out.
+    const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> lock(retired_mutex_);
+    retired_.push_back(Retired{epoch, std::move(deleter)});
+}
+
+size_t EpochDomain::reclaim() {
+    std::vector<Retired> ready;
+    {
+        std::lock_guard<std::mutex> lock(retired_mutex_);
+        if (retired_.empty()) return 0;
+
+        // Pairs with the fence in enter(): a reader that loaded a retired pointer is seen here.
+        heavy_fence();
+        uint64_t oldest = UINT64_MAX;
+        for (const ReaderSlot& slot : readers_) {
+            const uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+            if (epoch != 0 && epoch < oldest) oldest = epoch;
+        }
+
+        // A reader that announced epoch e may hold anything retired in e or later.
+        std::vector<Retired> waiting;
+        for (Retired& r : retired_) {
+            (r.epoch < oldest ? ready : waiting).push_back(std::move(r));
+        }
+        retired_.swap(waiting);
+    }
+    for (Retired& r : ready) {
+        r.deleter();
+    }
+    return pending();
+}
+
+size_t EpochDomain::pending() {
+    std::lock_guard<std::mutex> lock(retired_mutex_);
+    return retired_.size();
+}
@@ -0,0 +1,153 @@
+/**
+    * @file Epoch.h
+    * @brief Epoch-based reclamation for objects readers use without taking a lock.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Lets a writer replace a shared object (the sensor geometry) with an
+    * atomic pointer swap while readers keep using the old one, and free the
+    * old one only once no reader can still hold it. Readers never wait: a
+    * reader announces the current epoch in its own slot when it enters and
+    * clears it when it leaves, a store each. The writer swaps the
+    * pointer, then retires the old object with the epoch it was retired in,
+    * and reclaim() frees every object retired before the oldest epoch any
+    * reader still announces.
+    *
+    *   {
+    *       EpochDomain::Guard guard;
+    *       const Geometry* g = geometry_.load(std::memory_order_acquire);
+    *       ... use g, it stays valid until guard goes out of scope ...
+    *   }
+    *
+    * Guards nest, only the outermost one announces. A reader that stalls in
+    * a guard holds back reclamation, never the writer or other readers.
+    *
+    * The announcement must be visible before the reader loads the pointer,
+    * which takes a full fence, about a third of a small tracker update. On
+    * Linux the domain registers for membarrier(2) instead: readers only keep
+    * the compiler from reordering, and reclaim() has the kernel run the fence
+    * on every thread of the process, once per reclaim rather than once per
+    * read. Where membarrier is missing readers fall back to the fence.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "SpscRing.h"
+
+/**
+    * @class EpochDomain
+    * @brief Process-wide reader slots, global epoch and list of retired objects.
+    *
+    * One instance, see epoch_domain(). A thread claims a reader slot on its
+    * first guard and gives it back when it exits.
+*/
+class EpochDomain {
+    public:
+        // Threads inside a guard at the same time, beyond that entering throws.
+        static constexpr size_t MAX_READERS = 256;
+
+    // --- Private var declaration to be used ---
+    private:
+        struct alignas(CACHE_LINE_SIZE) ReaderSlot {
+            // Epoch announced by the reader, 0 while it is outside any guard.
+            std::atomic<uint64_t> epoch{0};
+            std::atomic<bool> claimed{false};
+        };
+
+        // Trivial so reaching it is a plain TLS access, claim_slot() arranges the release on thread exit.
+        struct LocalReader {
+            ReaderSlot* slot;
+            uint32_t depth;
+        };
+
+        struct Retired {
+            uint64_t epoch;
+            std::function<void()> deleter;
+        };
+
+        // Starts at 1 so 0 can mean "not reading".
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> epoch_{1};
+        // Set once in the constructor, see the file comment.
+        bool asymmetric_ = false;
+        ReaderSlot readers_[MAX_READERS];
+        std::mutex retired_mutex_;
+        std::vector<Retired> retired_;
+
+        // Only epoch_domain() exists, so one reader per thread is enough.
+        static thread_local LocalReader local_reader_;
+
+        ReaderSlot* claim_slot();
+        // The fence reclaim() needs to pair with every reader's light one.
+        void heavy_fence();
+
+        void enter() {
+            LocalReader& reader = local_reader_;
+            if (reader.depth++ > 0) return;
+            if (!reader.slot) reader.slot = claim_slot();
+            reader.slot->epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+            // Orders the announcement before the reader's loads of any protected pointer.
+            if (asymmetric_) std::atomic_signal_fence(std::memory_order_seq_cst);
+            else std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        void leave() {
+            LocalReader& reader = local_reader_;
+            if (--reader.depth > 0) return;
+            reader.slot->epoch.store(0, std::memory_order_release);
+        }
+
+    // --- Public method declarations ---
+    public:
+        EpochDomain();
+        // Frees everything still retired, no reader may be left by then.
+        ~EpochDomain();
+
+        EpochDomain(const EpochDomain&) = delete;
+        EpochDomain& operator=(const EpochDomain&) = delete;
+
+        class Guard;
+
+        /**
+            * @brief Hands an object that is no longer reachable to the domain, to be freed by reclaim().
+            *
+            * Call after the pointer to it has been swapped out. Takes a lock, never
+            * call it from a reader.
+        */
+        void retire(std::function<void()> deleter);
+
+        template <typename T>
+        void retire(const T* object) {
+            if (object) retire([object] { delete object; });
+        }
+
+        // Frees what no reader can still see, returns how many objects are still waiting.
+        size_t reclaim();
+        size_t pending();
+};
+
+inline thread_local EpochDomain::LocalReader EpochDomain::local_reader_{nullptr, 0};
+
+// Inline, every reader goes through it.
+inline EpochDomain& epoch_domain() {
+    static EpochDomain domain;
+    return domain;
+}
+
+// Keeps every object retired after it was entered alive until it is destroyed.
+class EpochDomain::Guard {
+    // --- Public method declarations ---
+    public:
+        Guard() { epoch_domain().enter(); }
+        ~Guard() { epoch_domain().leave(); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+};
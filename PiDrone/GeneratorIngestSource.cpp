@@ -0,0 +1,50 @@
+/**
+    * @file GeneratorIngestSource.cpp
+    * @brief In-memory generator implementation of IngestSource.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "GeneratorIngestSource.h"
+#include <memory>
+// --- End Imports ---
+
+GeneratorIngestSource::GeneratorIngestSource(Generator next)
+    : next_(std::move(next)) {}
+
+GeneratorIngestSource::~GeneratorIngestSource() {
+    stop();
+    join();
+}
+
+bool GeneratorIngestSource::run(const IngestHandler& handler) {
+    while (!stop_requested()) {
+        IngestMessage msg;
+        if (!next_(msg)) break;
+        msg.received_at = IngestClock::now();
+        handler(std::move(msg));
+    }
+    return true;
+}
+
+GeneratorIngestSource::Generator GeneratorIngestSource::cycle(std::vector<IngestMessage> messages, size_t loops) {
+    auto shared = std::make_shared<std::vector<IngestMessage>>(std::move(messages));
+    size_t index = 0;
+    size_t loop = 0;
+
+    return [shared, index, loop, loops](IngestMessage& msg) mutable {
+        if (shared->empty() || loop >= loops) return false;
+
+        const auto& src = (*shared)[index];
+        msg.topic = src.topic;
+        msg.payload = src.payload;
+        msg.sensor = src.sensor;
+
+        if (++index == shared->size()) {
+            index = 0;
+            ++loop;
+        }
+        return true;
+    };
+}
@@ -0,0 +1,43 @@
+/**
+    * @file GeneratorIngestSource.h
+    * @brief IngestSource that produces messages from an in-memory generator.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Used to drive the pipeline with synthetic traffic at full speed, for
+    * benchmarking and load tests without a broker.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <vector>
+#include <functional>
+#include "IngestSource.h"
+
+class GeneratorIngestSource : public ThreadedIngestSource {
+    public:
+        /**
+            * @brief Fills in the next message, returns false once the generator is exhausted.
+            *
+            * Every call receives a fresh, default constructed message. received_at
+            * is stamped by the source.
+        */
+        using Generator = std::function<bool(IngestMessage&)>;
+
+    // --- Private var declaration to be used ---
+    private:
+        Generator next_;
+
+    protected:
+        bool run(const IngestHandler& handler) override;
+
+    // --- Public method declarations ---
+    public:
+        explicit GeneratorIngestSource(Generator next);
+        ~GeneratorIngestSource() override;
+
+        // Cycles through a fixed set of messages the given number of times.
+        static Generator cycle(std::vector<IngestMessage> messages, size_t loops);
+};
@@ -0,0 +1,86 @@
+/**
+    * @file GeometryWatcher.cpp
+    * @brief Change detection and reload thread of the GeometryWatcher.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "GeometryWatcher.h"
+#include <stdexcept>
+#include "Epoch.h"
+// --- End Imports ---
+
+GeometryWatcher::GeometryWatcher(std::string path, ZonedTracker& tracker, SensorRegistry& registry, ReloadHandler on_reload)
+    : path_(std::move(path)), tracker_(tracker), registry_(registry), on_reload_(std::move(on_reload)) {}
+
+GeometryWatcher::~GeometryWatcher() {
+    stop();
+}
+
+/**
+    * @brief Whether the file's modification time or size differs from the last reload.
+    * A file that cannot be stat'ed (being replaced right now) counts as unchanged.
+*/
+bool GeometryWatcher::changed() {
+    std::error_code ec;
+    const auto write = std::filesystem::last_write_time(path_, ec);
+    if (ec) return false;
+    const uintmax_t size = std::filesystem::file_size(path_, ec);
+    if (ec) return false;
+    return write != last_write_ || size != last_size_;
+}
+
+bool GeometryWatcher::reload() {
+    // Noted before reading, an edit that lands while the file is read is picked up by the next poll.
+    std::error_code ec;
+    last_write_ = std::filesystem::last_write_time(path_, ec);
+    last_size_ = ec ? 0 : std::filesystem::file_size(path_, ec);
+
+    std::vector<ZoneConfig> zones;
+    std::string error;
+    try {
+        zones = load_zones(path_);
+        tracker_.reload(zones, registry_);
+    } catch (const std::runtime_error& e) {
+        error = e.what();
+    }
+    (error.empty() ? reloads_ : failures_).fetch_add(1, std::memory_order_relaxed);
+    // The old geometry is freed as soon as the updates that were using it are done.
+    epoch_domain().reclaim();
+    if (on_reload_) on_reload_(zones, error);
+    return error.empty();
+}
+
+void GeometryWatcher::start(std::chrono::milliseconds poll_interval) {
+    stop();
+    watch_stop_ = false;
+    std::error_code ec;
+    last_write_ = std::filesystem::last_write_time(path_, ec);
+    last_size_ = ec ? 0 : std::filesystem::file_size(path_, ec);
+
+    watch_thread_ = std::thread([this, poll_interval] {
+        std::unique_lock<std::mutex> lock(watch_mutex_);
+        while (!watch_cv_.wait_for(lock, poll_interval, [this] { return watch_stop_; })) {
+            lock.unlock();
+            if (requested_.exchange(false, std::memory_order_relaxed) || changed()) {
+                reload();
+            } else if (epoch_domain().pending() > 0) {
+                // Readers that were still inside a guard at the last reload have long left it.
+                epoch_domain().reclaim();
+            }
+            lock.lock();
+        }
+    });
+}
+
+void GeometryWatcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        watch_stop_ = true;
+    }
+    watch_cv_.notify_all();
+    if (watch_thread_.joinable()) {
+        watch_thread_.join();
+    }
+}
@@ -0,0 +1,87 @@
+/**
+    * @file GeometryWatcher.h
+    * @brief Reloads the sensor geometry from its zones file when the file changes or on request.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Re-surveying a node no longer means a rebuild and restart: edit the
+    * zones file (see ZonedTracker.h) and the watcher thread notices the new
+    * modification time within one poll interval, or send SIGHUP to have it
+    * reload the file on its next poll regardless. The file is parsed, the new
+    * geometry and solver caches built and swapped in on the watcher thread,
+    * see ZonedTracker::reload(), so ingest and the workers never wait for it.
+    * A file that cannot be read or is invalid (also one caught half written)
+    * is reported and the running geometry kept, the next change is tried again.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ZonedTracker.h"
+#include "SensorRegistry.h"
+
+class GeometryWatcher {
+    public:
+        // Called on the watcher thread after every reload, error is empty if it was applied.
+        using ReloadHandler = std::function<void(const std::vector<ZoneConfig>& zones, const std::string& error)>;
+
+    // --- Private var declaration to be used ---
+    private:
+        std::string path_;
+        ZonedTracker& tracker_;
+        SensorRegistry& registry_;
+        ReloadHandler on_reload_;
+        // What the file looked like at the last reload, so a poll can tell it changed.
+        std::filesystem::file_time_type last_write_{};
+        uintmax_t last_size_ = 0;
+        // Set from a signal handler, hence a lock-free atomic and nothing else.
+        std::atomic<bool> requested_{false};
+        std::atomic<uint64_t> reloads_{0};
+        std::atomic<uint64_t> failures_{0};
+
+        std::thread watch_thread_;
+        std::mutex watch_mutex_;
+        std::condition_variable watch_cv_;
+        bool watch_stop_ = false;
+
+        bool changed();
+
+    // --- Public method declarations ---
+    public:
+        GeometryWatcher(std::string path, ZonedTracker& tracker, SensorRegistry& registry, ReloadHandler on_reload = nullptr);
+        ~GeometryWatcher();
+
+        GeometryWatcher(const GeometryWatcher&) = delete;
+        GeometryWatcher& operator=(const GeometryWatcher&) = delete;
+
+        // Checks the file every poll_interval until stop(). The current file counts as already loaded.
+        void start(std::chrono::milliseconds poll_interval);
+        void stop();
+
+        // Async-signal-safe, the watcher reloads on its next poll even if the file did not change.
+        void request_reload() { requested_.store(true, std::memory_order_relaxed); }
+
+        /**
+            * @brief Reads the file and applies it on the calling thread.
+            *
+            * Returns false, after calling the handler with the reason, if the file
+            * cannot be read or does not fit the running tracker, which is then left
+            * as it was. Must not run concurrently with the watcher thread.
+        */
+        bool reload();
+
+        // Reloads applied and rejected so far.
+        uint64_t reloads() const { return reloads_.load(std::memory_order_relaxed); }
+        uint64_t failures() const { return failures_.load(std::memory_order_relaxed); }
+};
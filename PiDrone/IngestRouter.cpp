@@ -0,0 +1,135 @@
+/**
+    * @file IngestRouter.cpp
+    * @brief Topic resolution and NodeManager discovery for incoming messages.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "IngestRouter.h"
+#include "Metrics.h"
+#include <string_view>
+// --- End Imports ---
+
+IngestRouter::IngestRouter(std::string base_topic, SensorRegistry& registry, ZonedTracker& tracker,
+                           WorkStealingExecutor& executor, DiscoveryHandler on_discovered,
+                           const RangeFilterConfig& filter_config, const NodeQueueConfig& queue_config,
+                           ParticleFilter* particles)
+    : base_topic_(std::move(base_topic)), registry_(registry), tracker_(tracker), executor_(executor),
+      on_discovered_(std::move(on_discovered)), filter_config_(filter_config),
+      queue_config_(queue_config), particles_(particles),
+      topics_(registry.max_sensors()), topic_sensor_(new SensorHandle[registry.max_sensors()]),
+      nodes_(new NodeSlot[registry.max_nodes()]), node_count_(registry.max_nodes()) {}
+
+IngestRouter::~IngestRouter() {
+    clear();
+}
+
+/**
+    * @brief Maps a topic to its SensorHandle, interning it on first sight.
+    *
+    * Topics outside of base_topic_ or without an "<esp_id>/<sensor_id>" suffix
+    * resolve to INVALID_SENSOR.
+*/
+SensorHandle IngestRouter::resolve(const std::string& topic) {
+    uint32_t index = topics_.find(topic);
+    if (index != std::numeric_limits<uint32_t>::max()) {
+        return topic_sensor_[index];
+    }
+
+    std::string_view view(topic);
+    if (view.size() <= base_topic_.size() + 1 || view.compare(0, base_topic_.size(), base_topic_) != 0
+        || view[base_topic_.size()] != '/') {
+        return INVALID_SENSOR;
+    }
+
+    SensorHandle sensor = registry_.intern_sensor(view.substr(base_topic_.size() + 1));
+    if (sensor == INVALID_SENSOR) {
+        return INVALID_SENSOR;
+    }
+
+    std::lock_guard<std::mutex> lock(topic_mutex_);
+    index = topics_.find(topic);
+    if (index == std::numeric_limits<uint32_t>::max() && topics_.size() < topics_.capacity()) {
+        // Publish the mapping before the topic itself becomes findable.
+        topic_sensor_[topics_.size()] = sensor;
+        topics_.insert(topic);
+    }
+    return sensor;
+}
+
+/**
+    * @brief Dispatches a message to the NodeManager of the ESP node that sent it.
+    *
+    * Messages whose topic does not resolve to a sensor are silently dropped.
+    * The node's slot is only ever written by the thread that routes its
+    * messages, so a node seen for the first time gets exactly one manager
+    * without any lock, and add_message() keeps its single producer.
+*/
+void IngestRouter::route(IngestMessage&& msg) {
+    if (msg.sensor == INVALID_SENSOR) {
+        msg.sensor = resolve(msg.topic);
+        if (msg.sensor == INVALID_SENSOR) {
+            pipeline_metrics().add(PipelineCounter::Unrouted);
+            return;
+        }
+    }
+    const NodeHandle node = registry_.sensor(msg.sensor).node;
+    NodeSlot& slot = nodes_[node];
+
+    NodeManager* manager = slot.manager.load(std::memory_order_relaxed);
+    if (manager == nullptr) {
+        if (on_discovered_) on_discovered_(registry_.node(node).esp_id);
+        // With several zones a node runs on its zone's worker, which keeps that zone's tracker in its cache.
+        const uint16_t zone = tracker_.zone_count() > 1 ? tracker_.zone_of(msg.sensor) : ZonedTracker::NO_ZONE;
+        manager = new NodeManager(node, registry_, tracker_, executor_, filter_config_, queue_config_,
+                                  zone == ZonedTracker::NO_ZONE ? -1 : static_cast<int>(zone), particles_);
+        // Release so the metrics readers see a fully constructed manager.
+        slot.manager.store(manager, std::memory_order_release);
+    }
+    manager->add_message(std::move(msg));
+}
+
+IngestHandler IngestRouter::handler() {
+    return [this](IngestMessage&& msg) { route(std::move(msg)); };
+}
+
+void IngestRouter::clear() {
+    std::lock_guard<std::mutex> lock(retire_mutex_);
+    for (size_t i = 0; i < node_count_; ++i) {
+        NodeSlot& slot = nodes_[i];
+        NodeManager* manager = slot.manager.exchange(nullptr, std::memory_order_acq_rel);
+        if (manager == nullptr) continue;
+        // Nothing feeds it any more, so its counts are final.
+        cleared_dropped_ += manager->dropped();
+        cleared_coalesced_ += manager->coalesced();
+        delete manager;
+    }
+}
+
+size_t IngestRouter::queued() {
+    std::lock_guard<std::mutex> lock(retire_mutex_);
+    size_t total = 0;
+    for (size_t i = 0; i < node_count_; ++i) {
+        if (const NodeManager* manager = nodes_[i].manager.load(std::memory_order_acquire)) total += manager->queued();
+    }
+    return total;
+}
+
+uint64_t IngestRouter::dropped() {
+    std::lock_guard<std::mutex> lock(retire_mutex_);
+    uint64_t total = cleared_dropped_;
+    for (size_t i = 0; i < node_count_; ++i) {
+        if (const NodeManager* manager = nodes_[i].manager.load(std::memory_order_acquire)) total += manager->dropped();
+    }
+    return total;
+}
+
+uint64_t IngestRouter::coalesced() {
+    std::lock_guard<std::mutex> lock(retire_mutex_);
+    uint64_t total = cleared_coalesced_;
+    for (size_t i = 0; i < node_count_; ++i) {
+        if (const NodeManager* manager = nodes_[i].manager.load(std::memory_order_acquire)) total += manager->coalesced();
+    }
+    return total;
+}
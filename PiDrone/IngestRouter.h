@@ -0,0 +1,103 @@
+/**
+    * @file IngestRouter.h
+    * @brief Routes IngestMessages from any IngestSource to the owning NodeManager.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The router resolves the topic to a SensorHandle and lazily creates a
+    * NodeManager the first time a node is seen. It is the single entry point
+    * into the pipeline, regardless of which IngestSource produced the message.
+    *
+    * Every topic is validated and interned once. After that a message costs one
+    * hash of the topic and one lookup, no allocation and no parsing of the path.
+    *
+    * route() may be called from any number of threads, as long as all
+    * messages of one node come in on the same one; every IngestSource
+    * delivers from a single thread, so one source per router always is. The
+    * NodeManager of a node is found by its NodeHandle in a fixed array of
+    * atomic pointers and fed directly, the hot path takes no lock and no
+    * flag. Since only its own thread ever sees a node without a manager,
+    * discovery needs no synchronization either.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include "IngestSource.h"
+#include "SensorRegistry.h"
+#include "NodeManager.h"
+#include "WorkStealingExecutor.h"
+#include "ZonedTracker.h"
+
+class IngestRouter {
+    public:
+        // Called once per node, on the routing thread, possibly on several threads at once for different nodes.
+        using DiscoveryHandler = std::function<void(const std::string& esp_id)>;
+
+    // --- Private var declaration to be used ---
+    private:
+        std::string base_topic_;
+        SensorRegistry& registry_;
+        ZonedTracker& tracker_;
+        WorkStealingExecutor& executor_;
+        DiscoveryHandler on_discovered_;
+        RangeFilterConfig filter_config_;
+        NodeQueueConfig queue_config_;
+        ParticleFilter* particles_;
+
+        // Full topic string -> SensorHandle, filled in the first time a topic is seen.
+        InternTable topics_;
+        std::unique_ptr<SensorHandle[]> topic_sensor_;
+        std::mutex topic_mutex_;
+
+        // One per possible NodeHandle, on its own cache line so nodes routed from different threads do not share one.
+        // Written only by the node's routing thread and clear(), the metrics read it from anywhere.
+        struct alignas(CACHE_LINE_SIZE) NodeSlot {
+            std::atomic<NodeManager*> manager{nullptr};
+        };
+        std::unique_ptr<NodeSlot[]> nodes_;
+        size_t node_count_;
+        // Keeps clear() from deleting managers while the metrics read them.
+        std::mutex retire_mutex_;
+        // Counts of the NodeManagers clear() destroyed, so they survive shutdown.
+        uint64_t cleared_dropped_ = 0;
+        uint64_t cleared_coalesced_ = 0;
+
+        SensorHandle resolve(const std::string& topic);
+
+    // --- Public method declarations ---
+    public:
+        IngestRouter(std::string base_topic, SensorRegistry& registry, ZonedTracker& tracker,
+                     WorkStealingExecutor& executor, DiscoveryHandler on_discovered = {},
+                     const RangeFilterConfig& filter_config = {}, const NodeQueueConfig& queue_config = {},
+                     ParticleFilter* particles = nullptr);
+        // Same as clear().
+        ~IngestRouter();
+
+        IngestRouter(const IngestRouter&) = delete;
+        IngestRouter& operator=(const IngestRouter&) = delete;
+
+        // Messages of one node must always be routed from the same thread, see NodeManager::add_message().
+        void route(IngestMessage&& msg);
+
+        // Hands out a handler bound to this router, for IngestSource::start().
+        IngestHandler handler();
+
+        // Destroys every NodeManager once its queue has been fully processed. A later route() starts a new one.
+        // Must not run concurrently with route(): stop the source and join it first, never call it from a signal handler.
+        void clear();
+
+        // Messages waiting in all NodeManager queues, for the metrics.
+        size_t queued();
+
+        // Messages lost to the overload policy, summed over all nodes, see OverloadPolicy.
+        uint64_t dropped();
+        uint64_t coalesced();
+};
@@ -0,0 +1,101 @@
+/**
+    * @file IngestSource.h
+    * @brief Transport-neutral message type and the abstract source that produces it.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Everything downstream of the transport (IngestRouter -> NodeManager -> DroneTracker)
+    * only sees IngestMessage, so the pipeline can be fed by the live MQTT broker,
+    * a recorded capture file or an in-memory generator without any code change.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <string>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include "SensorRegistry.h"
+
+using IngestClock = std::chrono::steady_clock;
+
+/**
+    * @struct IngestMessage
+    * @brief A single raw reading as it arrived from a sensor node.
+    *
+    * topic follows the "drones/data/<esp_id>/<sensor_id>" layout, payload is the
+    * untouched JSON body and received_at is stamped by the source on arrival.
+    * sensor is resolved from the topic by the IngestRouter, a source that already
+    * knows the handle may fill it in to skip the topic lookup. enqueued_at is
+    * stamped by the NodeManager while latency metrics are being recorded.
+*/
+struct IngestMessage {
+    std::string topic;
+    std::string payload;
+    IngestClock::time_point received_at;
+    SensorHandle sensor = INVALID_SENSOR;
+    IngestClock::time_point enqueued_at{};
+};
+
+using IngestHandler = std::function<void(IngestMessage&&)>;
+
+/**
+    * @class IngestSource
+    * @brief Abstract producer of IngestMessages.
+    *
+    * start() begins delivery to the handler and returns immediately, every source
+    * delivers from a single thread of its own. join() blocks until the source is
+    * exhausted or stopped and returns false if it ended because of an error.
+*/
+class IngestSource {
+    public:
+        virtual ~IngestSource() = default;
+
+        virtual void start(IngestHandler handler) = 0;
+        virtual void stop() = 0;
+        virtual bool join() = 0;
+};
+
+/**
+    * @class ThreadedIngestSource
+    * @brief Base for sources that produce messages from a dedicated thread.
+    *
+    * Subclasses implement run(), which should return as soon as stop_requested()
+    * becomes true. The return value of run() is what join() reports.
+*/
+class ThreadedIngestSource : public IngestSource {
+    private:
+        std::thread worker_;
+        std::atomic<bool> stop_flag_{false};
+        bool ok_ = true;
+
+    protected:
+        virtual bool run(const IngestHandler& handler) = 0;
+
+        bool stop_requested() const { return stop_flag_.load(std::memory_order_relaxed); }
+
+    public:
+        ~ThreadedIngestSource() override {
+            // Subclasses must call stop() and join() in their own destructor,
+            // run() cannot safely execute once they have been destroyed.
+            if (worker_.joinable()) {
+                stop_flag_ = true;
+                worker_.join();
+            }
+        }
+
+        void start(IngestHandler handler) override {
+            stop_flag_ = false;
+            worker_ = std::thread([this, handler = std::move(handler)] { ok_ = run(handler); });
+        }
+
+        void stop() override { stop_flag_ = true; }
+
+        bool join() override {
+            if (worker_.joinable()) worker_.join();
+            return ok_;
+        }
+};
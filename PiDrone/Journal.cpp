@@ -0,0 +1,257 @@
+/**
+    * @file Journal.cpp
+    * @brief Ring hand-off, segment mapping and reading of the message journal.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "Journal.h"
+#include <cerrno>
+#include <iostream>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// --- End Imports ---
+
+namespace {
+
+size_t align8(size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+}
+
+size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+std::runtime_error journal_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+JournalWriter::JournalWriter(const std::string& path, size_t ring_bytes)
+    : path_(path), ring_capacity_(round_up_pow2(ring_bytes < 4096 ? 4096 : ring_bytes)),
+      ring_(new unsigned char[ring_capacity_]) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw journal_error("cannot create journal", path);
+    }
+    writer_ = std::thread([this] { writer_loop(); });
+}
+
+JournalWriter::~JournalWriter() {
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+    close_segment();
+    ::close(fd_);
+}
+
+/**
+    * @brief Copies the message into the ring, on the ingest thread.
+    *
+    * Entries are contiguous in the ring. One that does not fit before the end
+    * is preceded by a wrap marker and written from the start.
+*/
+bool JournalWriter::append(const IngestMessage& msg) {
+    const size_t need = align8(sizeof(Pending) + msg.topic.size() + msg.payload.size());
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t pos = tail & (ring_capacity_ - 1);
+    const size_t to_end = ring_capacity_ - pos;
+    const size_t total = need <= to_end ? need : to_end + need;
+
+    if (need > ring_capacity_ / 2) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (tail + total - cached_head_ > ring_capacity_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail + total - cached_head_ > ring_capacity_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    unsigned char* out = ring_.get() + pos;
+    if (total != need) {
+        const uint32_t wrap = 0;
+        std::memcpy(out, &wrap, sizeof(wrap));
+        out = ring_.get();
+    }
+    Pending header{};
+    header.size = static_cast<uint32_t>(need);
+    header.topic_length = static_cast<uint32_t>(msg.topic.size());
+    header.payload_length = static_cast<uint32_t>(msg.payload.size());
+    header.received_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.received_at.time_since_epoch()).count();
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), msg.topic.data(), msg.topic.size());
+    std::memcpy(out + sizeof(header) + msg.topic.size(), msg.payload.data(), msg.payload.size());
+
+    tail_.store(tail + total, std::memory_order_release);
+    appended_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void JournalWriter::writer_loop() {
+    for (;;) {
+        if (drain() > 0) continue;
+        if (stop_.load(std::memory_order_acquire)) {
+            // Anything appended before stop was requested is visible now.
+            if (drain() == 0) break;
+            continue;
+        }
+        std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
+
+size_t JournalWriter::drain() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    size_t count = 0;
+    while (head != tail) {
+        const size_t pos = head & (ring_capacity_ - 1);
+        Pending header;
+        std::memcpy(&header, ring_.get() + pos, sizeof(uint32_t));
+        if (header.size == 0) {
+            head += ring_capacity_ - pos;
+            continue;
+        }
+        std::memcpy(&header, ring_.get() + pos, sizeof(header));
+        const char* bytes = reinterpret_cast<const char*>(ring_.get() + pos + sizeof(header));
+        const std::string_view topic(bytes, header.topic_length);
+        const std::string_view payload(bytes + header.topic_length, header.payload_length);
+
+        const IngestClock::time_point received{std::chrono::nanoseconds(header.received_ns)};
+        if (!started_) {
+            started_ = true;
+            start_ = received;
+            start_unix_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        auto found = topic_ids_.find(std::string(topic));
+        uint32_t topic_id;
+        if (found == topic_ids_.end()) {
+            topic_id = static_cast<uint32_t>(topic_ids_.size());
+            topic_ids_.emplace(std::string(topic), topic_id);
+            write_record(JournalRecordType::Topic, topic_id, 0, topic);
+        } else {
+            topic_id = found->second;
+        }
+        write_record(JournalRecordType::Message, topic_id,
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(received - start_).count(), payload);
+
+        head += header.size;
+        ++count;
+    }
+    if (count > 0) {
+        head_.store(head, std::memory_order_release);
+        written_.fetch_add(count, std::memory_order_release);
+    }
+    return count;
+}
+
+void JournalWriter::write_record(JournalRecordType type, uint32_t topic_id, int64_t time_ns, std::string_view body) {
+    const size_t size = align8(sizeof(JournalRecordHeader) + body.size());
+    if (size > JOURNAL_SEGMENT_SIZE - sizeof(JournalSegmentHeader)) {
+        // Cannot be split across segments, and the ring already refuses anything near this size.
+        return;
+    }
+    if (failed_) return;
+    if (!segment_ || segment_used_ + size > JOURNAL_SEGMENT_SIZE) {
+        close_segment();
+        if (!open_segment()) {
+            // Keep draining the ring so the ingest thread is not affected, just stop recording.
+            std::cerr << "Journal " << path_ << " stopped recording: " << std::strerror(errno) << std::endl;
+            failed_ = true;
+            return;
+        }
+    }
+
+    // Body first, the header makes the record visible to a reader of a live or crashed journal.
+    unsigned char* out = segment_ + segment_used_;
+    std::memcpy(out + sizeof(JournalRecordHeader), body.data(), body.size());
+    JournalRecordHeader header{};
+    header.size = static_cast<uint32_t>(size);
+    header.type = static_cast<uint16_t>(type);
+    header.topic_id = topic_id;
+    header.length = static_cast<uint32_t>(body.size());
+    header.time_ns = time_ns;
+    std::memcpy(out, &header, sizeof(header));
+    segment_used_ += size;
+}
+
+/**
+    * @brief Grows the file by one segment and maps it.
+    *
+    * The new segment reads as zeros, so its unused tail already is the end marker.
+    * Returns false with errno set if the file cannot grow, typically a full disk.
+*/
+bool JournalWriter::open_segment() {
+    const off_t offset = static_cast<off_t>(segment_index_) * JOURNAL_SEGMENT_SIZE;
+    if (::ftruncate(fd_, offset + static_cast<off_t>(JOURNAL_SEGMENT_SIZE)) != 0) {
+        return false;
+    }
+    void* mapped = ::mmap(nullptr, JOURNAL_SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, offset);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    segment_ = static_cast<unsigned char*>(mapped);
+
+    JournalSegmentHeader header{};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.header_size = sizeof(JournalSegmentHeader);
+    header.segment_size = JOURNAL_SEGMENT_SIZE;
+    header.segment_index = segment_index_;
+    header.start_unix_ns = start_unix_ns_;
+    std::memcpy(segment_, &header, sizeof(header));
+    segment_used_ = sizeof(JournalSegmentHeader);
+    return true;
+}
+
+// Full segments are handed to the kernel for write-back without waiting for it.
+void JournalWriter::close_segment() {
+    if (!segment_) return;
+    ::msync(segment_, JOURNAL_SEGMENT_SIZE, MS_ASYNC);
+    ::munmap(segment_, JOURNAL_SEGMENT_SIZE);
+    segment_ = nullptr;
+    ++segment_index_;
+}
+
+JournalReader::JournalReader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw journal_error("cannot open journal", path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(JOURNAL_SEGMENT_SIZE)) {
+        ::close(fd);
+        throw std::runtime_error("not a journal: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw journal_error("cannot map journal", path);
+    }
+    data_ = static_cast<const unsigned char*>(mapped);
+    ::madvise(const_cast<unsigned char*>(data_), size_, MADV_SEQUENTIAL);
+
+    JournalSegmentHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0 || header.version != JOURNAL_VERSION
+        || header.segment_size != JOURNAL_SEGMENT_SIZE) {
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+        throw std::runtime_error("not a journal, or an unsupported version: " + path);
+    }
+    start_unix_ns_ = header.start_unix_ns;
+}
+
+JournalReader::~JournalReader() {
+    ::munmap(const_cast<unsigned char*>(data_), size_);
+}
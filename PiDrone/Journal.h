@@ -0,0 +1,209 @@
+/**
+    * @file Journal.h
+    * @brief Append-only, memory mapped journal of the raw messages the tracker received.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The journal records exactly what arrived on the ingest path (topic,
+    * receive time, untouched payload) so an incident can be replayed through
+    * the pipeline later, see JournalIngestSource.
+    *
+    * The file is a sequence of JOURNAL_SEGMENT_SIZE segments, each a multiple
+    * of the page size and mapped one at a time by the writer. A segment starts
+    * with a JournalSegmentHeader followed by length prefixed records, all
+    * 8 byte aligned. A record never straddles two segments, a zero size field
+    * marks the unused rest of a segment. Topics are written once, as a Topic
+    * record, and referenced by id from then on. Everything is little endian.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "IngestSource.h"
+#include "SpscRing.h"
+
+constexpr size_t JOURNAL_SEGMENT_SIZE = 1 << 20;
+constexpr char JOURNAL_MAGIC[4] = {'P', 'D', 'J', 'L'};
+constexpr uint16_t JOURNAL_VERSION = 1;
+
+struct JournalSegmentHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t segment_size;
+    uint32_t segment_index;
+    int64_t start_unix_ns; // wall clock time of the first record of the journal
+    uint8_t reserved[40];
+};
+
+enum class JournalRecordType : uint16_t {
+    Topic = 1,   // defines topic_id, the body is the topic string
+    Message = 2  // the body is the payload, time_ns is the receive time
+};
+
+struct JournalRecordHeader {
+    uint32_t size;     // whole record including header and padding, 0 = end of segment
+    uint16_t type;     // JournalRecordType
+    uint16_t reserved;
+    uint32_t topic_id;
+    uint32_t length;   // body bytes, without padding
+    int64_t time_ns;   // since the first record of the journal, on IngestClock
+};
+
+static_assert(sizeof(JournalSegmentHeader) == 64, "segment header layout is part of the file format");
+static_assert(sizeof(JournalRecordHeader) == 24, "record header layout is part of the file format");
+
+/**
+    * @class JournalWriter
+    * @brief Records IngestMessages to a journal file from a background thread.
+    *
+    * append() is meant to be called from the ingest callback (one thread at a
+    * time). It copies topic and payload into a preallocated SPSC byte ring and
+    * returns, it never allocates, blocks or touches the file. If the writer
+    * falls behind and the ring fills up the message is not journaled and
+    * counted in dropped(), the message itself still goes down the pipeline.
+    * A write error (disk full) ends the recording, not the tracker.
+*/
+class JournalWriter {
+    // --- Private var declaration to be used ---
+    private:
+        // Ring entry header, the topic and payload bytes follow it.
+        struct Pending {
+            uint32_t size; // whole entry, 8 byte aligned, 0 = wrap to the start of the ring
+            uint32_t topic_length;
+            uint32_t payload_length;
+            uint32_t reserved;
+            int64_t received_ns;
+        };
+
+        static constexpr auto IDLE_SLEEP = std::chrono::milliseconds(1);
+
+        int fd_ = -1;
+        std::string path_;
+
+        // Producer side.
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+        size_t cached_head_ = 0;
+        // Consumer side.
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+        size_t ring_capacity_;
+        std::unique_ptr<unsigned char[]> ring_;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> appended_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::atomic<uint64_t> written_{0};
+        std::atomic<bool> stop_{false};
+
+        // Writer thread only.
+        unsigned char* segment_ = nullptr;
+        uint32_t segment_index_ = 0;
+        size_t segment_used_ = 0;
+        bool started_ = false;
+        bool failed_ = false;
+        IngestClock::time_point start_;
+        int64_t start_unix_ns_ = 0;
+        std::unordered_map<std::string, uint32_t> topic_ids_;
+        std::thread writer_;
+
+        void writer_loop();
+        size_t drain();
+        void write_record(JournalRecordType type, uint32_t topic_id, int64_t time_ns, std::string_view body);
+        bool open_segment();
+        void close_segment();
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @param path Journal file, truncated if it exists, throws std::runtime_error if it cannot be created
+            * @param ring_bytes Size of the hand-off buffer between the ingest thread and the writer
+        */
+        explicit JournalWriter(const std::string& path, size_t ring_bytes = 8 << 20);
+        // Writes out everything appended so far, then closes the file.
+        ~JournalWriter();
+
+        JournalWriter(const JournalWriter&) = delete;
+        JournalWriter& operator=(const JournalWriter&) = delete;
+
+        // Single producer, see the class comment. Returns false if the message was dropped.
+        bool append(const IngestMessage& msg);
+
+        uint64_t appended() const { return appended_.load(std::memory_order_relaxed); }
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+        uint64_t written() const { return written_.load(std::memory_order_acquire); }
+};
+
+/**
+    * @class JournalReader
+    * @brief Maps a journal read-only and walks its messages in recorded order.
+    *
+    * A journal cut short by a crash reads up to its last complete record.
+*/
+class JournalReader {
+    // --- Private var declaration to be used ---
+    private:
+        const unsigned char* data_ = nullptr;
+        size_t size_ = 0;
+        int64_t start_unix_ns_ = 0;
+
+    // --- Public method declarations ---
+    public:
+        // Throws std::runtime_error if the file cannot be mapped or is not a journal.
+        explicit JournalReader(const std::string& path);
+        ~JournalReader();
+
+        JournalReader(const JournalReader&) = delete;
+        JournalReader& operator=(const JournalReader&) = delete;
+
+        /**
+            * @brief Calls visit(std::string_view topic, int64_t time_ns, std::string_view payload) per message.
+            *
+            * The views point into the mapping and stay valid as long as the reader.
+            * visit may return false to stop early.
+            *
+            * @return Number of messages visited.
+        */
+        template <typename Visit>
+        size_t for_each(Visit&& visit) const;
+
+        int64_t start_unix_ns() const { return start_unix_ns_; }
+};
+
+template <typename Visit>
+size_t JournalReader::for_each(Visit&& visit) const {
+    std::vector<std::string_view> topics;
+    size_t count = 0;
+    for (size_t segment = 0; segment + JOURNAL_SEGMENT_SIZE <= size_; segment += JOURNAL_SEGMENT_SIZE) {
+        size_t offset = sizeof(JournalSegmentHeader);
+        while (offset + sizeof(JournalRecordHeader) <= JOURNAL_SEGMENT_SIZE) {
+            JournalRecordHeader header;
+            std::memcpy(&header, data_ + segment + offset, sizeof(header));
+            if (header.size == 0) break;
+            if (header.size < sizeof(header) + header.length || header.size > JOURNAL_SEGMENT_SIZE - offset) return count;
+
+            std::string_view body(reinterpret_cast<const char*>(data_ + segment + offset + sizeof(header)), header.length);
+            if (header.type == static_cast<uint16_t>(JournalRecordType::Topic)) {
+                if (header.topic_id != topics.size()) return count;
+                topics.push_back(body);
+            } else if (header.type == static_cast<uint16_t>(JournalRecordType::Message)) {
+                if (header.topic_id >= topics.size()) return count;
+                ++count;
+                if (!visit(topics[header.topic_id], header.time_ns, body)) return count;
+            } else {
+                return count;
+            }
+            offset += header.size;
+        }
+    }
+    return count;
+}
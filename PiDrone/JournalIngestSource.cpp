@@ -0,0 +1,37 @@
+/**
+    * @file JournalIngestSource.cpp
+    * @brief Paced or unpaced replay of a mapped message journal.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "JournalIngestSource.h"
+// --- End Imports ---
+
+JournalIngestSource::JournalIngestSource(const std::string& path, double speed, size_t loops)
+    : reader_(path), speed_(speed), loops_(loops) {}
+
+JournalIngestSource::~JournalIngestSource() {
+    stop();
+    join();
+}
+
+bool JournalIngestSource::run(const IngestHandler& handler) {
+    for (size_t loop = 0; loop < loops_ && !stop_requested(); ++loop) {
+        const auto loop_start = IngestClock::now();
+
+        reader_.for_each([&](std::string_view topic, int64_t time_ns, std::string_view payload) {
+            if (stop_requested()) return false;
+
+            if (speed_ > 0.0) {
+                auto due = loop_start + std::chrono::duration_cast<IngestClock::duration>(
+                    std::chrono::duration<double, std::nano>(static_cast<double>(time_ns) / speed_));
+                std::this_thread::sleep_until(due);
+            }
+            handler(IngestMessage{std::string(topic), std::string(payload), IngestClock::now()});
+            return true;
+        });
+    }
+    return true;
+}
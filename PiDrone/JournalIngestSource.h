@@ -0,0 +1,41 @@
+/**
+    * @file JournalIngestSource.h
+    * @brief IngestSource that replays a message journal through the pipeline.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The journal is mapped, not loaded, so even long recordings start replaying
+    * at once. Messages are delivered in recorded order with their original
+    * topics and payloads, either at the recorded pace, N times faster or as
+    * fast as the pipeline takes them. The last mode, with a single node or an
+    * executor of one worker, makes NodeManager and DroneTracker runs repeatable.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <string>
+#include "IngestSource.h"
+#include "Journal.h"
+
+class JournalIngestSource : public ThreadedIngestSource {
+    // --- Private var declaration to be used ---
+    private:
+        JournalReader reader_;
+        double speed_;
+        size_t loops_;
+
+    protected:
+        bool run(const IngestHandler& handler) override;
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @param path Journal written by JournalWriter, throws std::runtime_error if it cannot be mapped
+            * @param speed Replay speed relative to the recording, 1 is the recorded pace, 0 as fast as possible
+            * @param loops How many times to replay the journal
+        */
+        JournalIngestSource(const std::string& path, double speed = 1.0, size_t loops = 1);
+        ~JournalIngestSource() override;
+};
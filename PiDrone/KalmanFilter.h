@@ -0,0 +1,169 @@
+/**
+    * @file KalmanFilter.h
+    * @brief Linear Kalman filter for a 2D kinematic target of fixed order.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Order is the number of kinematic terms per axis: 2 for constant velocity
+    * (position, velocity) and 3 for constant acceleration (position, velocity,
+    * acceleration). The state vector is the x terms followed by the y terms, so
+    * a CV filter keeps [x, vx, y, vy]. Only positions are measured.
+    *
+    * Process noise follows the piecewise white noise model: the highest
+    * derivative receives an independent random step every predict, scaled by
+    * process_noise (m/s^2 for CV, m/s^3 for CA).
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <cmath>
+#include <cstddef>
+#include "Matrix.h"
+#include "SensorModel.h"
+
+template <size_t Order>
+class KinematicKalman {
+    static_assert(Order >= 2, "the filter needs at least position and velocity");
+
+    public:
+        static constexpr size_t STATE = 2 * Order;
+        static constexpr size_t X = 0;
+        static constexpr size_t Y = Order;
+
+        using StateVector = Matrix<STATE, 1>;
+        using Covariance = Matrix<STATE, STATE>;
+
+    // --- Private var declaration to be used ---
+    private:
+        StateVector x_;
+        Covariance p_;
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @brief Starts the filter at a measured position with unknown motion.
+            * @param position_var Variance of the first fix, per axis, in m^2
+            * @param motion_var Variance of every velocity / acceleration term
+        */
+        void reset(const Point& position, double position_var, double motion_var) {
+            x_ = StateVector{};
+            x_.m[X][0] = position.x;
+            x_.m[Y][0] = position.y;
+            p_ = Covariance{};
+            for (size_t i = 0; i < STATE; ++i) p_.m[i][i] = motion_var;
+            p_.m[X][X] = position_var;
+            p_.m[Y][Y] = position_var;
+        }
+
+        /**
+            * @brief Advances the state by dt seconds.
+            *
+            * F is block diagonal with one upper triangular Taylor block per axis,
+            * so F P F^T is evaluated directly from the coefficients instead of
+            * as two dense products, and only its upper triangle is computed.
+        */
+        void predict(double dt, double process_noise) {
+            if (dt <= 0.0) return;
+
+            // c[k] = dt^k / k!, the transition block uses 0..Order-1, the noise gain 1..Order.
+            double c[Order + 1];
+            c[0] = 1.0;
+            for (size_t k = 1; k <= Order; ++k) c[k] = c[k - 1] * dt / static_cast<double>(k);
+
+            for (size_t base = 0; base < STATE; base += Order)
+                for (size_t i = 0; i < Order; ++i) {
+                    double v = 0.0;
+                    for (size_t k = i; k < Order; ++k) v += c[k - i] * x_.m[base + k][0];
+                    x_.m[base + i][0] = v;
+                }
+
+            Covariance fp;
+            for (size_t i = 0; i < STATE; ++i) {
+                const size_t bi = i - i % Order;
+                for (size_t j = 0; j < STATE; ++j) {
+                    double v = 0.0;
+                    for (size_t k = i % Order; k < Order; ++k) v += c[k - i % Order] * p_.m[bi + k][j];
+                    fp.m[i][j] = v;
+                }
+            }
+
+            // Noise gain of a step in the highest derivative, dt^(Order-i) / (Order-i)!.
+            const double q = process_noise * process_noise;
+            for (size_t i = 0; i < STATE; ++i)
+                for (size_t j = i; j < STATE; ++j) {
+                    const size_t bj = j - j % Order;
+                    double v = 0.0;
+                    for (size_t k = j % Order; k < Order; ++k) v += fp.m[i][bj + k] * c[k - j % Order];
+                    if (i - i % Order == bj) v += q * c[Order - i % Order] * c[Order - j % Order];
+                    p_.m[i][j] = p_.m[j][i] = v;
+                }
+        }
+
+        /**
+            * @brief Squared Mahalanobis distance of a fix from the predicted position.
+            * Useful to gate fixes before they are allowed to update the track.
+            * @param log_det If set, receives ln |S| of the innovation covariance S,
+            * which turns the distance into a proper negative log-likelihood.
+        */
+        double innovation_distance(const Point& z, double measurement_var, double* log_det = nullptr) const {
+            Matrix<2, 2> s;
+            s.m[0][0] = p_.m[X][X] + measurement_var;
+            s.m[0][1] = p_.m[X][Y];
+            s.m[1][0] = p_.m[Y][X];
+            s.m[1][1] = p_.m[Y][Y] + measurement_var;
+            Matrix<2, 2> s_inv;
+            if (!invert(s, s_inv)) return 0.0;
+            if (log_det) *log_det = std::log(s.m[0][0] * s.m[1][1] - s.m[0][1] * s.m[1][0]);
+            const double dx = z.x - x_.m[X][0];
+            const double dy = z.y - x_.m[Y][0];
+            return dx * (s_inv.m[0][0] * dx + s_inv.m[0][1] * dy) + dy * (s_inv.m[1][0] * dx + s_inv.m[1][1] * dy);
+        }
+
+        /**
+            * @brief Folds a position fix into the state.
+            *
+            * H only selects the two position terms, so P H^T is just two columns
+            * of P and the covariance update is P - K (H P), symmetrized to keep
+            * rounding from drifting it. No full STATE x STATE product is needed.
+            *
+            * @return false if the innovation covariance was singular and nothing changed
+        */
+        bool update(const Point& z, double measurement_var) {
+            Matrix<STATE, 2> pht;
+            for (size_t i = 0; i < STATE; ++i) {
+                pht.m[i][0] = p_.m[i][X];
+                pht.m[i][1] = p_.m[i][Y];
+            }
+
+            Matrix<2, 2> s;
+            s.m[0][0] = p_.m[X][X] + measurement_var;
+            s.m[0][1] = p_.m[X][Y];
+            s.m[1][0] = p_.m[Y][X];
+            s.m[1][1] = p_.m[Y][Y] + measurement_var;
+            Matrix<2, 2> s_inv;
+            if (!invert(s, s_inv)) return false;
+            const Matrix<STATE, 2> k = pht * s_inv;
+
+            const double dx = z.x - x_.m[X][0];
+            const double dy = z.y - x_.m[Y][0];
+            for (size_t i = 0; i < STATE; ++i) {
+                x_.m[i][0] += k.m[i][0] * dx + k.m[i][1] * dy;
+            }
+
+            for (size_t i = 0; i < STATE; ++i)
+                for (size_t j = i; j < STATE; ++j) {
+                    const double a = p_.m[i][j] - (k.m[i][0] * pht.m[j][0] + k.m[i][1] * pht.m[j][1]);
+                    const double b = p_.m[j][i] - (k.m[j][0] * pht.m[i][0] + k.m[j][1] * pht.m[i][1]);
+                    p_.m[i][j] = p_.m[j][i] = 0.5 * (a + b);
+                }
+            return true;
+        }
+
+        const StateVector& state() const { return x_; }
+        const Covariance& covariance() const { return p_; }
+
+        Point position() const { return {x_.m[X][0], x_.m[Y][0]}; }
+        Point velocity() const { return {x_.m[X + 1][0], x_.m[Y + 1][0]}; }
+};
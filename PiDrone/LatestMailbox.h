@@ -0,0 +1,72 @@
+/**
+    * @file LatestMailbox.h
+    * @brief Single-producer/single-consumer mailbox that only keeps the newest value.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * A triple buffer: the producer writes into its back buffer and swaps it
+    * with the middle one, the consumer swaps its front buffer with the middle
+    * one when a new value is there. Neither side ever waits for the other and
+    * a value the consumer did not get to in time is simply overwritten, which
+    * post() reports so the caller can count it. The three values are reused,
+    * so once their buffers have grown nothing is allocated any more.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include "SpscRing.h"
+
+template <typename T>
+class LatestMailbox {
+    // --- Private var declaration to be used ---
+    private:
+        static constexpr uint8_t INDEX_MASK = 0x3;
+        static constexpr uint8_t FRESH = 0x4;
+
+        T buffers_[3];
+        // Index of the middle buffer, FRESH if it holds a value the consumer has not taken.
+        alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> middle_{1};
+        alignas(CACHE_LINE_SIZE) uint8_t back_ = 0;  // producer only
+        alignas(CACHE_LINE_SIZE) uint8_t front_ = 2; // consumer only
+
+    // --- Public method declarations ---
+    public:
+        LatestMailbox() = default;
+        LatestMailbox(const LatestMailbox&) = delete;
+        LatestMailbox& operator=(const LatestMailbox&) = delete;
+
+        /**
+            * @brief Producer side. Makes value the newest one.
+            *
+            * @return true if it replaced a value the consumer never took.
+        */
+        bool post(T&& value) {
+            buffers_[back_] = std::move(value);
+            const uint8_t previous = middle_.exchange(static_cast<uint8_t>(back_ | FRESH), std::memory_order_acq_rel);
+            back_ = previous & INDEX_MASK;
+            return (previous & FRESH) != 0;
+        }
+
+        /**
+            * @brief Consumer side. Hands the newest value to fn if one arrived since the last take.
+            *
+            * fn receives a T& it may move from.
+            *
+            * @return false if there was nothing new.
+        */
+        template <typename Fn>
+        bool take(Fn&& fn) {
+            if ((middle_.load(std::memory_order_acquire) & FRESH) == 0) return false;
+            const uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = previous & INDEX_MASK;
+            fn(buffers_[front_]);
+            return true;
+        }
+
+        // Safe to call from either side, the answer may be stale by the time it is used.
+        bool has_value() const { return (middle_.load(std::memory_order_acquire) & FRESH) != 0; }
+};
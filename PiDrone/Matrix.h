@@ -0,0 +1,93 @@
+/**
+    * @file Matrix.h
+    * @brief Fixed size dense matrix for the small linear algebra of the filters.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Dimensions are template parameters, so a matrix is a plain array on the
+    * stack and every loop below has a compile-time trip count the compiler can
+    * fully unroll. Nothing here allocates.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <cstddef>
+
+template <size_t R, size_t C>
+struct Matrix {
+    double m[R][C] = {};
+
+    static constexpr size_t rows = R;
+    static constexpr size_t cols = C;
+
+    double& operator()(size_t r, size_t c) { return m[r][c]; }
+    double operator()(size_t r, size_t c) const { return m[r][c]; }
+
+    static Matrix zero() { return Matrix{}; }
+
+    static Matrix identity() {
+        static_assert(R == C, "identity needs a square matrix");
+        Matrix out;
+        for (size_t i = 0; i < R; ++i) out.m[i][i] = 1.0;
+        return out;
+    }
+
+    Matrix<C, R> transpose() const {
+        Matrix<C, R> out;
+        for (size_t r = 0; r < R; ++r)
+            for (size_t c = 0; c < C; ++c) out.m[c][r] = m[r][c];
+        return out;
+    }
+
+    Matrix& operator+=(const Matrix& other) {
+        for (size_t r = 0; r < R; ++r)
+            for (size_t c = 0; c < C; ++c) m[r][c] += other.m[r][c];
+        return *this;
+    }
+
+    Matrix& operator-=(const Matrix& other) {
+        for (size_t r = 0; r < R; ++r)
+            for (size_t c = 0; c < C; ++c) m[r][c] -= other.m[r][c];
+        return *this;
+    }
+
+    Matrix& operator*=(double s) {
+        for (size_t r = 0; r < R; ++r)
+            for (size_t c = 0; c < C; ++c) m[r][c] *= s;
+        return *this;
+    }
+};
+
+template <size_t R, size_t C>
+inline Matrix<R, C> operator+(Matrix<R, C> a, const Matrix<R, C>& b) { return a += b; }
+
+template <size_t R, size_t C>
+inline Matrix<R, C> operator-(Matrix<R, C> a, const Matrix<R, C>& b) { return a -= b; }
+
+template <size_t R, size_t K, size_t C>
+inline Matrix<R, C> operator*(const Matrix<R, K>& a, const Matrix<K, C>& b) {
+    Matrix<R, C> out;
+    for (size_t r = 0; r < R; ++r)
+        for (size_t k = 0; k < K; ++k) {
+            const double v = a.m[r][k];
+            for (size_t c = 0; c < C; ++c) out.m[r][c] += v * b.m[k][c];
+        }
+    return out;
+}
+
+/**
+    * @brief Closed form inverse of a 2x2 matrix, the innovation covariance of a position fix.
+    * @return false if the matrix is singular, out is left untouched.
+*/
+inline bool invert(const Matrix<2, 2>& a, Matrix<2, 2>& out) {
+    const double det = a.m[0][0] * a.m[1][1] - a.m[0][1] * a.m[1][0];
+    if (det == 0.0) return false;
+    const double inv = 1.0 / det;
+    out.m[0][0] = a.m[1][1] * inv;
+    out.m[0][1] = -a.m[0][1] * inv;
+    out.m[1][0] = -a.m[1][0] * inv;
+    out.m[1][1] = a.m[0][0] * inv;
+    return true;
+}
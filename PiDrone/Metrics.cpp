@@ -0,0 +1,246 @@
+/**
+    * @file Metrics.cpp
+    * @brief Histogram bucketing, per-thread blocks and the Prometheus text exporter.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "Metrics.h"
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+// --- End Imports ---
+
+namespace {
+
+const char* const STAGE_NAMES[LATENCY_STAGE_COUNT] = {"route", "queue", "parse", "update", "solve", "end_to_end"};
+
+struct CounterInfo {
+    const char* name;
+    const char* help;
+};
+
+const CounterInfo COUNTER_INFO[PIPELINE_COUNTER_COUNT] = {
+    {"pidrone_messages_total", "Messages taken off a NodeManager queue."},
+    {"pidrone_readings_total", "Sensor readings processed, a batched frame carries several."},
+    {"pidrone_parse_errors_total", "Messages dropped because their payload could not be decoded."},
+    {"pidrone_unrouted_messages_total", "Messages whose topic did not resolve to a sensor."},
+    {"pidrone_rejected_readings_total", "Readings the range filter kept from the tracker."},
+    {"pidrone_fixes_total", "Position fixes produced."},
+    {"pidrone_format_changes_total", "Sensors whose payload format changed after their first message."}
+};
+
+// Bucket bounds of the exported Prometheus histogram, in seconds.
+const double EXPORT_BOUNDS_S[] = {1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+                                  1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1.0};
+const double EXPORT_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+void append(std::string& out, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+void append(std::string& out, const char* fmt, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, fmt);
+    const int n = std::vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (n > 0) out.append(line, static_cast<size_t>(n) < sizeof(line) ? static_cast<size_t>(n) : sizeof(line) - 1);
+}
+
+}
+
+const char* latency_stage_name(LatencyStage stage) {
+    return STAGE_NAMES[static_cast<size_t>(stage)];
+}
+
+/**
+    * Values below 16 get a bucket each. Above, the exponent of the leading
+    * bit picks a group of 16 buckets and the next four bits the bucket in it.
+*/
+size_t HistogramSnapshot::bucket_of(uint64_t ns) {
+    constexpr uint64_t sub_count = uint64_t(1) << HISTOGRAM_SUB_BITS;
+    if (ns < sub_count) return static_cast<size_t>(ns);
+    if (ns >= uint64_t(1) << HISTOGRAM_MAX_EXPONENT) ns = (uint64_t(1) << HISTOGRAM_MAX_EXPONENT) - 1;
+    const unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(ns));
+    const uint64_t sub = (ns >> (exponent - HISTOGRAM_SUB_BITS)) & (sub_count - 1);
+    return static_cast<size_t>(((exponent - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS) + sub);
+}
+
+uint64_t HistogramSnapshot::bucket_lower(size_t index) {
+    constexpr size_t sub_count = size_t(1) << HISTOGRAM_SUB_BITS;
+    if (index < sub_count) return index;
+    const unsigned exponent = static_cast<unsigned>(index >> HISTOGRAM_SUB_BITS) + HISTOGRAM_SUB_BITS - 1;
+    return (sub_count + (index & (sub_count - 1))) << (exponent - HISTOGRAM_SUB_BITS);
+}
+
+uint64_t HistogramSnapshot::bucket_upper(size_t index) {
+    constexpr size_t sub_count = size_t(1) << HISTOGRAM_SUB_BITS;
+    if (index < sub_count) return index + 1;
+    const unsigned exponent = static_cast<unsigned>(index >> HISTOGRAM_SUB_BITS) + HISTOGRAM_SUB_BITS - 1;
+    return bucket_lower(index) + (uint64_t(1) << (exponent - HISTOGRAM_SUB_BITS));
+}
+
+uint64_t HistogramSnapshot::quantile_ns(double q) const {
+    if (count == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count));
+    if (rank >= count) rank = count - 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen > rank) {
+            const uint64_t upper = bucket_upper(i) - 1;
+            return upper < max_ns ? upper : max_ns;
+        }
+    }
+    return max_ns;
+}
+
+uint64_t HistogramSnapshot::count_at_most(uint64_t bound_ns) const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS && bucket_upper(i) - 1 <= bound_ns; ++i) {
+        total += counts[i];
+    }
+    return total;
+}
+
+void LatencyHistogram::merge_into(HistogramSnapshot& out) const {
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        out.counts[i] += counts_[i].load(std::memory_order_relaxed);
+    }
+    out.count += count_.load(std::memory_order_relaxed);
+    out.sum_ns += sum_ns_.load(std::memory_order_relaxed);
+    const uint64_t max = max_ns_.load(std::memory_order_relaxed);
+    if (max > out.max_ns) out.max_ns = max;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_ns_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+PipelineMetrics::~PipelineMetrics() {
+    stop_export();
+}
+
+PipelineMetrics::ThreadBlock& PipelineMetrics::add_block() {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    blocks_.push_back(std::make_unique<ThreadBlock>());
+    local_block_ = blocks_.back().get();
+    return *local_block_;
+}
+
+HistogramSnapshot PipelineMetrics::snapshot(LatencyStage stage) const {
+    HistogramSnapshot out;
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    for (const auto& block : blocks_) {
+        block->stages[static_cast<size_t>(stage)].merge_into(out);
+    }
+    return out;
+}
+
+uint64_t PipelineMetrics::counter(PipelineCounter counter) const {
+    uint64_t total = 0;
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    for (const auto& block : blocks_) {
+        total += block->counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void PipelineMetrics::reset() {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    for (auto& block : blocks_) {
+        for (auto& stage : block->stages) stage.reset();
+        for (auto& c : block->counters) c.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string PipelineMetrics::prometheus_text() const {
+    std::string out;
+    out.reserve(16384);
+
+    out += "# HELP pidrone_stage_latency_seconds Time spent per pipeline stage, see Metrics.h for the stages.\n";
+    out += "# TYPE pidrone_stage_latency_seconds histogram\n";
+    HistogramSnapshot snapshots[LATENCY_STAGE_COUNT];
+    for (size_t s = 0; s < LATENCY_STAGE_COUNT; ++s) {
+        snapshots[s] = snapshot(static_cast<LatencyStage>(s));
+        const HistogramSnapshot& h = snapshots[s];
+        for (double bound : EXPORT_BOUNDS_S) {
+            append(out, "pidrone_stage_latency_seconds_bucket{stage=\"%s\",le=\"%g\"} %llu\n", STAGE_NAMES[s], bound,
+                   static_cast<unsigned long long>(h.count_at_most(static_cast<uint64_t>(bound * 1e9))));
+        }
+        append(out, "pidrone_stage_latency_seconds_bucket{stage=\"%s\",le=\"+Inf\"} %llu\n", STAGE_NAMES[s],
+               static_cast<unsigned long long>(h.count));
+        append(out, "pidrone_stage_latency_seconds_sum{stage=\"%s\"} %.9f\n", STAGE_NAMES[s],
+               static_cast<double>(h.sum_ns) * 1e-9);
+        append(out, "pidrone_stage_latency_seconds_count{stage=\"%s\"} %llu\n", STAGE_NAMES[s],
+               static_cast<unsigned long long>(h.count));
+    }
+
+    // The fine grained histogram is too large to export, its quantiles are what a human looks at.
+    out += "# HELP pidrone_stage_latency_quantile_seconds Latency quantiles per stage, to within 6.25%.\n";
+    out += "# TYPE pidrone_stage_latency_quantile_seconds gauge\n";
+    for (size_t s = 0; s < LATENCY_STAGE_COUNT; ++s) {
+        for (double q : EXPORT_QUANTILES) {
+            append(out, "pidrone_stage_latency_quantile_seconds{stage=\"%s\",quantile=\"%g\"} %.9f\n", STAGE_NAMES[s], q,
+                   static_cast<double>(snapshots[s].quantile_ns(q)) * 1e-9);
+        }
+        append(out, "pidrone_stage_latency_quantile_seconds{stage=\"%s\",quantile=\"1\"} %.9f\n", STAGE_NAMES[s],
+               static_cast<double>(snapshots[s].max_ns) * 1e-9);
+    }
+
+    for (size_t c = 0; c < PIPELINE_COUNTER_COUNT; ++c) {
+        append(out, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n", COUNTER_INFO[c].name, COUNTER_INFO[c].help,
+               COUNTER_INFO[c].name, COUNTER_INFO[c].name,
+               static_cast<unsigned long long>(counter(static_cast<PipelineCounter>(c))));
+    }
+    for (const Series& series : series_) {
+        out += "# HELP " + series.name + " " + series.help + "\n";
+        out += "# TYPE " + series.name + " " + series.type + "\n";
+        append(out, "%s %.17g\n", series.name.c_str(), series.read());
+    }
+    return out;
+}
+
+void PipelineMetrics::start_export(const std::string& path, std::chrono::milliseconds interval) {
+    stop_export();
+    export_stop_ = false;
+    export_thread_ = std::thread([this, path, interval] {
+        const std::string temp = path + ".tmp";
+        auto write = [&] {
+            const std::string text = prometheus_text();
+            FILE* f = std::fopen(temp.c_str(), "w");
+            const bool ok = f && std::fwrite(text.data(), 1, text.size(), f) == text.size();
+            if (f && std::fclose(f) != 0) return false;
+            return ok && std::rename(temp.c_str(), path.c_str()) == 0;
+        };
+        bool warned = false;
+        std::unique_lock<std::mutex> lock(export_mutex_);
+        for (;;) {
+            const bool stop = export_cv_.wait_for(lock, interval, [this] { return export_stop_; });
+            if (!write() && !warned) {
+                std::cerr << "Cannot write metrics to " << path << std::endl;
+                warned = true;
+            }
+            if (stop) return;
+        }
+    });
+}
+
+void PipelineMetrics::stop_export() {
+    {
+        std::lock_guard<std::mutex> lock(export_mutex_);
+        export_stop_ = true;
+    }
+    export_cv_.notify_all();
+    if (export_thread_.joinable()) {
+        export_thread_.join();
+    }
+}
+
+PipelineMetrics& pipeline_metrics() {
+    static PipelineMetrics metrics;
+    return metrics;
+}
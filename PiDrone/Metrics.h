@@ -0,0 +1,234 @@
+/**
+    * @file Metrics.h
+    * @brief Per-stage latency histograms and pipeline counters, exported as Prometheus text.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Answers "how long from radar reading to position output, and where does
+    * the time go". Every message is timestamped on arrival (received_at, set
+    * by the IngestSource), on enqueue and dequeue in its NodeManager, after
+    * parsing and around the tracker update, and each interval is recorded in
+    * the histogram of its stage:
+    *
+    *   route       arrival to enqueue (transport callback, journal, topic lookup)
+    *   queue       waiting in the NodeManager queue for a worker
+    *   parse       payload format detection and decoding
+    *   update      tracker update that did not lead to a solve
+    *   solve       tracker update including the position solve
+    *   end_to_end  arrival to the fix being handed to process_drone_location
+    *
+    * Histograms are log-linear (HDR style): 16 sub-buckets per power of two,
+    * so any recorded value is known to within 6.25%, from 1 ns to about 18
+    * minutes, in a fixed 4.7 KB per stage. Each thread records into its own
+    * block of histograms and counters, with plain relaxed stores, no shared
+    * cache line and no lock. The exporter sums the blocks when it writes.
+    *
+    * Recording is off until enable(true). Counters then count every message.
+    * Timestamps cost a clock read each, five per message, so on a busy system
+    * only every Nth message can be timed (set_sample_every), the decision is
+    * made on enqueue and the message carries it through the later stages.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "IngestSource.h"
+
+enum class LatencyStage : uint8_t {
+    Route,
+    Queue,
+    Parse,
+    Update,
+    Solve,
+    EndToEnd,
+    Count
+};
+
+enum class PipelineCounter : uint8_t {
+    Messages,         // dequeued by a NodeManager
+    Readings,         // single readings, a batched frame carries several
+    ParseErrors,      // messages dropped because they could not be decoded
+    Unrouted,         // messages whose topic did not resolve to a sensor
+    RejectedReadings, // readings the RangeFilter kept from the tracker
+    Fixes,
+    FormatChanges,    // sensors whose payload format changed after their first message
+    Count
+};
+
+constexpr size_t LATENCY_STAGE_COUNT = static_cast<size_t>(LatencyStage::Count);
+constexpr size_t PIPELINE_COUNTER_COUNT = static_cast<size_t>(PipelineCounter::Count);
+
+constexpr unsigned HISTOGRAM_SUB_BITS = 4;
+constexpr unsigned HISTOGRAM_MAX_EXPONENT = 40; // 2^40 ns, about 18 minutes, larger values are clamped
+constexpr size_t HISTOGRAM_BUCKETS = (HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS;
+
+const char* latency_stage_name(LatencyStage stage);
+
+/**
+    * @struct HistogramSnapshot
+    * @brief Plain copy of one or more histograms, for quantiles and export.
+*/
+struct HistogramSnapshot {
+    std::array<uint64_t, HISTOGRAM_BUCKETS> counts{};
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+    uint64_t max_ns = 0;
+
+    // Upper bound of the bucket holding the q-quantile, 0 when empty.
+    uint64_t quantile_ns(double q) const;
+    // Recorded values at or below bound_ns, to within one bucket.
+    uint64_t count_at_most(uint64_t bound_ns) const;
+
+    static size_t bucket_of(uint64_t ns);
+    static uint64_t bucket_lower(size_t index);
+    static uint64_t bucket_upper(size_t index); // exclusive
+};
+
+/**
+    * @class LatencyHistogram
+    * @brief Single-writer log-linear histogram of nanosecond values.
+    *
+    * record() is a relaxed load and store per field, so only one thread may
+    * record into a histogram. Any thread may snapshot it at any time, the
+    * copy is consistent per bucket, not across buckets.
+*/
+class LatencyHistogram {
+    // --- Private var declaration to be used ---
+    private:
+        std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> counts_{};
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> sum_ns_{0};
+        std::atomic<uint64_t> max_ns_{0};
+
+    // --- Public method declarations ---
+    public:
+        void record(uint64_t ns) {
+            std::atomic<uint64_t>& bucket = counts_[HistogramSnapshot::bucket_of(ns)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            sum_ns_.store(sum_ns_.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+            if (ns > max_ns_.load(std::memory_order_relaxed)) max_ns_.store(ns, std::memory_order_relaxed);
+        }
+
+        // Adds this histogram into out.
+        void merge_into(HistogramSnapshot& out) const;
+        void reset();
+};
+
+/**
+    * @class PipelineMetrics
+    * @brief Process-wide latency histograms, counters and the Prometheus exporter.
+    *
+    * One instance, see pipeline_metrics(). Threads get their block on first
+    * use, blocks outlive their thread so nothing recorded is ever lost.
+*/
+class PipelineMetrics {
+    public:
+        // Extra series sampled at export time, e.g. queue depth or drops counted elsewhere.
+        struct Series {
+            std::string name;
+            std::string help;
+            std::string type; // "gauge" or "counter"
+            std::function<double()> read;
+        };
+
+    // --- Private var declaration to be used ---
+    private:
+        struct ThreadBlock {
+            std::array<LatencyHistogram, LATENCY_STAGE_COUNT> stages;
+            std::array<std::atomic<uint64_t>, PIPELINE_COUNTER_COUNT> counters{};
+            uint32_t sample_tick = 0;
+        };
+
+        std::atomic<bool> enabled_{false};
+        std::atomic<uint32_t> sample_every_{1};
+        mutable std::mutex blocks_mutex_;
+        std::vector<std::unique_ptr<ThreadBlock>> blocks_;
+        std::vector<Series> series_;
+
+        std::thread export_thread_;
+        std::mutex export_mutex_;
+        std::condition_variable export_cv_;
+        bool export_stop_ = false;
+
+        // Only pipeline_metrics() exists, so one block pointer per thread is enough.
+        static inline thread_local ThreadBlock* local_block_ = nullptr;
+
+        ThreadBlock& local() { return local_block_ ? *local_block_ : add_block(); }
+        ThreadBlock& add_block();
+
+    // --- Public method declarations ---
+    public:
+        PipelineMetrics() = default;
+        ~PipelineMetrics();
+
+        PipelineMetrics(const PipelineMetrics&) = delete;
+        PipelineMetrics& operator=(const PipelineMetrics&) = delete;
+
+        void enable(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+        bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+        // Time every nth message only, 1 times all of them.
+        void set_sample_every(uint32_t n) { sample_every_.store(n > 0 ? n : 1, std::memory_order_relaxed); }
+
+        /**
+            * @brief First timestamp of a message, on enqueue.
+            *
+            * now() if the message is to be timed, a default time point otherwise, in
+            * which case the later stages skip their clock reads too (see record()).
+        */
+        IngestClock::time_point start_sample() {
+            if (!enabled()) return {};
+            ThreadBlock& block = local();
+            if (++block.sample_tick < sample_every_.load(std::memory_order_relaxed)) return {};
+            block.sample_tick = 0;
+            return IngestClock::now();
+        }
+
+        void record(LatencyStage stage, IngestClock::time_point from, IngestClock::time_point to) {
+            if (!enabled() || from == IngestClock::time_point{} || to == IngestClock::time_point{}) return;
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+            local().stages[static_cast<size_t>(stage)].record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+        }
+
+        void add(PipelineCounter counter, uint64_t n = 1) {
+            if (!enabled()) return;
+            std::atomic<uint64_t>& c = local().counters[static_cast<size_t>(counter)];
+            c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        // Register before start_export(), not thread-safe against a running exporter.
+        void add_series(Series series) { series_.push_back(std::move(series)); }
+
+        HistogramSnapshot snapshot(LatencyStage stage) const;
+        uint64_t counter(PipelineCounter counter) const;
+        // Zeroes every histogram and counter, approximate if threads are recording meanwhile.
+        void reset();
+
+        // The whole set in the Prometheus text exposition format.
+        std::string prometheus_text() const;
+
+        /**
+            * @brief Rewrites path with prometheus_text() every interval from a background thread.
+            *
+            * The file is written next to path and renamed over it, so a scraper
+            * (node_exporter's textfile collector, a cron job) never reads half a file.
+        */
+        void start_export(const std::string& path, std::chrono::milliseconds interval);
+        // Writes a last time and stops the exporter.
+        void stop_export();
+};
+
+PipelineMetrics& pipeline_metrics();
@@ -0,0 +1,129 @@
+/**
+    * @file MpscRing.h
+    * @brief Bounded lock-free multi-producer/single-consumer ring buffer.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Every slot carries a sequence number that says whose turn it is, the
+    * layout of Vyukov's bounded queue. Producers claim a slot with one CAS on
+    * the shared tail and then write into it without touching anything another
+    * producer is using. The consumer is a single thread and keeps its head in a
+    * plain variable, it only publishes progress through the slot sequences.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include "SpscRing.h"
+
+/**
+    * @class MpscRing
+    * @brief Fixed-capacity FIFO for any number of producer threads and one consumer thread.
+    *
+    * The capacity is rounded up to a power of two. T must be default constructible,
+    * slots are reused in place. Elements are handed out in the order their slots
+    * were claimed, a producer that stalls between claiming and publishing holds
+    * up the consumer (not the other producers) until it is done.
+*/
+template <typename T>
+class MpscRing {
+    // --- Private var declaration to be used ---
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence{0};
+            T value{};
+        };
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+        alignas(CACHE_LINE_SIZE) size_t head_ = 0;
+        const size_t capacity_;
+        const size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+
+        static size_t round_up_pow2(size_t n) {
+            size_t p = 1;
+            while (p < n) p <<= 1;
+            return p;
+        }
+
+    // --- Public method declarations ---
+    public:
+        explicit MpscRing(size_t capacity)
+            : capacity_(round_up_pow2(capacity < 2 ? 2 : capacity)),
+              mask_(capacity_ - 1),
+              slots_(new Slot[capacity_]) {
+            for (size_t i = 0; i < capacity_; ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRing(const MpscRing&) = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+
+        /**
+            * @brief Producer side. Claims a slot, lets fill(T&) write it in place, then publishes it.
+            *
+            * fill must not throw. The slot still holds whatever the last element
+            * left in it, fill is expected to overwrite every field it cares about.
+            *
+            * @return false, without calling fill, if the ring is full.
+        */
+        template <typename Fill>
+        bool try_emplace(Fill&& fill) {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            Slot* slot;
+            for (;;) {
+                slot = &slots_[tail & mask_];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - tail);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    tail = tail_.load(std::memory_order_relaxed);
+                }
+            }
+            fill(slot->value);
+            slot->sequence.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(T&& value) {
+            return try_emplace([&](T& slot) { slot = std::move(value); });
+        }
+
+        /**
+            * @brief Consumer side. Hands every published element to fn, oldest first.
+            *
+            * fn receives a T& it may move from. Stops at the first slot that has been
+            * claimed but not yet published.
+            *
+            * @return Number of elements consumed.
+        */
+        template <typename Fn>
+        size_t drain(Fn&& fn, size_t max_items = std::numeric_limits<size_t>::max()) {
+            size_t count = 0;
+            while (count < max_items) {
+                Slot& slot = slots_[head_ & mask_];
+                if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) break;
+                fn(slot.value);
+                slot.sequence.store(head_ + capacity_, std::memory_order_release);
+                ++head_;
+                ++count;
+            }
+            return count;
+        }
+
+        // Consumer side only.
+        bool empty() const {
+            return slots_[head_ & mask_].sequence.load(std::memory_order_acquire) != head_ + 1;
+        }
+
+        size_t capacity() const { return capacity_; }
+};
@@ -0,0 +1,346 @@
+/**
+    * @file MultiTargetTracker.cpp
+    * @brief Gated global nearest neighbour association and track lifecycle.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "MultiTargetTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+// --- End Imports ---
+
+namespace {
+
+// Cost of a pair that is not allowed, large but finite so the solver's sums stay finite.
+const double FORBIDDEN = 1e12;
+
+double seconds_between(IngestClock::time_point from, IngestClock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+}
+
+MultiTargetTracker::MultiTargetTracker(MultiTargetConfig config, EventHandler on_event)
+    : config_(config), on_event_(std::move(on_event)), next_id_(config.first_id), grid_(config.max_gate_distance) {
+    if (config_.max_gate_distance <= 0.0) {
+        throw std::runtime_error("MultiTargetTracker max_gate_distance must be positive");
+    }
+}
+
+MultiTargetTracker::~MultiTargetTracker() {
+    stop_scans();
+}
+
+void MultiTargetTracker::add_fix(const Fix& fix) {
+    const double sigma = std::max(config_.min_measurement_sigma, fix.residual_rms);
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_.push_back({fix.position, sigma * sigma});
+}
+
+bool MultiTargetTracker::hand_over(const Point& position, MultiTargetTracker& to) {
+    std::scoped_lock lock(scan_mutex_, to.scan_mutex_);
+    auto nearest = [&position](const std::vector<Track>& tracks, double limit) {
+        size_t best = tracks.size();
+        double best_d2 = limit * limit;
+        for (size_t i = 0; i < tracks.size(); ++i) {
+            const Point p = tracks[i].filter.position();
+            const double d2 = (p.x - position.x) * (p.x - position.x) + (p.y - position.y) * (p.y - position.y);
+            if (d2 <= best_d2) {
+                best = i;
+                best_d2 = d2;
+            }
+        }
+        return best;
+    };
+    const size_t index = nearest(tracks_, config_.max_gate_distance);
+    if (index == tracks_.size() || nearest(to.tracks_, to.config_.max_gate_distance) != to.tracks_.size()
+        || to.tracks_.size() >= to.config_.max_tracks) {
+        return false;
+    }
+    // The next scan of either tracker picks the change up, both snapshots lag until then.
+    to.tracks_.push_back(tracks_[index]);
+    tracks_.erase(tracks_.begin() + static_cast<std::ptrdiff_t>(index));
+    return true;
+}
+
+uint32_t MultiTargetTracker::find(uint32_t node) {
+    while (parent_[node] != node) {
+        parent_[node] = parent_[parent_[node]];
+        node = parent_[node];
+    }
+    return node;
+}
+
+TargetState MultiTargetTracker::state_of(const Track& track) const {
+    TargetState state;
+    state.id = track.id;
+    state.status = track.status;
+    state.position = track.filter.position();
+    state.velocity = track.filter.velocity();
+    const auto& p = track.filter.covariance();
+    state.position_sigma = std::sqrt(0.5 * (p.m[KinematicKalman<2>::X][KinematicKalman<2>::X]
+                                          + p.m[KinematicKalman<2>::Y][KinematicKalman<2>::Y]));
+    state.hits = track.hits;
+    state.last_update = track.last_update;
+    return state;
+}
+
+/**
+    * @brief One association and maintenance pass.
+    *
+    * Steps: predict every track to now, index the predicted positions in the
+    * grid, collect gated (track, fix) candidates from the 3 x 3 cells around
+    * each fix, assign, then update, confirm, delete and give birth to tracks.
+*/
+void MultiTargetTracker::process_scan(IngestClock::time_point now) {
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        scan_fixes_.swap(pending_);
+        pending_.clear();
+    }
+
+    std::lock_guard<std::mutex> scan_lock(scan_mutex_);
+
+    for (Track& track : tracks_) {
+        const double dt = seconds_between(track.predicted_to, now);
+        if (dt > 0.0) {
+            track.filter.predict(dt, config_.process_noise);
+            track.predicted_to = now;
+        }
+    }
+
+    grid_.rebuild(tracks_.size(), [this](size_t i) { return tracks_[i].filter.position(); });
+
+    const double max_distance2 = config_.max_gate_distance * config_.max_gate_distance;
+    candidates_.clear();
+    for (uint32_t f = 0; f < scan_fixes_.size(); ++f) {
+        const PendingFix& fix = scan_fixes_[f];
+        grid_.for_each_near(fix.position, [&](uint32_t t) {
+            const Point predicted = tracks_[t].filter.position();
+            const double dx = fix.position.x - predicted.x;
+            const double dy = fix.position.y - predicted.y;
+            if (dx * dx + dy * dy > max_distance2) return;
+            double log_det = 0.0;
+            const double d2 = tracks_[t].filter.innovation_distance(fix.position, fix.variance, &log_det);
+            if (d2 <= config_.gate_chi2) {
+                candidates_.push_back({t, f, d2 + log_det, log_det});
+            }
+        });
+    }
+
+    associate();
+
+    // Update and maintain the existing tracks.
+    for (uint32_t t = 0; t < tracks_.size(); ++t) {
+        Track& track = tracks_[t];
+        ++track.age;
+        if (track_fix_[t] >= 0) {
+            const PendingFix& fix = scan_fixes_[track_fix_[t]];
+            track.filter.update(fix.position, fix.variance);
+            track.last_update = now;
+            ++track.hits;
+            track.misses = 0;
+        } else {
+            ++track.misses;
+        }
+
+        if (track.status == TrackStatus::Tentative) {
+            if (track.hits >= config_.confirm_hits) {
+                track.status = TrackStatus::Confirmed;
+                if (on_event_) on_event_(state_of(track));
+            } else if (track.age >= config_.confirm_window) {
+                track.status = TrackStatus::Deleted;
+            }
+        } else if (track.misses >= config_.max_misses || seconds_between(track.last_update, now) > config_.max_coast_s) {
+            track.status = TrackStatus::Deleted;
+            if (on_event_) on_event_(state_of(track));
+        }
+    }
+    tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(),
+                                 [](const Track& track) { return track.status == TrackStatus::Deleted; }),
+                  tracks_.end());
+
+    // Every fix outside all gates may be a new target.
+    const double motion_var = config_.initial_motion_sigma * config_.initial_motion_sigma;
+    for (uint32_t f = 0; f < scan_fixes_.size() && tracks_.size() < config_.max_tracks; ++f) {
+        if (fix_gated_[f]) continue;
+        Track track{};
+        track.id = next_id_;
+        next_id_ += config_.id_stride;
+        track.status = TrackStatus::Tentative;
+        track.filter.reset(scan_fixes_[f].position, scan_fixes_[f].variance, motion_var);
+        track.predicted_to = now;
+        track.last_update = now;
+        track.hits = 1;
+        track.age = 1;
+        if (track.hits >= config_.confirm_hits) {
+            track.status = TrackStatus::Confirmed;
+            if (on_event_) on_event_(state_of(track));
+        }
+        tracks_.push_back(track);
+    }
+
+    std::vector<TargetState> snapshot;
+    snapshot.reserve(tracks_.size());
+    for (const Track& track : tracks_) {
+        snapshot.push_back(state_of(track));
+    }
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    snapshot_.swap(snapshot);
+}
+
+/**
+    * @brief Assigns fixes to tracks, confirmed tracks first.
+    *
+    * A tentative track starts with a large covariance and would often win a
+    * fix from the confirmed track it duplicates, so tentative tracks only
+    * compete for the fixes no confirmed track took.
+*/
+void MultiTargetTracker::associate() {
+    track_fix_.assign(tracks_.size(), -1);
+    fix_gated_.assign(scan_fixes_.size(), 0);
+    fix_taken_.assign(scan_fixes_.size(), 0);
+    if (candidates_.empty()) return;
+
+    // A fix inside any track's gate never starts a track of its own, even if
+    // it loses the assignment, or every noisy fix would seed a duplicate.
+    for (const Candidate& c : candidates_) fix_gated_[c.fix] = 1;
+
+    auto tentative_begin = std::stable_partition(candidates_.begin(), candidates_.end(), [this](const Candidate& c) {
+        return tracks_[c.track].status == TrackStatus::Confirmed;
+    });
+    const size_t split = static_cast<size_t>(tentative_begin - candidates_.begin());
+    assign_candidates(0, split);
+
+    auto tentative_end = std::remove_if(candidates_.begin() + split, candidates_.end(),
+                                        [this](const Candidate& c) { return fix_taken_[c.fix] != 0; });
+    assign_candidates(split, static_cast<size_t>(tentative_end - candidates_.begin()));
+}
+
+/**
+    * @brief Splits a range of candidate pairs into independent clusters and assigns each.
+    *
+    * Tracks and fixes are nodes of a graph whose edges are the gated pairs. Only
+    * nodes of the same connected component compete with each other, so the
+    * Hungarian algorithm runs per component and a lone pair is taken directly.
+*/
+void MultiTargetTracker::assign_candidates(size_t first, size_t last) {
+    if (first == last) return;
+    const uint32_t track_count = static_cast<uint32_t>(tracks_.size());
+
+    parent_.resize(track_count + scan_fixes_.size());
+    for (uint32_t i = 0; i < parent_.size(); ++i) parent_[i] = i;
+    for (size_t i = first; i < last; ++i) {
+        const uint32_t a = find(candidates_[i].track);
+        const uint32_t b = find(track_count + candidates_[i].fix);
+        if (a != b) parent_[a] = b;
+    }
+    // Flatten so parent_ holds the root, the root of any member identifies its component.
+    for (uint32_t i = 0; i < parent_.size(); ++i) parent_[i] = find(i);
+    std::sort(candidates_.begin() + first, candidates_.begin() + last, [this](const Candidate& a, const Candidate& b) {
+        return parent_[a.track] < parent_[b.track];
+    });
+
+    size_t begin = first;
+    while (begin < last) {
+        size_t end = begin + 1;
+        while (end < last && parent_[candidates_[end].track] == parent_[candidates_[begin].track]) ++end;
+
+        if (end - begin == 1) {
+            const Candidate& c = candidates_[begin];
+            track_fix_[c.track] = static_cast<int32_t>(c.fix);
+            fix_taken_[c.fix] = 1;
+        } else {
+            cluster_tracks_.clear();
+            cluster_fixes_.clear();
+            for (size_t i = begin; i < end; ++i) {
+                cluster_tracks_.push_back(candidates_[i].track);
+                cluster_fixes_.push_back(candidates_[i].fix);
+            }
+            std::sort(cluster_tracks_.begin(), cluster_tracks_.end());
+            cluster_tracks_.erase(std::unique(cluster_tracks_.begin(), cluster_tracks_.end()), cluster_tracks_.end());
+            std::sort(cluster_fixes_.begin(), cluster_fixes_.end());
+            cluster_fixes_.erase(std::unique(cluster_fixes_.begin(), cluster_fixes_.end()), cluster_fixes_.end());
+
+            assign_cluster(begin, end);
+        }
+        begin = end;
+    }
+}
+
+/**
+    * @brief Optimal assignment of one cluster of competing tracks and fixes.
+    *
+    * One row per track, one column per fix plus one "missed" column per track.
+    * A track may take a gated fix at d^2 + ln |S| or its own missed column at
+    * the gate plus the same ln |S|, so any gated fix is at least as good as a
+    * miss. Fixes nobody takes cost nothing.
+*/
+void MultiTargetTracker::assign_cluster(size_t begin, size_t end) {
+    const size_t nt = cluster_tracks_.size();
+    const size_t nf = cluster_fixes_.size();
+    const size_t cols = nf + nt;
+    cost_.assign(nt * cols, FORBIDDEN);
+
+    auto local = [](const std::vector<uint32_t>& ids, uint32_t id) {
+        return static_cast<size_t>(std::lower_bound(ids.begin(), ids.end(), id) - ids.begin());
+    };
+    for (size_t i = begin; i < end; ++i) {
+        const Candidate& c = candidates_[i];
+        const size_t row = local(cluster_tracks_, c.track);
+        cost_[row * cols + local(cluster_fixes_, c.fix)] = c.cost;
+        cost_[row * cols + nf + row] = config_.gate_chi2 + c.log_det;
+    }
+
+    solver_.solve(cost_, nt, cols, assignment_);
+    for (size_t t = 0; t < nt; ++t) {
+        const size_t col = assignment_[t];
+        if (col < nf && cost_[t * cols + col] < FORBIDDEN) {
+            track_fix_[cluster_tracks_[t]] = static_cast<int32_t>(cluster_fixes_[col]);
+            fix_taken_[cluster_fixes_[col]] = 1;
+        }
+    }
+}
+
+std::vector<TargetState> MultiTargetTracker::tracks() const {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    return snapshot_;
+}
+
+void MultiTargetTracker::start_scans(double rate_hz) {
+    if (rate_hz <= 0.0) {
+        throw std::runtime_error("MultiTargetTracker scan rate must be positive");
+    }
+    stop_scans();
+    scan_stop_ = false;
+
+    const auto period = std::chrono::duration_cast<IngestClock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+    scan_thread_ = std::thread([this, period] {
+        auto next = IngestClock::now();
+        std::unique_lock<std::mutex> lock(scan_thread_mutex_);
+        while (true) {
+            next += period;
+            if (scan_cv_.wait_until(lock, next, [this] { return scan_stop_; })) {
+                return;
+            }
+            lock.unlock();
+            process_scan(next);
+            lock.lock();
+            next = std::max(next, IngestClock::now() - period);
+        }
+    });
+}
+
+void MultiTargetTracker::stop_scans() {
+    {
+        std::lock_guard<std::mutex> lock(scan_thread_mutex_);
+        scan_stop_ = true;
+    }
+    scan_cv_.notify_all();
+    if (scan_thread_.joinable()) {
+        scan_thread_.join();
+    }
+}
@@ -0,0 +1,173 @@
+/**
+    * @file MultiTargetTracker.h
+    * @brief Maintains any number of target tracks from a stream of position fixes.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Fixes are buffered by add_fix() from any thread and associated to tracks
+    * once per scan. A scan predicts every track to the scan time, finds the
+    * candidate tracks of each fix through a SpatialGrid, keeps the pairs inside
+    * the Mahalanobis gate and solves the global nearest neighbour assignment,
+    * first for confirmed tracks and then for tentative ones,
+    * on the negative log-likelihood of each pair, with the Hungarian algorithm, one cluster of competing tracks and fixes at
+    * a time. Fixes left over start tentative tracks, which are confirmed after
+    * M hits in their first N scans. Tracks that keep missing are deleted.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Assignment.h"
+#include "IngestSource.h"
+#include "KalmanFilter.h"
+#include "Multilateration.h"
+#include "SpatialGrid.h"
+
+enum class TrackStatus {
+    Tentative,
+    Confirmed,
+    Deleted
+};
+
+struct MultiTargetConfig {
+    // Same meaning as in TrackFilterConfig, every track runs a constant-velocity filter.
+    double process_noise = 2.0;
+    double min_measurement_sigma = 0.25;
+    double initial_motion_sigma = 10.0;
+    // Squared Mahalanobis gate, 9.21 keeps 99% of true fixes with 2 degrees of freedom.
+    double gate_chi2 = 9.21;
+    // Hard Euclidean limit on a fix-track distance, also the grid cell size.
+    double max_gate_distance = 5.0;
+    // A tentative track is confirmed with confirm_hits hits within its first confirm_window scans.
+    uint32_t confirm_hits = 3;
+    uint32_t confirm_window = 5;
+    // A confirmed track is deleted after this many scans in a row without a fix...
+    uint32_t max_misses = 10;
+    // ...or when its last fix is older than this.
+    double max_coast_s = 2.0;
+    size_t max_tracks = 1024;
+    // Track ids are first_id, first_id + id_stride, ..., so trackers of different zones never share one.
+    uint32_t first_id = 1;
+    uint32_t id_stride = 1;
+};
+
+/**
+    * @struct TargetState
+    * @brief Public view of one track after a scan.
+*/
+struct TargetState {
+    uint32_t id = 0;
+    TrackStatus status = TrackStatus::Tentative;
+    Point position;
+    Point velocity;
+    double position_sigma = 0.0;
+    uint32_t hits = 0;
+    IngestClock::time_point last_update;
+};
+
+class MultiTargetTracker {
+    public:
+        // Called from the scan for every track that was confirmed or deleted.
+        using EventHandler = std::function<void(const TargetState&)>;
+
+    // --- Private var declaration to be used ---
+    private:
+        struct Track {
+            uint32_t id;
+            TrackStatus status;
+            KinematicKalman<2> filter;
+            IngestClock::time_point predicted_to;
+            IngestClock::time_point last_update;
+            uint32_t hits;
+            uint32_t misses;    // consecutive
+            uint32_t age;       // scans since birth
+        };
+
+        struct PendingFix {
+            Point position;
+            double variance;
+        };
+
+        struct Candidate {
+            uint32_t track;
+            uint32_t fix;
+            // d^2 + ln |S|, so a confident track beats an uncertain one at the same d^2.
+            double cost;
+            double log_det;
+        };
+
+        MultiTargetConfig config_;
+        EventHandler on_event_;
+
+        std::mutex pending_mutex_;
+        std::vector<PendingFix> pending_;
+
+        // Scan state, only touched by process_scan().
+        std::mutex scan_mutex_;
+        std::vector<Track> tracks_;
+        uint32_t next_id_;
+        std::vector<PendingFix> scan_fixes_;
+        SpatialGrid grid_;
+        std::vector<Candidate> candidates_;
+        std::vector<uint32_t> parent_;
+        std::vector<int32_t> track_fix_;
+        std::vector<uint8_t> fix_gated_;
+        std::vector<uint8_t> fix_taken_;
+        std::vector<uint32_t> cluster_tracks_;
+        std::vector<uint32_t> cluster_fixes_;
+        std::vector<double> cost_;
+        std::vector<size_t> assignment_;
+        AssignmentSolver solver_;
+
+        mutable std::mutex snapshot_mutex_;
+        std::vector<TargetState> snapshot_;
+
+        std::thread scan_thread_;
+        std::mutex scan_thread_mutex_;
+        std::condition_variable scan_cv_;
+        bool scan_stop_ = false;
+
+        uint32_t find(uint32_t node);
+        void associate();
+        void assign_candidates(size_t first, size_t last);
+        void assign_cluster(size_t begin, size_t end);
+        TargetState state_of(const Track& track) const;
+
+    // --- Public method declarations ---
+    public:
+        explicit MultiTargetTracker(MultiTargetConfig config = {}, EventHandler on_event = {});
+        ~MultiTargetTracker();
+
+        MultiTargetTracker(const MultiTargetTracker&) = delete;
+        MultiTargetTracker& operator=(const MultiTargetTracker&) = delete;
+
+        // Queues a fix for the next scan. Thread-safe and cheap, callable from any executor worker.
+        void add_fix(const Fix& fix);
+
+        // Associates every fix queued since the last scan, all of them taken as measured at now.
+        void process_scan(IngestClock::time_point now);
+
+        // Runs process_scan() rate_hz times per second on a thread of its own until stop_scans().
+        void start_scans(double rate_hz);
+        void stop_scans();
+
+        /**
+            * @brief Moves the track nearest position into another tracker, for a target crossing into a neighbouring zone.
+            *
+            * Only a track within max_gate_distance of position moves, and only if
+            * `to` has none there yet. It keeps its id, status and filter state.
+            * Returns whether one moved. Thread-safe, never call it with to == this.
+        */
+        bool hand_over(const Point& position, MultiTargetTracker& to);
+
+        // Live tracks as of the last scan.
+        std::vector<TargetState> tracks() const;
+        const MultiTargetConfig& config() const { return config_; }
+};
@@ -0,0 +1,174 @@
+/**
+    * @file Multilateration.cpp
+    * @brief Cached least-squares multilateration for N >= 3 sensors.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "Multilateration.h"
+#include <algorithm>
+#include <cmath>
+// --- End Imports ---
+
+SubsetSolver::SubsetSolver(uint64_t mask, const std::vector<Point>& positions_by_slot)
+    : mask_(mask) {
+    for (size_t slot = 0; slot < positions_by_slot.size() && slot < MAX_SENSORS; ++slot) {
+        if (mask & (uint64_t(1) << slot)) {
+            slots_.push_back(static_cast<uint8_t>(slot));
+            positions_.push_back(positions_by_slot[slot]);
+        }
+    }
+
+    const size_t n = positions_.size();
+    if (n < 3) return;
+
+    // Rows of A are 2 (si - s0), accumulate the 2x2 normal matrix A^T A.
+    const Point& s0 = positions_[0];
+    std::vector<double> ax(n - 1), ay(n - 1);
+    double n11 = 0.0, n12 = 0.0, n22 = 0.0;
+    for (size_t i = 1; i < n; ++i) {
+        ax[i - 1] = 2.0 * (positions_[i].x - s0.x);
+        ay[i - 1] = 2.0 * (positions_[i].y - s0.y);
+        n11 += ax[i - 1] * ax[i - 1];
+        n12 += ax[i - 1] * ay[i - 1];
+        n22 += ay[i - 1] * ay[i - 1];
+        k_.push_back(positions_[i].x * positions_[i].x - s0.x * s0.x
+                     + positions_[i].y * positions_[i].y - s0.y * s0.y);
+    }
+
+    // Eigenvalues of the symmetric 2x2 normal matrix give cond(A) = sqrt(lmax / lmin).
+    const double trace = n11 + n22;
+    const double det = n11 * n22 - n12 * n12;
+    const double disc = std::sqrt(std::max(0.0, trace * trace / 4.0 - det));
+    const double lmax = trace / 2.0 + disc;
+    const double lmin = trace / 2.0 - disc;
+    if (lmin <= 0.0 || lmax / lmin > MAX_CONDITION * MAX_CONDITION) {
+        return;
+    }
+    condition_number_ = std::sqrt(lmax / lmin);
+
+    // M = (A^T A)^-1 A^T
+    const double i11 = n22 / det, i12 = -n12 / det, i22 = n11 / det;
+    m_x_.resize(n - 1);
+    m_y_.resize(n - 1);
+    for (size_t i = 0; i < n - 1; ++i) {
+        m_x_[i] = i11 * ax[i] + i12 * ay[i];
+        m_y_[i] = i12 * ax[i] + i22 * ay[i];
+    }
+    valid_ = true;
+}
+
+std::optional<Fix> SubsetSolver::solve(const double* ranges_by_slot) const {
+    if (!valid_) {
+        return std::nullopt;
+    }
+
+    const size_t n = slots_.size();
+    const double d0 = ranges_by_slot[slots_[0]];
+    const double d0_sq = d0 * d0;
+
+    Fix fix;
+    for (size_t i = 1; i < n; ++i) {
+        const double di = ranges_by_slot[slots_[i]];
+        const double b = d0_sq - di * di + k_[i - 1];
+        fix.position.x += m_x_[i - 1] * b;
+        fix.position.y += m_y_[i - 1] * b;
+    }
+
+    double sum_sq = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double dx = fix.position.x - positions_[i].x;
+        const double dy = fix.position.y - positions_[i].y;
+        const double err = std::sqrt(dx * dx + dy * dy) - ranges_by_slot[slots_[i]];
+        sum_sq += err * err;
+    }
+
+    fix.residual_rms = std::sqrt(sum_sq / static_cast<double>(n));
+    fix.condition_number = condition_number_;
+    fix.sensor_mask = mask_;
+    fix.sensors_used = n;
+    return fix;
+}
+
+MultilaterationEngine::MultilaterationEngine(std::vector<Point> positions_by_slot)
+    : positions_(std::move(positions_by_slot)), cache_(new std::atomic<SubsetSolver*>[CACHE_SLOTS]),
+      evicted_(new std::atomic<SubsetSolver*>[EVICTED_SLOTS]) {
+    for (size_t i = 0; i < CACHE_SLOTS; ++i) {
+        cache_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < EVICTED_SLOTS; ++i) {
+        evicted_[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    // The full set is what a healthy site solves with, have it ready up front.
+    if (positions_.size() >= 3) {
+        uint64_t all = positions_.size() >= 64 ? ~uint64_t(0) : (uint64_t(1) << positions_.size()) - 1;
+        solver(all);
+    }
+}
+
+MultilaterationEngine::~MultilaterationEngine() {
+    for (size_t i = 0; i < CACHE_SLOTS; ++i) {
+        delete cache_[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < EVICTED_SLOTS; ++i) {
+        delete evicted_[i].load(std::memory_order_relaxed);
+    }
+}
+
+const SubsetSolver* MultilaterationEngine::solver(uint64_t mask) {
+    // Fibonacci hashing spreads neighbouring masks across the table.
+    const uint64_t hash = mask * 0x9E3779B97F4A7C15ULL;
+    const size_t home = static_cast<size_t>(hash >> 54) & (CACHE_SLOTS - 1);
+
+    SubsetSolver* built = nullptr;
+    for (size_t probe = 0; probe < CACHE_PROBES; ++probe) {
+        std::atomic<SubsetSolver*>& slot = cache_[(home + probe) & (CACHE_SLOTS - 1)];
+        SubsetSolver* entry = slot.load(std::memory_order_acquire);
+        if (entry == nullptr) {
+            if (!built) built = new SubsetSolver(mask, positions_);
+            if (slot.compare_exchange_strong(entry, built, std::memory_order_acq_rel)) {
+                return built;
+            }
+            // Someone else filled this slot, entry now holds what they stored.
+        }
+        // Slots never go back to empty and evicted solvers stay alive, so entry is safe to read.
+        if (entry->mask() == mask) {
+            delete built;
+            return entry;
+        }
+    }
+
+    // Window full, replace the solver other bits of the hash pick if there is room to park it.
+    if (evicted_count_.load(std::memory_order_relaxed) >= EVICTED_SLOTS) {
+        delete built;
+        return nullptr;
+    }
+    const size_t parked = evicted_count_.fetch_add(1, std::memory_order_relaxed);
+    if (parked >= EVICTED_SLOTS) {
+        delete built;
+        return nullptr;
+    }
+    if (!built) built = new SubsetSolver(mask, positions_);
+    const size_t victim = (home + static_cast<size_t>(hash >> 32) % CACHE_PROBES) & (CACHE_SLOTS - 1);
+    evicted_[parked].store(cache_[victim].exchange(built, std::memory_order_acq_rel), std::memory_order_relaxed);
+    return built;
+}
+
+std::vector<uint64_t> MultilaterationEngine::cached_masks() const {
+    std::vector<uint64_t> masks;
+    for (size_t i = 0; i < CACHE_SLOTS; ++i) {
+        if (const SubsetSolver* entry = cache_[i].load(std::memory_order_acquire)) {
+            masks.push_back(entry->mask());
+        }
+    }
+    return masks;
+}
+
+std::optional<Fix> MultilaterationEngine::solve(uint64_t mask, const double* ranges_by_slot) {
+    if (const SubsetSolver* cached = solver(mask)) {
+        return cached->solve(ranges_by_slot);
+    }
+    return SubsetSolver(mask, positions_).solve(ranges_by_slot);
+}
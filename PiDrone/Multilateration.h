@@ -0,0 +1,133 @@
+/**
+    * @file Multilateration.h
+    * @brief Least-squares position solver for any subset of three or more sensors.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Subtracting the range equation of a reference sensor s0 from every other
+    * sensor si linearizes the problem into
+    *
+    *     2 (si - s0) . p = d0^2 - di^2 + |si|^2 - |s0|^2,    i.e.  A p = b
+    *
+    * Sensor positions are fixed, so A, and therefore the least-squares operator
+    * M = (A^T A)^-1 A^T, only depend on which sensors take part. M is computed
+    * once per sensor subset and cached, after which a fix costs building b and
+    * one 2 x (n-1) matrix-vector product.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "SensorModel.h"
+
+/**
+    * @struct Fix
+    * @brief One position solution together with its quality indicators.
+*/
+struct Fix {
+    Point position;
+    double residual_rms = 0.0;      // RMS of |p - si| - di over the sensors used, in meters
+    double condition_number = 0.0;  // of the linearized geometry matrix A, large means poor geometry
+    uint64_t sensor_mask = 0;       // tracker slots that took part
+    size_t sensors_used = 0;
+    uint16_t zone = 0;              // zone whose area the position is in, see ZonedTracker
+    uint16_t source_zone = 0;       // zone whose sensors solved it
+    double dop = 0.0;               // expected position error per meter of range noise, 0 if unknown
+};
+
+/**
+    * @class SubsetSolver
+    * @brief Precomputed least-squares operator for one fixed set of sensors.
+*/
+class SubsetSolver {
+    public:
+        static constexpr size_t MAX_SENSORS = 64;
+        // Subsets whose A^T A is worse conditioned than this are treated as degenerate.
+        static constexpr double MAX_CONDITION = 1e8;
+
+    // --- Private var declaration to be used ---
+    private:
+        uint64_t mask_;
+        std::vector<uint8_t> slots_;
+        std::vector<Point> positions_;
+        // Row-major 2 x (n-1) operator, and the constant part of b.
+        std::vector<double> m_x_;
+        std::vector<double> m_y_;
+        std::vector<double> k_;
+        double condition_number_ = 0.0;
+        bool valid_ = false;
+
+    // --- Public method declarations ---
+    public:
+        SubsetSolver(uint64_t mask, const std::vector<Point>& positions_by_slot);
+
+        /**
+            * @param ranges_by_slot Latest range of every tracker slot, only the slots in mask are read
+        */
+        std::optional<Fix> solve(const double* ranges_by_slot) const;
+
+        uint64_t mask() const { return mask_; }
+        bool valid() const { return valid_; }
+        double condition_number() const { return condition_number_; }
+        const std::vector<uint8_t>& slots() const { return slots_; }
+        const std::vector<Point>& positions() const { return positions_; }
+
+        // Coefficients of the cached operator, for kernels that evaluate it in bulk.
+        const std::vector<double>& operator_x() const { return m_x_; }
+        const std::vector<double>& operator_y() const { return m_y_; }
+        const std::vector<double>& offsets() const { return k_; }
+};
+
+/**
+    * @class MultilaterationEngine
+    * @brief Owns the sensor geometry and a lock-free cache of SubsetSolvers keyed by subset mask.
+    *
+    * solver() may be called concurrently from any thread. A miss builds the
+    * solver and publishes it with a CAS, losing racers discard their copy.
+    * A mask is looked up in at most CACHE_PROBES slots from its hash. A miss
+    * on a full window replaces one of the window's solvers. Readers may still
+    * be using the replaced one, so it is parked rather than freed and goes
+    * with the engine, which DroneTracker frees only once no update can hold
+    * it. At most EVICTED_SLOTS solvers are parked. After that a miss on a
+    * full window solves with a temporary solver until the next reload
+    * replaces the engine.
+*/
+class MultilaterationEngine {
+    public:
+        static constexpr size_t CACHE_SLOTS = 1024;
+        static constexpr size_t CACHE_PROBES = 8;
+        static constexpr size_t EVICTED_SLOTS = 1024;
+
+    // --- Private var declaration to be used ---
+    private:
+        std::vector<Point> positions_;
+        std::unique_ptr<std::atomic<SubsetSolver*>[]> cache_;
+        // Solvers evicted from cache_, freed with the engine. evicted_count_ may run past EVICTED_SLOTS.
+        std::unique_ptr<std::atomic<SubsetSolver*>[]> evicted_;
+        std::atomic<size_t> evicted_count_{0};
+
+    // --- Public method declarations ---
+    public:
+        explicit MultilaterationEngine(std::vector<Point> positions_by_slot);
+        ~MultilaterationEngine();
+
+        MultilaterationEngine(const MultilaterationEngine&) = delete;
+        MultilaterationEngine& operator=(const MultilaterationEngine&) = delete;
+
+        // Returns nullptr only if mask is not cached and no more solvers may be evicted for it.
+        const SubsetSolver* solver(uint64_t mask);
+
+        std::optional<Fix> solve(uint64_t mask, const double* ranges_by_slot);
+
+        // Masks with a solver in the cache, to warm a replacement engine with.
+        std::vector<uint64_t> cached_masks() const;
+
+        size_t sensor_count() const { return positions_.size(); }
+        const std::vector<Point>& positions() const { return positions_; }
+};
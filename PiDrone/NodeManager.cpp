@@ -1,65 +1,242 @@
 #include "NodeManager.h"
 #include <iostream>
 #include <iomanip>
+#include <thread>
 
 void process_sensor_update(const std::string& esp_id, const TrackedSensor& sensor);
-void process_drone_location(const Point& drone_pos);
+void process_drone_location(const Fix& fix, IngestClock::time_point received_at);
 
-NodeManager::NodeManager(std::string esp_id, DroneTracker& tracker)
-    : esp_id_(esp_id), drone_tracker_(tracker), worker_(&NodeManager::process_loop, this) {}
+NodeManager::NodeManager(NodeHandle node, SensorRegistry& registry, ZonedTracker& tracker,
+                         WorkStealingExecutor& executor, const RangeFilterConfig& filter_config,
+                         const NodeQueueConfig& queue_config, int home_worker, ParticleFilter* particles)
+    : node_(node), esp_id_(registry.node(node).esp_id), registry_(registry),
+      drone_tracker_(tracker), executor_(executor), home_worker_(home_worker), filter_config_(filter_config),
+      particles_(particles), queue_config_(queue_config), msg_queue_(queue_config.capacity) {
+    if (queue_config_.policy == OverloadPolicy::LatestPerSensor) {
+        mailboxes_ = std::make_unique<LatestMailbox<IngestMessage>[]>(MAX_MAILBOXES);
+    }
+}
 
 NodeManager::~NodeManager() {
-    stop_flag_ = true;
-    cv_.notify_one();
-    if (worker_.joinable()) {
-        worker_.join();
+    while (scheduled_.load(std::memory_order_acquire) || active_runs_.load(std::memory_order_acquire) != 0 || pending()) {
+        std::this_thread::yield();
+    }
+}
+
+void NodeManager::add_message(IngestMessage&& msg) {
+    msg.enqueued_at = metrics_.start_sample();
+    metrics_.record(LatencyStage::Route, msg.received_at, msg.enqueued_at);
+    switch (queue_config_.policy) {
+        case OverloadPolicy::LatestPerSensor: {
+            const uint8_t mailbox = mailbox_for(msg.sensor);
+            if (mailbox != NO_MAILBOX) {
+                if (mailboxes_[mailbox].post(std::move(msg))) bump(coalesced_);
+                break;
+            }
+            bump(dropped_, msg_queue_.push_evict(std::move(msg)));
+            break;
+        }
+        case OverloadPolicy::DropOldest:
+            bump(dropped_, msg_queue_.push_evict(std::move(msg)));
+            break;
+        case OverloadPolicy::Block:
+            // If the pool falls this far behind we hold the producer back rather than lose anything.
+            while (!msg_queue_.try_push(std::move(msg))) {
+                std::this_thread::yield();
+            }
+            break;
+    }
+    schedule();
+}
+
+// Producer side. Batched frames and sensors beyond MAX_MAILBOXES get NO_MAILBOX.
+uint8_t NodeManager::mailbox_for(SensorHandle sensor) {
+    for (const auto& entry : mailbox_of_) {
+        if (entry.first == sensor) return entry.second;
+    }
+    const size_t count = mailbox_count_.load(std::memory_order_relaxed);
+    uint8_t mailbox = NO_MAILBOX;
+    if (count < MAX_MAILBOXES && registry_.sensor(sensor).sensor_id != BATCH_SENSOR_ID) {
+        mailbox = static_cast<uint8_t>(count);
+        mailbox_count_.store(count + 1, std::memory_order_release);
     }
+    mailbox_of_.emplace_back(sensor, mailbox);
+    return mailbox;
 }
 
-void NodeManager::add_message(mqtt::const_message_ptr msg) {
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        msg_queue_.push(msg);
+bool NodeManager::pending() const {
+    if (!msg_queue_.empty()) return true;
+    const size_t mailboxes = mailbox_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < mailboxes; ++i) {
+        if (mailboxes_[i].has_value()) return true;
     }
-    cv_.notify_one();
+    return false;
 }
 
-void NodeManager::process_loop() {
-    while (!stop_flag_) {
-        mqtt::const_message_ptr msg;
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            cv_.wait(lock, [this] { return !msg_queue_.empty() || stop_flag_; });
-            if (stop_flag_ && msg_queue_.empty()) return;
-            msg = msg_queue_.front();
-            msg_queue_.pop();
+size_t NodeManager::queued() const {
+    size_t total = msg_queue_.size_approx();
+    const size_t mailboxes = mailbox_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < mailboxes; ++i) {
+        total += mailboxes_[i].has_value() ? 1 : 0;
+    }
+    return total;
+}
+
+void NodeManager::schedule() {
+    if (!scheduled_.exchange(true, std::memory_order_acq_rel)) {
+        if (home_worker_ < 0) {
+            executor_.submit(this);
+        } else {
+            executor_.submit(this, static_cast<size_t>(home_worker_));
         }
+    }
+}
+
+void NodeManager::run() {
+    active_runs_.fetch_add(1, std::memory_order_relaxed);
+    const size_t mailboxes = mailbox_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < mailboxes; ++i) {
+        mailboxes_[i].take([this](IngestMessage& msg) { process_message(msg); });
+    }
+    msg_queue_.drain([this](IngestMessage& msg) {
+        process_message(msg);
+        msg = IngestMessage{};
+    }, MAX_BATCH);
 
-        try {
-            std::string topic = msg->get_topic();
-            size_t last_slash = topic.find_last_of('/');
-            std::string sensor_id = topic.substr(last_slash + 1);
-            std::string full_sensor_id = esp_id_ + "/" + sensor_id;
+    // Hand the node back. Anything pushed after the drain but before this point
+    // saw scheduled_ == true and did not submit, so re-check and take it over.
+    scheduled_.exchange(false, std::memory_order_acq_rel);
+    if (pending()) {
+        schedule();
+    }
+    // Last touch of this object, the destructor may run as soon as it is visible.
+    // A counter rather than a flag, the run we just rescheduled may finish before we get here.
+    active_runs_.fetch_sub(1, std::memory_order_release);
+}
 
-            if (sensors_.find(sensor_id) == sensors_.end()) {
-                sensors_.emplace(sensor_id, TrackedSensor(sensor_id));
-            }
+size_t NodeManager::sensor_index(SensorHandle handle) {
+    for (size_t i = 0; i < sensor_handles_.size(); ++i) {
+        if (sensor_handles_[i] == handle) {
+            return i;
+        }
+    }
+    sensor_handles_.push_back(handle);
+    sensors_.emplace_back(registry_.sensor(handle).sensor_id);
+    sensor_formats_.emplace_back();
+    range_filters_.emplace_back(filter_config_);
+    return sensors_.size() - 1;
+}
+
+// Readings in a batched frame carry only the sensor id, the node is the one the frame came from.
+size_t NodeManager::sensor_index(std::string_view sensor_id) {
+    for (size_t i = 0; i < sensors_.size(); ++i) {
+        if (sensors_[i].getId() == sensor_id) {
+            return i;
+        }
+    }
+    std::string full_id = esp_id_;
+    full_id += '/';
+    full_id.append(sensor_id);
+    const SensorHandle handle = registry_.intern_sensor(full_id);
+    if (handle == INVALID_SENSOR) {
+        throw std::runtime_error("cannot register sensor " + full_id);
+    }
+    return sensor_index(handle);
+}
 
-            auto& sensor = sensors_.at(sensor_id);
-            auto data_json = nlohmann::json::parse(msg->get_payload_str());
-            SensorData point = SensorData::fromJson(data_json);
-            sensor.addDataPoint(point);
+// Runs on a worker for every message, a change is only counted, never printed.
+void NodeManager::note_format(size_t index, PayloadFormat format) {
+    std::optional<PayloadFormat>& last = sensor_formats_[index];
+    if (last && *last != format) {
+        metrics_.add(PipelineCounter::FormatChanges);
+    }
+    last = format;
+}
 
-            process_sensor_update(esp_id_, sensor);
+void NodeManager::process_message(const IngestMessage& msg) {
+    sampled_ = msg.enqueued_at != IngestClock::time_point{};
+    const IngestClock::time_point dequeued_at = stamp();
+    metrics_.record(LatencyStage::Queue, msg.enqueued_at, dequeued_at);
+    metrics_.add(PipelineCounter::Messages);
+    try {
+        // Each topic may carry JSON, binary or batched payloads, detect rather than configure it.
+        const PayloadFormat format = detect_payload_format(msg.payload);
+        if (format == PayloadFormat::Batch) {
+            process_batch(msg, dequeued_at);
+            return;
+        }
+        if (registry_.sensor(msg.sensor).sensor_id == BATCH_SENSOR_ID) {
+            throw std::runtime_error("batch topic carried a single reading payload");
+        }
 
-            auto calculated_pos = drone_tracker_.updateAndCalculate(full_sensor_id, point.range);
+        const size_t index = sensor_index(msg.sensor);
+        note_format(index, format);
+        SensorData point = format == PayloadFormat::Binary
+            ? SensorData::from_binary(msg.payload)
+            : SensorData::from_json_text(msg.payload);
+        metrics_.record(LatencyStage::Parse, dequeued_at, stamp());
+        process_reading(index, point, msg.received_at);
 
-            if (calculated_pos) {
-                process_drone_location(*calculated_pos);
-            }
+    } catch (const std::exception&) {
+        // A malformed payload is dropped and counted, writing to std::cerr here would stall the worker.
+        metrics_.add(PipelineCounter::ParseErrors);
+    }
+}
+
+/**
+    * @brief Unpacks a batched frame into one update per reading, in frame order.
+    *
+    * Every reading keeps the timestamp the node took it at, only received_at is
+    * shared by the whole frame. The parse stage covers validating the frame,
+    * the readings are decoded as they are processed.
+*/
+void NodeManager::process_batch(const IngestMessage& msg, IngestClock::time_point dequeued_at) {
+    BatchFrameView frame(msg.payload);
+    if (!frame.valid()) {
+        throw std::runtime_error("malformed batched frame");
+    }
+    metrics_.record(LatencyStage::Parse, dequeued_at, stamp());
+    frame.for_each([&](std::string_view sensor_id, std::string_view reading) {
+        const size_t index = sensor_index(sensor_id);
+        note_format(index, PayloadFormat::Batch);
+        process_reading(index, SensorData::from_binary(reading), msg.received_at);
+    });
+}
+
+void NodeManager::process_reading(size_t index, const SensorData& point, IngestClock::time_point received_at) {
+    metrics_.add(PipelineCounter::Readings);
+    auto& sensor = sensors_[index];
+    sensor.addDataPoint(point);
+
+    process_sensor_update(esp_id_, sensor);
 
-        } catch (const std::exception& e) {
-            std::cerr << "Error in process_loop for node " << esp_id_ << ": " << e.what() << std::endl;
+    // Unfiltered: the particle filter's range model already expects reflections and outliers.
+    if (particles_) {
+        if (point.presence) {
+            particles_->update(sensor_handles_[index], point.range, received_at);
+        } else {
+            particles_->miss(sensor_handles_[index], received_at);
         }
     }
-}
\ No newline at end of file
+
+    // The history above keeps the raw reading, only the tracker works on filtered ranges.
+    const std::optional<double> range = range_filters_[index].update(point);
+    if (!range) {
+        metrics_.add(PipelineCounter::RejectedReadings);
+        // The radar lost the target, its last range no longer says where the drone is.
+        if (filter_config_.require_presence && !point.presence) {
+            drone_tracker_.withdraw(sensor_handles_[index]);
+        }
+        return;
+    }
+    const IngestClock::time_point update_start = stamp();
+    auto fix = drone_tracker_.updateAndCalculate(sensor_handles_[index], *range, point.timestamp_ms, received_at);
+    const IngestClock::time_point update_end = stamp();
+    metrics_.record(fix ? LatencyStage::Solve : LatencyStage::Update, update_start, update_end);
+
+    if (fix) {
+        metrics_.add(PipelineCounter::Fixes);
+        metrics_.record(LatencyStage::EndToEnd, received_at, update_end);
+        process_drone_location(*fix, received_at);
+    }
+}
@@ -1,32 +1,127 @@
 #pragma once
 
 #include <string>
-#include <map>
-#include <queue>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
+#include <string_view>
+#include <vector>
 #include <atomic>
-#include "mqtt/async_client.h"
+#include <memory>
+#include <optional>
+#include <utility>
+#include "IngestSource.h"
+#include "DropOldestRing.h"
+#include "LatestMailbox.h"
+#include "SensorRegistry.h"
+#include "WorkStealingExecutor.h"
 #include "SensorModel.h"
-#include "DroneTracker.h"
+#include "ZonedTracker.h"
+#include "RangeFilter.h"
+#include "Metrics.h"
+#include "ParticleFilter.h"
 
-class NodeManager {
+/**
+    * What a NodeManager does with new messages when its worker falls behind.
+    *
+    * Every policy keeps memory fixed. Block loses nothing but holds up the
+    * ingest thread, and with it every other node, right for replaying a
+    * journal as fast as possible. For live tracking only the newest range of
+    * each sensor matters: DropOldest keeps the newest capacity messages,
+    * LatestPerSensor keeps one message per sensor, so however long the
+    * worker was stalled it never solves on a range older than one reading.
+    * Batched frames carry several sensors and are never coalesced, under
+    * LatestPerSensor they go through the drop-oldest queue.
+*/
+enum class OverloadPolicy : uint8_t {
+    Block,
+    DropOldest,
+    LatestPerSensor
+};
+
+struct NodeQueueConfig {
+    OverloadPolicy policy = OverloadPolicy::Block;
+    size_t capacity = 4096; // messages, rounded up to a power of two
+};
+
+/**
+    * @class NodeManager
+    * @brief Per-ESP-node state and message queue, run as a task chain on the shared executor.
+    *
+    * add_message() enqueues and schedules the node on the executor if it is not
+    * already scheduled. At most one run() of a node is in flight at any time, so
+    * messages from one node are still processed strictly in arrival order,
+    * except that under OverloadPolicy::LatestPerSensor each sensor's newest
+    * message is taken before the queue.
+*/
+class NodeManager : public ExecutorTask {
 private:
+    // Sensors per node that get a mailbox under LatestPerSensor, any beyond share the queue.
+    static constexpr size_t MAX_MAILBOXES = 16;
+    static constexpr uint8_t NO_MAILBOX = 0xFF;
+    // Upper bound on messages handled per run() so one chatty node cannot starve the others.
+    static constexpr size_t MAX_BATCH = 256;
+
+    NodeHandle node_;
     std::string esp_id_;
-    DroneTracker& drone_tracker_;
-    std::map<std::string, TrackedSensor> sensors_;
-    std::queue<mqtt::const_message_ptr> msg_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable cv_;
-    std::atomic<bool> stop_flag_{false};
-    std::thread worker_;
+    // Not const, readings in a batched frame may name sensors the router has never seen a topic for.
+    SensorRegistry& registry_;
+    ZonedTracker& drone_tracker_;
+    WorkStealingExecutor& executor_;
+    // Worker this node prefers to run on, -1 for any, see WorkStealingExecutor::submit().
+    int home_worker_;
+    // A node carries a handful of sensors, a linear scan over handles beats any map.
+    std::vector<SensorHandle> sensor_handles_;
+    std::vector<TrackedSensor> sensors_;
+    // Payload format each sensor's readings last arrived in, detected per message, empty until the first one.
+    std::vector<std::optional<PayloadFormat>> sensor_formats_;
+    // Applied to every sensor's ranges before the tracker sees them, a rejected reading triggers no solve.
+    RangeFilterConfig filter_config_;
+    std::vector<RangeFilter> range_filters_;
+    // Optional, fed every raw reading, see ParticleFilter.h.
+    ParticleFilter* particles_;
+    PipelineMetrics& metrics_ = pipeline_metrics();
+    // Whether the message being processed is timed, see PipelineMetrics::start_sample().
+    bool sampled_ = false;
+    NodeQueueConfig queue_config_;
+    // Single producer (the ingest thread) and single consumer (whichever worker runs this node).
+    DropOldestRing<IngestMessage> msg_queue_;
+    // LatestPerSensor only. The producer assigns mailboxes, mailbox_count_ publishes them to the consumer.
+    std::unique_ptr<LatestMailbox<IngestMessage>[]> mailboxes_;
+    std::vector<std::pair<SensorHandle, uint8_t>> mailbox_of_;
+    std::atomic<size_t> mailbox_count_{0};
+    // Written by the producer only.
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> scheduled_{false};
+    std::atomic<int> active_runs_{0};
 
-    void process_loop();
+    void schedule();
+    uint8_t mailbox_for(SensorHandle sensor);
+    bool pending() const;
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    IngestClock::time_point stamp() const { return sampled_ ? IngestClock::now() : IngestClock::time_point{}; }
+    size_t sensor_index(SensorHandle handle);
+    size_t sensor_index(std::string_view sensor_id);
+    void note_format(size_t index, PayloadFormat format);
+    void process_message(const IngestMessage& msg);
+    void process_batch(const IngestMessage& msg, IngestClock::time_point dequeued_at);
+    void process_reading(size_t index, const SensorData& point, IngestClock::time_point received_at);
 
 public:
-    NodeManager(std::string esp_id, DroneTracker& tracker);
-    ~NodeManager();
+    NodeManager(NodeHandle node, SensorRegistry& registry, ZonedTracker& tracker, WorkStealingExecutor& executor,
+                const RangeFilterConfig& filter_config = {}, const NodeQueueConfig& queue_config = {},
+                int home_worker = -1, ParticleFilter* particles = nullptr);
+    // Waits for every queued message of this node to be processed.
+    ~NodeManager() override;
+
+    // msg.sensor must already be resolved. Must only be called from one thread at a time, see DropOldestRing.
+    void add_message(IngestMessage&& msg);
+
+    void run() override;
 
-    void add_message(mqtt::const_message_ptr msg);
-};
\ No newline at end of file
+    // Messages waiting in the queue and mailboxes, approximate while the node is being fed or run.
+    size_t queued() const;
+    // Messages evicted from the full queue, and mailbox messages overwritten before they were taken.
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t coalesced() const { return coalesced_.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,85 @@
+/**
+    * @file PahoIngestSource.cpp
+    * @brief Paho MQTT implementation of IngestSource.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "PahoIngestSource.h"
+#include <iostream>
+#include "ConsoleColors.h"
+// --- End Imports ---
+
+PahoIngestSource::PahoIngestSource(const std::string& server_address, const std::string& client_id,
+                                   std::string topic_filter, int qos)
+    : topic_filter_(std::move(topic_filter)), qos_(qos),
+      client_(std::make_unique<mqtt::async_client>(server_address, client_id)),
+      callback_(*this) {}
+
+PahoIngestSource::~PahoIngestSource() {
+    stop();
+}
+
+/**
+    * @brief Connects to the broker and starts delivering messages to the handler.
+    *
+    * Throws mqtt::exception if the broker cannot be reached, the subscription
+    * itself is made from the connected() callback so it is renewed on reconnect.
+*/
+void PahoIngestSource::start(IngestHandler handler) {
+    handler_ = std::move(handler);
+    client_->set_callback(callback_);
+
+    mqtt::connect_options conn_opts;
+    conn_opts.set_clean_session(true);
+    client_->connect(conn_opts)->wait();
+}
+
+void PahoIngestSource::stop() {
+    try {
+        if (client_ && client_->is_connected()) {
+            client_->disconnect()->wait();
+        }
+    } catch (const mqtt::exception& e) {
+        std::cerr << FORE_RED << "[ERROR] while disconnecting: " << e.what() << STYLE_RESET << std::endl;
+    }
+    finish(false);
+}
+
+bool PahoIngestSource::join() {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    state_cv_.wait(lock, [this] { return finished_; });
+    return !failed_;
+}
+
+void PahoIngestSource::finish(bool failed) {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (finished_) return;
+        finished_ = true;
+        failed_ = failed;
+    }
+    state_cv_.notify_all();
+}
+
+void PahoIngestSource::Callback::connection_lost(const std::string& cause) {
+    std::cerr << FORE_RED << "\n---> Connection lost: " << cause << STYLE_RESET << std::endl;
+    owner_.finish(true);
+}
+
+void PahoIngestSource::Callback::connected(const std::string& /*cause*/) {
+    std::cout << FORE_CYAN << "---> Successfully connected to MQTT Broker." << STYLE_RESET << std::endl;
+    owner_.client_->subscribe(owner_.topic_filter_, owner_.qos_);
+    std::cout << FORE_CYAN << "---> Subscribed to '" << owner_.topic_filter_ << "'. Waiting for data..." << STYLE_RESET << std::endl;
+}
+
+void PahoIngestSource::Callback::message_arrived(mqtt::const_message_ptr msg) {
+    // Nothing may escape into Paho's callback thread, a bad message costs only itself.
+    try {
+        owner_.handler_(IngestMessage{msg->get_topic(), msg->get_payload_str(), IngestClock::now()});
+    } catch (const std::exception& e) {
+        owner_.handler_errors_.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << FORE_RED << "[ERROR] in message_arrived: " << e.what() << STYLE_RESET << std::endl;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+    * @file PahoIngestSource.h
+    * @brief IngestSource backed by the Paho async MQTT client.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * This is the only part of the tracker that depends on Paho. It connects to the
+    * broker, subscribes to the sensor topic filter and converts every arriving
+    * mqtt message into an IngestMessage on the Paho callback thread.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include "mqtt/async_client.h"
+#include "IngestSource.h"
+
+class PahoIngestSource : public IngestSource {
+    // --- Private var declaration to be used ---
+    private:
+        class Callback : public virtual mqtt::callback {
+            PahoIngestSource& owner_;
+
+        public:
+            explicit Callback(PahoIngestSource& owner) : owner_(owner) {}
+
+            void connection_lost(const std::string& cause) override;
+            void connected(const std::string& cause) override;
+            void message_arrived(mqtt::const_message_ptr msg) override;
+        };
+
+        std::string topic_filter_;
+        int qos_;
+        std::unique_ptr<mqtt::async_client> client_;
+        Callback callback_;
+        IngestHandler handler_;
+        std::atomic<uint64_t> handler_errors_{0};
+
+        std::mutex state_mutex_;
+        std::condition_variable state_cv_;
+        bool finished_ = false;
+        bool failed_ = false;
+
+        void finish(bool failed);
+
+    // --- Public method declarations ---
+    public:
+        PahoIngestSource(const std::string& server_address, const std::string& client_id,
+                         std::string topic_filter, int qos);
+        ~PahoIngestSource() override;
+
+        void start(IngestHandler handler) override;
+        void stop() override;
+        bool join() override;
+
+        // Messages the handler threw on, they are dropped.
+        uint64_t handler_errors() const { return handler_errors_.load(std::memory_order_relaxed); }
+};
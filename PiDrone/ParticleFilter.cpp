@@ -0,0 +1,491 @@
+/**
+    * @file ParticleFilter.cpp
+    * @brief Prediction, weighting kernels and parallel systematic resampling of the ParticleFilter.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The kernels all compute the same likelihood, the vector ones on 2 or 4
+    * particles at a time, and accumulate the weighted sums in the same pass.
+    * As in BatchMultilateration.cpp the AVX2 kernel is compiled with a target
+    * attribute.
+*/
+
+// --- Imports ---
+#include "ParticleFilter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define DRONE_HAVE_X86_SIMD 1
+#endif
+// --- End Imports ---
+
+namespace {
+
+constexpr unsigned SPINS_BEFORE_YIELD = 256;
+
+/**
+    * @struct RangeModel
+    * @brief The likelihood parameters of one range, as the kernels want them.
+    *
+    * For r = range - distance, L = 1 / (1 + r^2 / s^2) + floor, with s the
+    * multipath sigma for r > 0 (the reading is longer) and the range sigma
+    * otherwise.
+*/
+struct RangeModel {
+    double sx, sy, range, scale;
+    double inv_core_sq, inv_tail_sq, floor;
+};
+
+RangeModel range_model(const Point& sensor, double range, double scale, const ParticleFilterConfig& config) {
+    return {sensor.x,
+            sensor.y,
+            range,
+            scale,
+            1.0 / (config.range_sigma_m * config.range_sigma_m),
+            1.0 / (config.multipath_sigma_m * config.multipath_sigma_m),
+            config.outlier_floor};
+}
+
+inline void accumulate(ParticleFilter::Sums& s, double w, double x, double y, double vx, double vy) {
+    s.w += w;
+    s.w2 += w * w;
+    s.wx += w * x;
+    s.wy += w * y;
+    s.wxx += w * x * x;
+    s.wyy += w * y * y;
+    s.wvx += w * vx;
+    s.wvy += w * vy;
+}
+
+void add(ParticleFilter::Sums& into, const ParticleFilter::Sums& s) {
+    into.w += s.w;
+    into.w2 += s.w2;
+    into.wx += s.wx;
+    into.wy += s.wy;
+    into.wxx += s.wxx;
+    into.wyy += s.wyy;
+    into.wvx += s.wvx;
+    into.wvy += s.wvy;
+}
+
+void kernel_scalar(const RangeModel& m, const double* x, const double* y, const double* vx, const double* vy,
+                   double* w, size_t begin, size_t end, ParticleFilter::Sums& s) {
+    for (size_t i = begin; i < end; ++i) {
+        const double dx = x[i] - m.sx;
+        const double dy = y[i] - m.sy;
+        const double r = m.range - std::sqrt(dx * dx + dy * dy);
+        const double inv = r > 0.0 ? m.inv_tail_sq : m.inv_core_sq;
+        const double wi = w[i] * m.scale * (1.0 / (1.0 + r * r * inv) + m.floor);
+        w[i] = wi;
+        accumulate(s, wi, x[i], y[i], vx[i], vy[i]);
+    }
+}
+
+#if DRONE_HAVE_X86_SIMD
+
+double hsum(__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+ParticleFilter::Sums kernel_sse2(const RangeModel& m, const double* x, const double* y, const double* vx,
+                                 const double* vy, double* w, size_t count) {
+    const __m128d sx = _mm_set1_pd(m.sx), sy = _mm_set1_pd(m.sy);
+    const __m128d range = _mm_set1_pd(m.range), scale = _mm_set1_pd(m.scale);
+    const __m128d core = _mm_set1_pd(m.inv_core_sq), tail = _mm_set1_pd(m.inv_tail_sq);
+    const __m128d floor = _mm_set1_pd(m.floor), one = _mm_set1_pd(1.0), zero = _mm_setzero_pd();
+    __m128d sw = zero, sw2 = zero, swx = zero, swy = zero, swxx = zero, swyy = zero, swvx = zero, swvy = zero;
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d px = _mm_loadu_pd(x + i), py = _mm_loadu_pd(y + i);
+        const __m128d dx = _mm_sub_pd(px, sx), dy = _mm_sub_pd(py, sy);
+        const __m128d r = _mm_sub_pd(range, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy))));
+        const __m128d longer = _mm_cmpgt_pd(r, zero);
+        const __m128d inv = _mm_or_pd(_mm_and_pd(longer, tail), _mm_andnot_pd(longer, core));
+        const __m128d l = _mm_add_pd(_mm_div_pd(one, _mm_add_pd(one, _mm_mul_pd(_mm_mul_pd(r, r), inv))), floor);
+        const __m128d wi = _mm_mul_pd(_mm_mul_pd(_mm_loadu_pd(w + i), scale), l);
+        _mm_storeu_pd(w + i, wi);
+        const __m128d wpx = _mm_mul_pd(wi, px), wpy = _mm_mul_pd(wi, py);
+        sw = _mm_add_pd(sw, wi);
+        sw2 = _mm_add_pd(sw2, _mm_mul_pd(wi, wi));
+        swx = _mm_add_pd(swx, wpx);
+        swy = _mm_add_pd(swy, wpy);
+        swxx = _mm_add_pd(swxx, _mm_mul_pd(wpx, px));
+        swyy = _mm_add_pd(swyy, _mm_mul_pd(wpy, py));
+        swvx = _mm_add_pd(swvx, _mm_mul_pd(wi, _mm_loadu_pd(vx + i)));
+        swvy = _mm_add_pd(swvy, _mm_mul_pd(wi, _mm_loadu_pd(vy + i)));
+    }
+
+    ParticleFilter::Sums s{hsum(sw), hsum(sw2), hsum(swx), hsum(swy), hsum(swxx), hsum(swyy), hsum(swvx), hsum(swvy)};
+    kernel_scalar(m, x, y, vx, vy, w, i, count, s);
+    return s;
+}
+
+__attribute__((target("avx2,fma")))
+double hsum(__m256d v) {
+    const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+__attribute__((target("avx2,fma")))
+ParticleFilter::Sums kernel_avx2(const RangeModel& m, const double* x, const double* y, const double* vx,
+                                 const double* vy, double* w, size_t count) {
+    const __m256d sx = _mm256_set1_pd(m.sx), sy = _mm256_set1_pd(m.sy);
+    const __m256d range = _mm256_set1_pd(m.range), scale = _mm256_set1_pd(m.scale);
+    const __m256d core = _mm256_set1_pd(m.inv_core_sq), tail = _mm256_set1_pd(m.inv_tail_sq);
+    const __m256d floor = _mm256_set1_pd(m.floor), one = _mm256_set1_pd(1.0), zero = _mm256_setzero_pd();
+    __m256d sw = zero, sw2 = zero, swx = zero, swy = zero, swxx = zero, swyy = zero, swvx = zero, swvy = zero;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d px = _mm256_loadu_pd(x + i), py = _mm256_loadu_pd(y + i);
+        const __m256d dx = _mm256_sub_pd(px, sx), dy = _mm256_sub_pd(py, sy);
+        const __m256d r = _mm256_sub_pd(range, _mm256_sqrt_pd(_mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy))));
+        const __m256d inv = _mm256_blendv_pd(core, tail, _mm256_cmp_pd(r, zero, _CMP_GT_OQ));
+        const __m256d l = _mm256_add_pd(_mm256_div_pd(one, _mm256_fmadd_pd(_mm256_mul_pd(r, r), inv, one)), floor);
+        const __m256d wi = _mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(w + i), scale), l);
+        _mm256_storeu_pd(w + i, wi);
+        const __m256d wpx = _mm256_mul_pd(wi, px), wpy = _mm256_mul_pd(wi, py);
+        sw = _mm256_add_pd(sw, wi);
+        sw2 = _mm256_fmadd_pd(wi, wi, sw2);
+        swx = _mm256_add_pd(swx, wpx);
+        swy = _mm256_add_pd(swy, wpy);
+        swxx = _mm256_fmadd_pd(wpx, px, swxx);
+        swyy = _mm256_fmadd_pd(wpy, py, swyy);
+        swvx = _mm256_fmadd_pd(wi, _mm256_loadu_pd(vx + i), swvx);
+        swvy = _mm256_fmadd_pd(wi, _mm256_loadu_pd(vy + i), swvy);
+    }
+
+    ParticleFilter::Sums s{hsum(sw), hsum(sw2), hsum(swx), hsum(swy), hsum(swxx), hsum(swyy), hsum(swvx), hsum(swvy)};
+    kernel_scalar(m, x, y, vx, vy, w, i, count, s);
+    return s;
+}
+
+#endif
+
+} // namespace
+
+ParticleFilter::Sums ParticleFilter::weigh_range(const double* x, const double* y, const double* vx, const double* vy,
+                                                 double* w, size_t count, const Point& sensor, double range,
+                                                 double scale, const ParticleFilterConfig& config, SimdLevel level) {
+    const RangeModel m = range_model(sensor, range, scale, config);
+
+    // Never run a kernel the CPU cannot execute.
+    if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) {
+        level = detect_simd_level();
+    }
+
+    switch (level) {
+#if DRONE_HAVE_X86_SIMD
+        case SimdLevel::AVX2: return kernel_avx2(m, x, y, vx, vy, w, count);
+        case SimdLevel::SSE2: return kernel_sse2(m, x, y, vx, vy, w, count);
+#endif
+        default: {
+            Sums s;
+            kernel_scalar(m, x, y, vx, vy, w, 0, count, s);
+            return s;
+        }
+    }
+}
+
+ParticleFilter::ParticleFilter(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry,
+                               ParticleFilterConfig config)
+    : config_(config), count_(config.particles), rng_(config.seed * 0x9E3779B97F4A7C15ULL | 1) {
+    if (count_ == 0) {
+        throw std::runtime_error("ParticleFilter needs at least one particle");
+    }
+    set_sensors(sensor_positions, registry);
+
+    size_t threads = config_.threads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    chunks_ = std::max<size_t>(1, std::min(threads, count_ / MIN_CHUNK));
+
+    for (auto* v : {&x_, &y_, &vx_, &vy_, &w_, &next_x_, &next_y_, &next_vx_, &next_vy_, &next_w_}) {
+        v->assign(count_, 0.0);
+    }
+    std::mt19937_64 gen(config_.seed);
+    std::normal_distribution<double> normal;
+    noise_.resize(NOISE_TABLE);
+    for (double& n : noise_) n = normal(gen);
+
+    chunk_sums_.resize(chunks_);
+    job_.noise_offset.resize(chunks_);
+    job_.cumulative.resize(chunks_);
+    job_.first_out.resize(chunks_);
+    snapshot_.store(ParticleEstimate{});
+
+    for (size_t i = 1; i < chunks_; ++i) {
+        helpers_.push_back(std::make_unique<Helper>());
+    }
+    for (size_t i = 1; i < chunks_; ++i) {
+        helpers_[i - 1]->thread = std::thread(&ParticleFilter::helper_loop, this, i);
+    }
+}
+
+ParticleFilter::~ParticleFilter() {
+    stop_.store(true, std::memory_order_release);
+    for (auto& helper : helpers_) {
+        helper->posted.fetch_add(1, std::memory_order_release);
+        helper->waiter.notify();
+    }
+    for (auto& helper : helpers_) {
+        helper->thread.join();
+    }
+}
+
+void ParticleFilter::set_sensors(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry) {
+    if (sensor_positions.empty()) {
+        throw std::runtime_error("ParticleFilter needs at least one sensor");
+    }
+    std::vector<Point> by_handle;
+    Point lo{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+    Point hi{-lo.x, -lo.y};
+    for (const auto& pair : sensor_positions) {
+        const SensorHandle handle = registry.intern_sensor(pair.first);
+        if (handle == INVALID_SENSOR) {
+            throw std::runtime_error("Sensor registry full, cannot add " + pair.first);
+        }
+        if (handle >= by_handle.size()) {
+            by_handle.resize(handle + 1, {std::numeric_limits<double>::quiet_NaN(), 0.0});
+        }
+        by_handle[handle] = pair.second;
+        lo = {std::min(lo.x, pair.second.x), std::min(lo.y, pair.second.y)};
+        hi = {std::max(hi.x, pair.second.x), std::max(hi.y, pair.second.y)};
+    }
+
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    sensor_of_handle_ = std::move(by_handle);
+    area_min_ = {lo.x - config_.margin_m, lo.y - config_.margin_m};
+    area_max_ = {hi.x + config_.margin_m, hi.y + config_.margin_m};
+}
+
+bool ParticleFilter::known(SensorHandle sensor) const {
+    return sensor < sensor_of_handle_.size() && !std::isnan(sensor_of_handle_[sensor].x);
+}
+
+// xorshift64*, only the noise table offsets and resampling draws come from it.
+uint64_t ParticleFilter::next_random() {
+    rng_ ^= rng_ >> 12;
+    rng_ ^= rng_ << 25;
+    rng_ ^= rng_ >> 27;
+    return rng_ * 0x2545F4914F6CDD1DULL;
+}
+
+void ParticleFilter::spread() {
+    const double width = area_max_.x - area_min_.x;
+    const double height = area_max_.y - area_min_.y;
+    for (size_t i = 0; i < count_; ++i) {
+        x_[i] = area_min_.x + uniform() * width;
+        y_[i] = area_min_.y + uniform() * height;
+        vx_[i] = 0.0;
+        vy_[i] = 0.0;
+        w_[i] = 1.0;
+    }
+    weight_scale_ = 1.0;
+}
+
+void ParticleFilter::advance(IngestClock::time_point received_at) {
+    const double gap = std::chrono::duration<double>(received_at - last_update_).count();
+    if (!started_ || gap > config_.max_coast_s) {
+        spread();
+        started_ = true;
+        job_.dt = 0.0;
+        last_update_ = received_at;
+        return;
+    }
+    // Readings routed through different nodes can arrive slightly out of order.
+    job_.dt = std::max(0.0, gap);
+    last_update_ = std::max(last_update_, received_at);
+}
+
+void ParticleFilter::update(SensorHandle sensor, double range, IngestClock::time_point received_at) {
+    if (!std::isfinite(range)) return;
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    if (!known(sensor)) return;
+    advance(received_at);
+    weigh(Phase::Range, sensor_of_handle_[sensor], range);
+}
+
+void ParticleFilter::miss(SensorHandle sensor, IngestClock::time_point received_at) {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    if (!known(sensor)) return;
+    advance(received_at);
+    weigh(Phase::Miss, sensor_of_handle_[sensor], 0.0);
+}
+
+void ParticleFilter::weigh(Phase phase, const Point& sensor, double range) {
+    job_.phase = phase;
+    job_.sensor = sensor;
+    job_.range = range;
+    job_.scale = weight_scale_;
+    for (size_t& offset : job_.noise_offset) offset = static_cast<size_t>(next_random() % NOISE_TABLE);
+    run_phase();
+
+    Sums total;
+    for (const Sums& s : chunk_sums_) add(total, s);
+    if (!(total.w > 0.0) || !std::isfinite(total.w) || !(total.w2 > 0.0)) {
+        // Every hypothesis ruled out, e.g. by a sensor that moved: start over.
+        spread();
+        return;
+    }
+
+    const double inv = 1.0 / total.w;
+    ParticleEstimate e;
+    e.position = {total.wx * inv, total.wy * inv};
+    e.velocity = {total.wvx * inv, total.wvy * inv};
+    const double var_x = total.wxx * inv - e.position.x * e.position.x;
+    const double var_y = total.wyy * inv - e.position.y * e.position.y;
+    e.position_sigma = std::sqrt(std::max(0.0, (var_x + var_y) / 2.0));
+    const double ess = total.w * total.w / total.w2;
+    e.effective_fraction = ess / static_cast<double>(count_);
+    e.at = last_update_;
+    e.updates = ++updates_;
+    e.valid = true;
+
+    // Fold the normalization into the next kernel pass instead of a pass of its own.
+    weight_scale_ = static_cast<double>(count_) * inv;
+    if (ess < config_.resample_threshold * static_cast<double>(count_)) {
+        resample();
+    }
+    e.resamples = resamples_;
+    snapshot_.store(e);
+}
+
+void ParticleFilter::resample() {
+    // Output slot j takes the particle whose cumulative weight interval holds
+    // (u0 + j) * step, so a chunk's first slot follows from the weight before it.
+    double total = 0.0;
+    for (size_t k = 0; k < chunks_; ++k) {
+        job_.cumulative[k] = total;
+        total += chunk_sums_[k].w;
+    }
+    job_.step = total / static_cast<double>(count_);
+    job_.u0 = uniform();
+    for (size_t k = 0; k < chunks_; ++k) {
+        const double first = std::ceil(job_.cumulative[k] / job_.step - job_.u0);
+        job_.first_out[k] = k == 0 ? 0 : std::min(count_, static_cast<size_t>(std::max(0.0, first)));
+    }
+    for (size_t& offset : job_.noise_offset) offset = static_cast<size_t>(next_random() % NOISE_TABLE);
+    job_.roughen = config_.roughening_m;
+    job_.phase = Phase::Resample;
+    run_phase();
+
+    x_.swap(next_x_);
+    y_.swap(next_y_);
+    vx_.swap(next_vx_);
+    vy_.swap(next_vy_);
+    w_.swap(next_w_);
+    weight_scale_ = 1.0;
+    ++resamples_;
+}
+
+void ParticleFilter::run_phase() {
+    if (chunks_ == 1) {
+        run_chunk(0);
+        return;
+    }
+    remaining_.store(chunks_ - 1, std::memory_order_relaxed);
+    for (auto& helper : helpers_) {
+        helper->posted.fetch_add(1, std::memory_order_release);
+        helper->waiter.notify();
+    }
+    run_chunk(0);
+    for (unsigned spins = 0; remaining_.load(std::memory_order_acquire) != 0; ++spins) {
+        if (spins < SPINS_BEFORE_YIELD) {
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ParticleFilter::helper_loop(size_t index) {
+    Helper& helper = *helpers_[index - 1];
+    uint64_t seen = 0;
+    while (true) {
+        helper.waiter.wait([&] { return helper.posted.load(std::memory_order_acquire) != seen; });
+        seen = helper.posted.load(std::memory_order_acquire);
+        if (stop_.load(std::memory_order_acquire)) return;
+        run_chunk(index);
+        remaining_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void ParticleFilter::run_chunk(size_t chunk) {
+    const size_t begin = chunk_begin(chunk);
+    const size_t end = chunk_begin(chunk + 1);
+    const size_t offset = job_.noise_offset[chunk];
+    constexpr size_t MASK = NOISE_TABLE - 1;
+
+    if (job_.phase == Phase::Resample) {
+        const size_t out_end = chunk + 1 < chunks_ ? job_.first_out[chunk + 1] : count_;
+        size_t j = job_.first_out[chunk];
+        double cumulative = job_.cumulative[chunk];
+        size_t last = begin;
+        for (size_t i = begin; i < end && j < out_end; ++i) {
+            cumulative += w_[i];
+            while (j < out_end && (job_.u0 + static_cast<double>(j)) * job_.step < cumulative) {
+                next_x_[j] = x_[i] + job_.roughen * noise_[(offset + j) & MASK];
+                next_y_[j] = y_[i] + job_.roughen * noise_[(offset + j + NOISE_TABLE / 2) & MASK];
+                next_vx_[j] = vx_[i];
+                next_vy_[j] = vy_[i];
+                next_w_[j] = 1.0;
+                ++j;
+            }
+            if (w_[i] > 0.0) last = i;
+        }
+        // Rounding can leave a slot or two at the end, they take the chunk's last live particle.
+        for (; j < out_end; ++j) {
+            next_x_[j] = x_[last];
+            next_y_[j] = y_[last];
+            next_vx_[j] = vx_[last];
+            next_vy_[j] = vy_[last];
+            next_w_[j] = 1.0;
+        }
+        return;
+    }
+
+    // Constant velocity with a random acceleration, as TrackFilter's process model.
+    const double dt = job_.dt;
+    if (dt > 0.0) {
+        const double a = config_.process_noise;
+        const double half_dt_sq = 0.5 * dt * dt;
+        for (size_t i = begin; i < end; ++i) {
+            const double ax = a * noise_[(offset + i) & MASK];
+            const double ay = a * noise_[(offset + i + NOISE_TABLE / 2) & MASK];
+            x_[i] += vx_[i] * dt + ax * half_dt_sq;
+            y_[i] += vy_[i] * dt + ay * half_dt_sq;
+            vx_[i] += ax * dt;
+            vy_[i] += ay * dt;
+        }
+    }
+
+    const size_t n = end - begin;
+    if (job_.phase == Phase::Range) {
+        chunk_sums_[chunk] = weigh_range(x_.data() + begin, y_.data() + begin, vx_.data() + begin, vy_.data() + begin,
+                                         w_.data() + begin, n, job_.sensor, job_.range, job_.scale, config_,
+                                         config_.simd);
+        return;
+    }
+
+    // Inside the detection window a silent radar is evidence against the hypothesis.
+    const double min_sq = config_.min_range_m * config_.min_range_m;
+    const double max_sq = config_.max_range_m * config_.max_range_m;
+    Sums s;
+    for (size_t i = begin; i < end; ++i) {
+        const double dx = x_[i] - job_.sensor.x;
+        const double dy = y_[i] - job_.sensor.y;
+        const double d_sq = dx * dx + dy * dy;
+        const double seen = d_sq >= min_sq && d_sq <= max_sq ? config_.miss_probability : 1.0;
+        const double wi = w_[i] * job_.scale * seen;
+        w_[i] = wi;
+        accumulate(s, wi, x_[i], y_[i], vx_[i], vy_[i]);
+    }
+    chunk_sums_[chunk] = s;
+}
@@ -0,0 +1,215 @@
+/**
+    * @file ParticleFilter.h
+    * @brief Drone tracking straight from the per-sensor ranges with a particle filter.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Multilateration followed by the TrackFilter assumes every range is the
+    * true distance plus small Gaussian noise. Near walls the C4001 and LD2412
+    * often report a reflection instead, a range that is meters too long, and
+    * one such range moves the fix, and then the track, by about as much. The
+    * ParticleFilter skips the fix: it keeps N hypotheses of the drone's
+    * position and velocity and weighs every one of them by how well it
+    * explains each range as it arrives.
+    *
+    * The range model is heavy tailed and skewed (Cauchy shaped, range_sigma_m
+    * wide for ranges shorter than the particle's distance and multipath_sigma_m
+    * for longer ones, plus a floor for garbage), so a reflection costs the
+    * right hypothesis little. A presence=false reading counts too: a radar
+    * that sees nothing makes the hypotheses inside its detection window less
+    * likely.
+    *
+    * Particles are stored as structure-of-arrays and the weighting kernel is
+    * scalar, SSE2 or AVX2 like BatchMultilateration's. Above MIN_CHUNK
+    * particles per thread an update is split into chunks run by a few helper
+    * threads owned by the filter, fork-join, with the calling thread doing
+    * the first chunk. When the effective sample size drops below
+    * resample_threshold of N, systematic resampling draws the next set, in
+    * parallel as well: every chunk knows from the prefix of the chunk weights
+    * which output slots its particles fill.
+    *
+    * update() and miss() are serialized by a mutex, estimate() only reads a
+    * seqlock snapshot and never waits on an update.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BatchMultilateration.h"
+#include "IngestSource.h"
+#include "SensorModel.h"
+#include "SensorRegistry.h"
+#include "SeqLock.h"
+#include "SpinParkWaiter.h"
+
+struct ParticleFilterConfig {
+    size_t particles = 4096;
+    // Threads an update is spread over, the caller included, 0 for one per core.
+    size_t threads = 1;
+    // Standard deviation of the unmodelled acceleration, m/s^2. Higher than TrackFilterConfig::process_noise,
+    // a cloud that resampled down to a few hypotheses has to keep up with a turning drone.
+    double process_noise = 10.0;
+    // Position jitter added to every particle after resampling, so copies of one particle drift apart.
+    double roughening_m = 0.02;
+    double range_sigma_m = 0.1;
+    double multipath_sigma_m = 1.0;
+    // Likelihood every particle keeps whatever a range says, relative to an exact match.
+    double outlier_floor = 0.02;
+    // Radar detection window (C4001 defaults) and how likely a drone inside it goes unseen.
+    double min_range_m = 0.6;
+    double max_range_m = 12.0;
+    double miss_probability = 0.3;
+    double resample_threshold = 0.5;
+    // Particles start spread over the sensors' bounding box grown by this much.
+    double margin_m = 2.0;
+    // After a gap this long without readings the particles are spread out again.
+    double max_coast_s = 2.0;
+    uint64_t seed = 1;
+    SimdLevel simd = detect_simd_level();
+};
+
+/**
+    * @struct ParticleEstimate
+    * @brief Weighted mean and spread of the particles after an update.
+*/
+struct ParticleEstimate {
+    Point position;
+    Point velocity;
+    double position_sigma = 0.0;    // per axis, in meters
+    double effective_fraction = 0.0; // effective sample size over N, after the update
+    IngestClock::time_point at;
+    uint64_t updates = 0;
+    uint64_t resamples = 0;
+    bool valid = false;
+};
+
+class ParticleFilter {
+    public:
+        // Fewer particles than this per thread are not worth waking a helper for.
+        static constexpr size_t MIN_CHUNK = 4096;
+
+        // Weighted sums over the particles, what the estimate and the resampling need.
+        struct Sums {
+            double w = 0.0, w2 = 0.0;
+            double wx = 0.0, wy = 0.0, wxx = 0.0, wyy = 0.0;
+            double wvx = 0.0, wvy = 0.0;
+        };
+
+    // --- Private var declaration to be used ---
+    private:
+        static constexpr size_t NOISE_TABLE = size_t(1) << 16;
+
+        enum class Phase : uint8_t {
+            Range,
+            Miss,
+            Resample
+        };
+
+        struct alignas(CACHE_LINE_SIZE) Helper {
+            std::thread thread;
+            SpinParkWaiter waiter;
+            std::atomic<uint64_t> posted{0};
+        };
+
+        // What every chunk of one phase works from, written by the caller before the helpers are woken.
+        struct Job {
+            Phase phase = Phase::Range;
+            double dt = 0.0;
+            Point sensor{0.0, 0.0};
+            double range = 0.0;
+            double scale = 1.0;
+            double roughen = 0.0;
+            // Per chunk: noise table offsets, and for resampling where its output slots start.
+            std::vector<size_t> noise_offset;
+            std::vector<double> cumulative;
+            std::vector<size_t> first_out;
+            double step = 0.0;
+            double u0 = 0.0;
+        };
+
+        ParticleFilterConfig config_;
+        size_t count_;
+        size_t chunks_;
+        std::vector<double> x_, y_, vx_, vy_, w_;
+        // Resampling writes the next generation here, then the two sets are swapped.
+        std::vector<double> next_x_, next_y_, next_vx_, next_vy_, next_w_;
+        std::vector<double> noise_;
+        std::vector<Sums> chunk_sums_;
+
+        std::mutex update_mutex_;
+        std::vector<Point> sensor_of_handle_;
+        Point area_min_{0.0, 0.0};
+        Point area_max_{0.0, 0.0};
+        uint64_t rng_;
+        double weight_scale_ = 1.0;
+        bool started_ = false;
+        IngestClock::time_point last_update_;
+        uint64_t updates_ = 0;
+        uint64_t resamples_ = 0;
+        SeqLock<ParticleEstimate> snapshot_;
+
+        Job job_;
+        std::vector<std::unique_ptr<Helper>> helpers_;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> remaining_{0};
+        std::atomic<bool> stop_{false};
+
+        uint64_t next_random();
+        double uniform() { return static_cast<double>(next_random() >> 11) * 0x1.0p-53; }
+        void spread();
+        bool known(SensorHandle sensor) const;
+        void advance(IngestClock::time_point received_at);
+        void weigh(Phase phase, const Point& sensor, double range);
+        void resample();
+        void run_phase();
+        void run_chunk(size_t chunk);
+        void helper_loop(size_t index);
+        size_t chunk_begin(size_t chunk) const { return count_ * chunk / chunks_; }
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @brief Sensors are "<esp_id>/<sensor_id>" to position, as for DroneTracker.
+            * Throws std::runtime_error for no particles or no sensors.
+        */
+        ParticleFilter(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry,
+                       ParticleFilterConfig config = {});
+        ~ParticleFilter();
+
+        ParticleFilter(const ParticleFilter&) = delete;
+        ParticleFilter& operator=(const ParticleFilter&) = delete;
+
+        // Folds in one range of a sensor, readings of unknown sensors are ignored. Thread-safe.
+        void update(SensorHandle sensor, double range, IngestClock::time_point received_at);
+        // The sensor reported no target. Thread-safe.
+        void miss(SensorHandle sensor, IngestClock::time_point received_at);
+
+        // Replaces the sensor positions, e.g. after a geometry reload. The particles are kept.
+        void set_sensors(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry);
+
+        // State after the last update. Never blocks.
+        ParticleEstimate estimate() const { return snapshot_.load(); }
+
+        size_t particles() const { return count_; }
+        size_t threads() const { return chunks_; }
+        const ParticleFilterConfig& config() const { return config_; }
+
+        /**
+            * @brief The weighting kernel alone, exposed for the benchmark and its checks.
+            *
+            * Multiplies w[i] by scale and the likelihood of range for the particle
+            * at (x[i], y[i]) and a sensor at sensor, and returns the weighted sums
+            * over the particles after the update.
+        */
+        static Sums weigh_range(const double* x, const double* y, const double* vx, const double* vy, double* w,
+                                size_t count, const Point& sensor, double range, double scale,
+                                const ParticleFilterConfig& config, SimdLevel level);
+};
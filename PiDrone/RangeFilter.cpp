@@ -0,0 +1,126 @@
+/**
+    * @file RangeFilter.cpp
+    * @brief Sorted windows, Hampel gate and smoothing of per-sensor ranges.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "RangeFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+// --- End Imports ---
+
+namespace {
+
+// Consistency constant, makes the MAD an estimate of sigma for Gaussian noise.
+constexpr double MAD_SCALE = 1.4826;
+
+size_t clamp_window(size_t n) {
+    return n < 1 ? 1 : n > MAX_FILTER_WINDOW ? MAX_FILTER_WINDOW : n;
+}
+
+}
+
+SortedWindow::SortedWindow(size_t capacity) : capacity_(clamp_window(capacity)) {}
+
+void SortedWindow::push(double value) {
+    if (size_ == capacity_) {
+        const double evicted = arrival_[oldest_];
+        double* at = std::lower_bound(sorted_, sorted_ + size_, evicted);
+        std::memmove(at, at + 1, static_cast<size_t>(sorted_ + size_ - at - 1) * sizeof(double));
+        --size_;
+        arrival_[oldest_] = value;
+        oldest_ = oldest_ + 1 == capacity_ ? 0 : oldest_ + 1;
+    } else {
+        arrival_[(oldest_ + size_) % capacity_] = value;
+    }
+    double* at = std::upper_bound(sorted_, sorted_ + size_, value);
+    std::memmove(at + 1, at, static_cast<size_t>(sorted_ + size_ - at) * sizeof(double));
+    *at = value;
+    ++size_;
+}
+
+double SortedWindow::median() const {
+    const size_t mid = size_ / 2;
+    return size_ % 2 ? sorted_[mid] : 0.5 * (sorted_[mid - 1] + sorted_[mid]);
+}
+
+/**
+    * The deviations left of the median grow towards the front of the sorted
+    * array and those right of it towards the back, so merging the two runs
+    * from the middle outwards yields the deviations in increasing order and
+    * the MAD is found after about half the window.
+*/
+double SortedWindow::mad() const {
+    const double m = median();
+    // left is the next element at or below the median going down, right the next one above it.
+    size_t right = static_cast<size_t>(std::upper_bound(sorted_, sorted_ + size_, m) - sorted_);
+    ptrdiff_t left = static_cast<ptrdiff_t>(right) - 1;
+    auto next = [&]() {
+        const bool take_left = left >= 0 && (right >= size_ || m - sorted_[left] <= sorted_[right] - m);
+        return take_left ? m - sorted_[left--] : sorted_[right++] - m;
+    };
+    const size_t mid = size_ / 2;
+    double d = 0.0;
+    for (size_t i = 0; i < mid; ++i) d = next();
+    const double upper = next();
+    return size_ % 2 ? upper : 0.5 * (d + upper);
+}
+
+RangeFilter::RangeFilter(const RangeFilterConfig& config)
+    : config_(config), hampel_window_(config.hampel_window), median_window_(config.median_window) {}
+
+void RangeFilter::reset() {
+    hampel_window_.clear();
+    median_window_.clear();
+    has_ewma_ = false;
+}
+
+std::optional<double> RangeFilter::update(const SensorData& reading) {
+    if (config_.require_presence && !reading.presence) {
+        ++rejected_;
+        return std::nullopt;
+    }
+
+    if (has_last_ && (reading.timestamp_ms < last_timestamp_ms_
+                      || reading.timestamp_ms - last_timestamp_ms_ > config_.reset_gap_ms)) {
+        reset();
+    }
+    has_last_ = true;
+    last_timestamp_ms_ = reading.timestamp_ms;
+
+    double range = reading.range;
+    if (config_.hampel) {
+        // Judged against the window before this reading. It goes into the window either way,
+        // a target that really moved becomes the new median after half a window.
+        bool outlier = false;
+        if (hampel_window_.size() >= 3) {
+            const double threshold = std::max(config_.hampel_k * MAD_SCALE * hampel_window_.mad(),
+                                              config_.hampel_min_deviation_m);
+            outlier = std::fabs(range - hampel_window_.median()) > threshold;
+        }
+        hampel_window_.push(range);
+        if (outlier) {
+            ++rejected_;
+            return std::nullopt;
+        }
+    }
+
+    switch (config_.smoothing) {
+        case RangeSmoothing::Ewma:
+            ewma_ = has_ewma_ ? config_.ewma_alpha * range + (1.0 - config_.ewma_alpha) * ewma_ : range;
+            has_ewma_ = true;
+            range = ewma_;
+            break;
+        case RangeSmoothing::Median:
+            median_window_.push(range);
+            range = median_window_.median();
+            break;
+        case RangeSmoothing::None:
+            break;
+    }
+    ++accepted_;
+    return range;
+}
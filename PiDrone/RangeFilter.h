@@ -0,0 +1,124 @@
+/**
+    * @file RangeFilter.h
+    * @brief Per-sensor outlier rejection and smoothing of ranges before they reach the DroneTracker.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The C4001 and LD2412 ranges are noisy and now and then jump by meters
+    * for a single reading (multipath, a second reflector). Fed straight into
+    * the solver, one such reading moves the fix by about as much. A
+    * RangeFilter sits in the NodeManager between decoding and the tracker
+    * update, one per sensor, and either passes a (possibly smoothed) range on
+    * or rejects the reading, in which case no solve is triggered at all.
+    *
+    * The stages, each optional and applied in this order:
+    *   - presence gate: drop readings in which the sensor saw no target
+    *   - Hampel gate: reject a range more than k scaled MADs away from the
+    *     median of the last readings
+    *   - smoothing: exponentially weighted moving average, or median of the
+    *     last N readings
+    *
+    * Windows are a few readings long and kept sorted, an update is a binary
+    * search plus a move of at most MAX_FILTER_WINDOW doubles.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "SensorModel.h"
+
+constexpr size_t MAX_FILTER_WINDOW = 31;
+
+enum class RangeSmoothing {
+    None,
+    Ewma,
+    Median
+};
+
+struct RangeFilterConfig {
+    // A reading flagged as no target carries no usable range.
+    bool require_presence = false;
+
+    bool hampel = false;
+    size_t hampel_window = 7;
+    // Threshold in scaled MADs (1.4826 * MAD estimates the standard deviation of Gaussian noise).
+    double hampel_k = 3.0;
+    // Floor on the threshold in meters. The sensors report whole centimeters so the MAD is often zero,
+    // and the ranges of a moving target run ahead of the window median.
+    double hampel_min_deviation_m = 0.25;
+
+    RangeSmoothing smoothing = RangeSmoothing::None;
+    double ewma_alpha = 0.4;   // weight of the newest reading
+    size_t median_window = 5;
+
+    // Windows start over after a gap this long, or when the node's clock goes backwards (reboot).
+    long long reset_gap_ms = 2000;
+};
+
+/**
+    * @class SortedWindow
+    * @brief The last n values both in arrival order and sorted, for running medians.
+*/
+class SortedWindow {
+    // --- Private var declaration to be used ---
+    private:
+        double arrival_[MAX_FILTER_WINDOW];
+        double sorted_[MAX_FILTER_WINDOW];
+        size_t capacity_;
+        size_t size_ = 0;
+        size_t oldest_ = 0;
+
+    // --- Public method declarations ---
+    public:
+        // capacity is clamped to [1, MAX_FILTER_WINDOW].
+        explicit SortedWindow(size_t capacity);
+
+        // Adds value, evicting the oldest one once the window is full.
+        void push(double value);
+        void clear() { size_ = 0; oldest_ = 0; }
+
+        size_t size() const { return size_; }
+        bool full() const { return size_ == capacity_; }
+
+        // Undefined on an empty window.
+        double median() const;
+        // Median absolute deviation from median(), by walking outwards from the middle.
+        double mad() const;
+};
+
+/**
+    * @class RangeFilter
+    * @brief Streaming filter for the ranges of one sensor, see the file comment.
+    *
+    * Not thread-safe, a sensor's readings are only ever processed by the run()
+    * of its NodeManager.
+*/
+class RangeFilter {
+    // --- Private var declaration to be used ---
+    private:
+        RangeFilterConfig config_;
+        SortedWindow hampel_window_;
+        SortedWindow median_window_;
+        double ewma_ = 0.0;
+        bool has_ewma_ = false;
+        bool has_last_ = false;
+        long long last_timestamp_ms_ = 0;
+        uint64_t accepted_ = 0;
+        uint64_t rejected_ = 0;
+
+        void reset();
+
+    // --- Public method declarations ---
+    public:
+        explicit RangeFilter(const RangeFilterConfig& config = {});
+
+        // Range to hand to the tracker, or nullopt if the reading is rejected.
+        std::optional<double> update(const SensorData& reading);
+
+        uint64_t accepted() const { return accepted_; }
+        uint64_t rejected() const { return rejected_; }
+};
@@ -0,0 +1,61 @@
+/**
+    * @file ReplayIngestSource.cpp
+    * @brief Loads a capture file and replays it either paced or as fast as possible.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "ReplayIngestSource.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+// --- End Imports ---
+
+ReplayIngestSource::ReplayIngestSource(const std::string& path, double speed, size_t loops)
+    : speed_(speed), loops_(loops) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("cannot open capture file: " + path);
+    }
+
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        long long offset_ms;
+        Entry entry;
+        if (!(fields >> offset_ms >> entry.topic)) {
+            throw std::runtime_error(path + ":" + std::to_string(line_no) + ": malformed capture line");
+        }
+        fields >> std::ws;
+        std::getline(fields, entry.payload);
+        entry.offset = std::chrono::milliseconds(offset_ms);
+        entries_.push_back(std::move(entry));
+    }
+}
+
+ReplayIngestSource::~ReplayIngestSource() {
+    stop();
+    join();
+}
+
+bool ReplayIngestSource::run(const IngestHandler& handler) {
+    for (size_t loop = 0; loop < loops_ && !stop_requested(); ++loop) {
+        const auto loop_start = IngestClock::now();
+
+        for (const auto& entry : entries_) {
+            if (stop_requested()) return true;
+
+            if (speed_ > 0.0) {
+                auto due = loop_start + std::chrono::duration_cast<IngestClock::duration>(entry.offset / speed_);
+                std::this_thread::sleep_until(due);
+            }
+            handler(IngestMessage{entry.topic, entry.payload, IngestClock::now()});
+        }
+    }
+    return true;
+}
@@ -0,0 +1,53 @@
+/**
+    * @file ReplayIngestSource.h
+    * @brief IngestSource that replays a recorded capture file in-process.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The capture format is plain text, one message per line:
+    *
+    *     <offset_ms> <topic> <payload...>
+    *
+    * offset_ms is the receive time relative to the start of the capture, the
+    * payload runs to the end of the line. Empty lines and lines starting with
+    * '#' are ignored. The whole file is loaded up front so replay speed is not
+    * limited by disk I/O.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <string>
+#include <vector>
+#include <chrono>
+#include "IngestSource.h"
+
+class ReplayIngestSource : public ThreadedIngestSource {
+    // --- Private var declaration to be used ---
+    private:
+        struct Entry {
+            std::chrono::milliseconds offset;
+            std::string topic;
+            std::string payload;
+        };
+
+        std::vector<Entry> entries_;
+        double speed_;
+        size_t loops_;
+
+    protected:
+        bool run(const IngestHandler& handler) override;
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @param path Capture file to load, throws std::runtime_error if it cannot be read
+            * @param speed Replay speed relative to the recording, 0 replays as fast as possible
+            * @param loops How many times to replay the capture
+        */
+        ReplayIngestSource(const std::string& path, double speed = 0.0, size_t loops = 1);
+        ~ReplayIngestSource() override;
+
+        size_t size() const { return entries_.size(); }
+};
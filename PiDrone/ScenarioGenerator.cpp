@@ -0,0 +1,293 @@
+/**
+    * @file ScenarioGenerator.cpp
+    * @brief Trajectories, the radar model and payload formatting of the scenario generator.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "ScenarioGenerator.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+// --- End Imports ---
+
+namespace {
+
+// Appends v with three decimals, millimeters are finer than any radar resolves.
+char* write_fixed3(char* p, char* end, double v) {
+    long long milli = std::llround(v * 1000.0);
+    if (milli < 0) {
+        *p++ = '-';
+        milli = -milli;
+    }
+    p = std::to_chars(p, end, milli / 1000).ptr;
+    const int fraction = static_cast<int>(milli % 1000);
+    p[0] = '.';
+    p[1] = static_cast<char>('0' + fraction / 100);
+    p[2] = static_cast<char>('0' + fraction / 10 % 10);
+    p[3] = static_cast<char>('0' + fraction % 10);
+    return p + 4;
+}
+
+char* write_text(char* p, const char* text) {
+    while (*text) *p++ = *text++;
+    return p;
+}
+
+Point read_point(const nlohmann::json& j) {
+    if (!j.is_array() || j.size() != 2) throw std::runtime_error("points are written as [x, y]");
+    return {j[0].get<double>(), j[1].get<double>()};
+}
+
+} // namespace
+
+ScenarioConfig ScenarioConfig::ring(size_t nodes, size_t sensors_per_node, size_t drones, double radius_m) {
+    ScenarioConfig config;
+    const Point center{(config.area_min.x + config.area_max.x) / 2.0, (config.area_min.y + config.area_max.y) / 2.0};
+    for (size_t n = 0; n < nodes; ++n) {
+        const double angle = 2.0 * M_PI * static_cast<double>(n) / static_cast<double>(nodes);
+        ScenarioNode node;
+        node.esp_id = "esp32_" + std::to_string(n + 1);
+        // Nodes boot at different times and their crystals disagree by a few tens of ppm.
+        node.clock_offset_ms = static_cast<long long>(n) * 7919 % 60000;
+        node.clock_drift_ppm = static_cast<double>(static_cast<long long>(n) * 37 % 81 - 40);
+        for (size_t s = 0; s < sensors_per_node; ++s) {
+            node.sensors.push_back({"radar_" + std::to_string(s + 1),
+                                    {center.x + radius_m * std::cos(angle) + 0.1 * static_cast<double>(s),
+                                     center.y + radius_m * std::sin(angle)}});
+        }
+        config.nodes.push_back(std::move(node));
+    }
+    for (size_t d = 0; d < drones; ++d) {
+        ScenarioDrone drone;
+        drone.random = true;
+        config.drones.push_back(drone);
+    }
+    return config;
+}
+
+std::map<std::string, Point> ScenarioConfig::sensor_positions() const {
+    std::map<std::string, Point> positions;
+    for (const ScenarioNode& node : nodes) {
+        for (const ScenarioSensor& sensor : node.sensors) positions[node.esp_id + "/" + sensor.id] = sensor.position;
+    }
+    return positions;
+}
+
+std::vector<ZoneConfig> ScenarioConfig::zones() const {
+    std::vector<ZoneConfig> result;
+    for (const ScenarioNode& node : nodes) {
+        const std::string name = node.zone.empty() ? "site" : node.zone;
+        auto zone = std::find_if(result.begin(), result.end(), [&](const ZoneConfig& z) { return z.name == name; });
+        if (zone == result.end()) {
+            result.push_back(ZoneConfig{name, {}});
+            zone = result.end() - 1;
+        }
+        for (const ScenarioSensor& sensor : node.sensors) zone->sensor_positions[node.esp_id + "/" + sensor.id] = sensor.position;
+    }
+    return result;
+}
+
+ScenarioConfig load_scenario(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("Cannot open scenario " + path);
+
+    ScenarioConfig config;
+    try {
+        const nlohmann::json j = nlohmann::json::parse(file);
+        config.sample_hz = j.value("sample_hz", config.sample_hz);
+        config.range_noise_m = j.value("range_noise_m", config.range_noise_m);
+        config.speed_noise_mps = j.value("speed_noise_mps", config.speed_noise_mps);
+        config.dropout = j.value("dropout", config.dropout);
+        config.min_range_m = j.value("min_range_m", config.min_range_m);
+        config.max_range_m = j.value("max_range_m", config.max_range_m);
+        config.duration_s = j.value("duration_s", config.duration_s);
+        config.seed = j.value("seed", config.seed);
+        config.base_topic = j.value("base_topic", config.base_topic);
+
+        const std::string format = j.value("format", std::string("json"));
+        if (format == "binary") config.format = PayloadFormat::Binary;
+        else if (format != "json") throw std::runtime_error("format must be \"json\" or \"binary\"");
+
+        if (j.contains("area")) {
+            const nlohmann::json& area = j.at("area");
+            if (!area.is_array() || area.size() != 2) throw std::runtime_error("area is written as [[x0, y0], [x1, y1]]");
+            config.area_min = read_point(area[0]);
+            config.area_max = read_point(area[1]);
+        }
+
+        for (const auto& n : j.at("nodes")) {
+            ScenarioNode node;
+            node.esp_id = n.at("esp_id").get<std::string>();
+            node.clock_offset_ms = n.value("clock_offset_ms", node.clock_offset_ms);
+            node.clock_drift_ppm = n.value("clock_drift_ppm", node.clock_drift_ppm);
+            node.zone = n.value("zone", node.zone);
+            for (const auto& s : n.at("sensors")) {
+                node.sensors.push_back({s.at("id").get<std::string>(), {s.at("x").get<double>(), s.at("y").get<double>()}});
+            }
+            config.nodes.push_back(std::move(node));
+        }
+
+        for (const auto& d : j.value("drones", nlohmann::json::array())) {
+            ScenarioDrone drone;
+            drone.random = d.value("random", false);
+            drone.speed_mps = d.value("speed_mps", drone.speed_mps);
+            for (const auto& p : d.value("waypoints", nlohmann::json::array())) {
+                drone.waypoints.push_back(read_point(p));
+            }
+            config.drones.push_back(std::move(drone));
+        }
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Invalid scenario " + path + ": " + e.what());
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error("Invalid scenario " + path + ": " + e.what());
+    }
+    return config;
+}
+
+ScenarioGenerator::ScenarioGenerator(ScenarioConfig config)
+    : config_(std::move(config)), rng_(config_.seed) {
+    if (!(config_.sample_hz > 0.0)) throw std::runtime_error("Scenario sample_hz must be positive");
+    if (config_.dropout < 0.0 || config_.dropout >= 1.0) throw std::runtime_error("Scenario dropout must be in [0, 1)");
+    if (config_.range_noise_m < 0.0 || config_.speed_noise_mps < 0.0) throw std::runtime_error("Scenario noise must not be negative");
+    if (config_.format != PayloadFormat::Json && config_.format != PayloadFormat::Binary) {
+        throw std::runtime_error("Scenario payloads are JSON or binary");
+    }
+
+    for (size_t n = 0; n < config_.nodes.size(); ++n) {
+        for (const ScenarioSensor& sensor : config_.nodes[n].sensors) {
+            Radar radar;
+            radar.topic = config_.base_topic + "/" + config_.nodes[n].esp_id + "/" + sensor.id;
+            radar.position = sensor.position;
+            radar.node = n;
+            radars_.push_back(std::move(radar));
+        }
+    }
+    if (radars_.empty()) throw std::runtime_error("Scenario has no sensors");
+
+    for (const ScenarioDrone& drone : config_.drones) {
+        Trajectory t;
+        t.speed = drone.speed_mps;
+        t.points = drone.waypoints;
+        if (drone.random) {
+            std::uniform_real_distribution<double> x(config_.area_min.x, config_.area_max.x);
+            std::uniform_real_distribution<double> y(config_.area_min.y, config_.area_max.y);
+            for (size_t i = 0; i < RANDOM_WAYPOINTS; ++i) t.points.push_back({x(rng_), y(rng_)});
+        }
+        if (t.points.empty()) throw std::runtime_error("Scenario drone has neither waypoints nor random set");
+        t.distance.push_back(0.0);
+        for (size_t i = 0; i < t.points.size(); ++i) {
+            const Point& a = t.points[i];
+            const Point& b = t.points[(i + 1) % t.points.size()];
+            t.length += std::hypot(b.x - a.x, b.y - a.y);
+            t.distance.push_back(t.length);
+        }
+        trajectories_.push_back(std::move(t));
+    }
+}
+
+void ScenarioGenerator::position_and_velocity(size_t drone, double t_s, Point& position, Point& velocity) const {
+    const Trajectory& t = trajectories_[drone];
+    velocity = {0.0, 0.0};
+    if (t.length <= 0.0 || t.speed <= 0.0) {
+        position = t.points.front();
+        return;
+    }
+    const double along = std::fmod(t_s * t.speed, t.length);
+    // distance has one entry per point plus the closing one, find the segment that contains along.
+    size_t i = static_cast<size_t>(std::upper_bound(t.distance.begin(), t.distance.end(), along) - t.distance.begin()) - 1;
+    if (i >= t.points.size()) i = t.points.size() - 1;
+    const Point& a = t.points[i];
+    const Point& b = t.points[(i + 1) % t.points.size()];
+    const double segment = t.distance[i + 1] - t.distance[i];
+    const double f = segment > 0.0 ? (along - t.distance[i]) / segment : 0.0;
+    position = {a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f};
+    if (segment > 0.0) velocity = {(b.x - a.x) / segment * t.speed, (b.y - a.y) / segment * t.speed};
+}
+
+Point ScenarioGenerator::drone_position(size_t drone, double t_s) const {
+    Point position, velocity;
+    position_and_velocity(drone, t_s, position, velocity);
+    return position;
+}
+
+/**
+    * Steps through the radar samples until one results in a message: a
+    * detection, or the loss of one. Samples without a target and messages
+    * picked by the dropout are skipped, so next() may take many samples
+    * while nothing is in range.
+*/
+bool ScenarioGenerator::next(IngestMessage& msg) {
+    const double period = 1.0 / config_.sample_hz;
+    const double radar_count = static_cast<double>(radars_.size());
+    for (;;) {
+        const size_t index = static_cast<size_t>(tick_ % radars_.size());
+        const double t = static_cast<double>(tick_ / radars_.size()) * period + static_cast<double>(index) / radar_count * period;
+        if (config_.duration_s > 0.0 && t >= config_.duration_s) return false;
+        ++tick_;
+
+        Radar& radar = radars_[index];
+        double best = std::numeric_limits<double>::infinity();
+        double rate = 0.0;
+        for (size_t d = 0; d < trajectories_.size(); ++d) {
+            Point p, v;
+            position_and_velocity(d, t, p, v);
+            const double dx = p.x - radar.position.x, dy = p.y - radar.position.y;
+            const double range = std::sqrt(dx * dx + dy * dy);
+            if (range < config_.min_range_m || range > config_.max_range_m || range >= best) continue;
+            best = range;
+            rate = range > 0.0 ? (dx * v.x + dy * v.y) / range : 0.0;
+        }
+        const bool present = best != std::numeric_limits<double>::infinity();
+        if (!present && !radar.present) continue;
+        radar.present = present;
+
+        // A lost message still used up its sequence number on the node.
+        const uint32_t sequence = radar.sequence++;
+        if (config_.dropout > 0.0 && uniform_(rng_) < config_.dropout) {
+            ++dropped_;
+            continue;
+        }
+
+        const ScenarioNode& node = config_.nodes[radar.node];
+        SensorData reading;
+        reading.presence = present;
+        reading.timestamp_ms = node.clock_offset_ms + std::llround(t * 1000.0 * (1.0 + node.clock_drift_ppm * 1e-6));
+        if (present) {
+            reading.range = std::max(0.0, best + noise_(rng_) * config_.range_noise_m);
+            reading.speed = rate + noise_(rng_) * config_.speed_noise_mps;
+        }
+        reading.sequence = sequence;
+        reading.sensor_type = SensorType::C4001;
+
+        msg.topic = radar.topic;
+        format_payload(reading, msg.payload);
+        time_s_ = t;
+        ++generated_;
+        return true;
+    }
+}
+
+// The firmware's JSON: presence and ts always, range and speed only while present.
+void ScenarioGenerator::format_payload(const SensorData& reading, std::string& out) const {
+    if (config_.format == PayloadFormat::Binary) {
+        out = reading.to_binary();
+        return;
+    }
+    char buffer[96];
+    char* const end = buffer + sizeof(buffer);
+    char* p = write_text(buffer, reading.presence ? "{\"presence\":true,\"ts\":" : "{\"presence\":false,\"ts\":");
+    p = std::to_chars(p, end, reading.timestamp_ms).ptr;
+    if (reading.presence) {
+        p = write_text(p, ",\"range\":");
+        p = write_fixed3(p, end, reading.range);
+        p = write_text(p, ",\"speed\":");
+        p = write_fixed3(p, end, reading.speed);
+    }
+    *p++ = '}';
+    out.assign(buffer, static_cast<size_t>(p - buffer));
+}
@@ -0,0 +1,177 @@
+/**
+    * @file ScenarioGenerator.h
+    * @brief Synthetic sensor traffic for a simulated site: nodes, radars and flying drones.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Simulates N ESP32 nodes with M radars each at known positions and one or
+    * more drones flying scripted (waypoint) or random trajectories, and turns
+    * that into the messages the nodes would publish: the same
+    * "drones/data/<esp_id>/<sensor_id>" topics and the same JSON (or binary)
+    * payloads as the firmware, with range and speed noise, lost messages and
+    * per-node clocks (every node stamps readings with its own millis(), which
+    * starts at a different time and drifts).
+    *
+    * A radar reports the nearest drone inside its detection window. Like the
+    * firmware it only publishes while something is present, plus one
+    * presence=false message when the target is lost. Every radar samples at
+    * sample_hz, the sensors are spread evenly over the sample period so the
+    * messages come out in time order.
+    *
+    * The drone positions are a pure function of time (drone_position()), so
+    * the ground truth can be written next to the traffic or looked up later
+    * to score the tracker's fixes.
+    *
+    * Scenarios are described in JSON, see load_scenario():
+    *
+    *   {
+    *     "sample_hz": 20, "range_noise_m": 0.05, "speed_noise_mps": 0.05,
+    *     "dropout": 0.01, "min_range_m": 0.6, "max_range_m": 12,
+    *     "duration_s": 60, "seed": 1, "format": "json",
+    *     "area": [[0, 0], [10, 10]],
+    *     "nodes": [
+    *       {"esp_id": "esp32_1", "clock_offset_ms": 1200, "clock_drift_ppm": 40, "zone": "north",
+    *        "sensors": [{"id": "radar_A", "x": 0, "y": 0}]}
+    *     ],
+    *     "drones": [
+    *       {"waypoints": [[2, 2], [8, 2], [8, 6]], "speed_mps": 2},
+    *       {"random": true, "speed_mps": 4}
+    *     ]
+    *   }
+    *
+    * Nodes may name the zone their sensors belong to, nodes without one are
+    * all in one zone, see zones().
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "IngestSource.h"
+#include "SensorModel.h"
+#include "ZonedTracker.h"
+
+struct ScenarioSensor {
+    std::string id;
+    Point position;
+};
+
+struct ScenarioNode {
+    std::string esp_id;
+    std::vector<ScenarioSensor> sensors;
+    long long clock_offset_ms = 0; // the node's millis() at simulation time 0
+    double clock_drift_ppm = 0.0;  // how much faster the node's clock runs
+    std::string zone;
+};
+
+/**
+    * A drone flies along its waypoints at a constant speed and returns to the
+    * first one after the last, forever. A single waypoint is a hovering drone.
+    * A random drone gets RANDOM_WAYPOINTS waypoints drawn inside the area.
+*/
+struct ScenarioDrone {
+    std::vector<Point> waypoints;
+    bool random = false;
+    double speed_mps = 2.0;
+};
+
+struct ScenarioConfig {
+    std::vector<ScenarioNode> nodes;
+    std::vector<ScenarioDrone> drones;
+    double sample_hz = 20.0;        // per radar
+    double range_noise_m = 0.05;    // standard deviation
+    double speed_noise_mps = 0.05;  // standard deviation
+    double dropout = 0.0;           // probability that a message is lost
+    double min_range_m = 0.6;       // detection window of the radar, C4001 defaults
+    double max_range_m = 12.0;
+    double duration_s = 0.0;        // 0 runs forever
+    Point area_min{0.0, 0.0};       // where random drones fly
+    Point area_max{10.0, 10.0};
+    uint64_t seed = 1;
+    PayloadFormat format = PayloadFormat::Json;
+    std::string base_topic = "drones/data";
+
+    // "<esp_id>/<sensor_id>" to position, what DroneTracker is built from.
+    std::map<std::string, Point> sensor_positions() const;
+
+    // The sensors grouped by the zone of their node, in order of first appearance, what ZonedTracker is built from.
+    std::vector<ZoneConfig> zones() const;
+
+    /**
+        * nodes nodes evenly spaced on a circle of radius_m around the center of
+        * the area, sensors_per_node radars each 10 cm apart, and drones random
+        * drones. Nodes are named esp32_1.., radars radar_1.., the layout used by
+        * the benchmarks to size a site.
+    */
+    static ScenarioConfig ring(size_t nodes, size_t sensors_per_node, size_t drones, double radius_m = 5.0);
+};
+
+// Reads a scenario as documented above, throws std::runtime_error if it cannot be read or is invalid.
+ScenarioConfig load_scenario(const std::string& path);
+
+class ScenarioGenerator {
+    public:
+        static constexpr size_t RANDOM_WAYPOINTS = 256;
+
+    // --- Private var declaration to be used ---
+    private:
+        struct Trajectory {
+            std::vector<Point> points;
+            std::vector<double> distance; // along the closed path, at every point
+            double length = 0.0;
+            double speed = 0.0;
+        };
+
+        struct Radar {
+            std::string topic;
+            Point position;
+            size_t node = 0;
+            uint32_t sequence = 0;
+            bool present = false;
+        };
+
+        ScenarioConfig config_;
+        std::vector<Trajectory> trajectories_;
+        std::vector<Radar> radars_;
+        std::mt19937_64 rng_;
+        std::normal_distribution<double> noise_{0.0, 1.0};
+        std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+
+        uint64_t tick_ = 0;  // radar samples taken so far, tick_ % radars is the next radar
+        double time_s_ = 0.0;
+        uint64_t generated_ = 0;
+        uint64_t dropped_ = 0;
+
+        void position_and_velocity(size_t drone, double t_s, Point& position, Point& velocity) const;
+        void format_payload(const SensorData& reading, std::string& out) const;
+
+    // --- Public method declarations ---
+    public:
+        // Throws std::runtime_error if the scenario has no sensors or nonsensical parameters.
+        explicit ScenarioGenerator(ScenarioConfig config);
+
+        /**
+            * @brief Fills in the next message in time order.
+            *
+            * Sets topic and payload, the signature of GeneratorIngestSource::Generator.
+            * Returns false once duration_s has passed.
+        */
+        bool next(IngestMessage& msg);
+
+        // Simulation time of the message last returned by next(), in seconds.
+        double time_s() const { return time_s_; }
+
+        Point drone_position(size_t drone, double t_s) const;
+        size_t drone_count() const { return trajectories_.size(); }
+        size_t sensor_count() const { return radars_.size(); }
+
+        const ScenarioConfig& config() const { return config_; }
+        uint64_t generated() const { return generated_; }
+        // Messages lost on purpose, see ScenarioConfig::dropout.
+        uint64_t dropped() const { return dropped_; }
+};
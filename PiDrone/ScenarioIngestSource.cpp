@@ -0,0 +1,45 @@
+/**
+    * @file ScenarioIngestSource.cpp
+    * @brief Paced delivery of simulated traffic and its ground truth.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "ScenarioIngestSource.h"
+// --- End Imports ---
+
+ScenarioIngestSource::ScenarioIngestSource(ScenarioConfig config, double speed, TruthHandler on_truth, double truth_hz)
+    : generator_(std::move(config)), speed_(speed), on_truth_(std::move(on_truth)),
+      truth_period_s_(truth_hz > 0.0 ? 1.0 / truth_hz : 0.0) {}
+
+ScenarioIngestSource::~ScenarioIngestSource() {
+    stop();
+    join();
+}
+
+bool ScenarioIngestSource::run(const IngestHandler& handler) {
+    const auto start = IngestClock::now();
+    uint64_t truth_tick = 0;
+    while (!stop_requested()) {
+        IngestMessage msg;
+        if (!generator_.next(msg)) break;
+        const double t = generator_.time_s();
+
+        if (on_truth_ && truth_period_s_ > 0.0) {
+            for (; static_cast<double>(truth_tick) * truth_period_s_ <= t; ++truth_tick) {
+                const double truth_t = static_cast<double>(truth_tick) * truth_period_s_;
+                for (size_t d = 0; d < generator_.drone_count(); ++d) {
+                    on_truth_(truth_t, d, generator_.drone_position(d, truth_t));
+                }
+            }
+        }
+        if (speed_ > 0.0) {
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<IngestClock::duration>(
+                std::chrono::duration<double>(t / speed_)));
+        }
+        msg.received_at = IngestClock::now();
+        handler(std::move(msg));
+    }
+    return true;
+}
@@ -0,0 +1,50 @@
+/**
+    * @file ScenarioIngestSource.h
+    * @brief IngestSource that feeds the pipeline from a ScenarioGenerator, with ground truth.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Delivers the simulated messages in-process, at the simulated pace, N
+    * times faster or as fast as the pipeline takes them. While it runs it
+    * reports where every drone really is at truth_hz of simulated time,
+    * interleaved with the messages, so a fix can be compared with the truth
+    * that was current when its readings went in.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <functional>
+#include "IngestSource.h"
+#include "ScenarioGenerator.h"
+
+class ScenarioIngestSource : public ThreadedIngestSource {
+    public:
+        // Simulation time in seconds, drone index and its true position.
+        using TruthHandler = std::function<void(double, size_t, const Point&)>;
+
+    // --- Private var declaration to be used ---
+    private:
+        ScenarioGenerator generator_;
+        double speed_;
+        TruthHandler on_truth_;
+        double truth_period_s_;
+
+    protected:
+        bool run(const IngestHandler& handler) override;
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @param config Scenario to run, throws std::runtime_error if it is invalid
+            * @param speed Relative to simulated time, 1 is real time, 0 as fast as possible
+            * @param on_truth Called on the source's thread, before the messages of the same time
+            * @param truth_hz How often the truth is reported, in simulated time
+        */
+        ScenarioIngestSource(ScenarioConfig config, double speed = 1.0, TruthHandler on_truth = {}, double truth_hz = 10.0);
+        ~ScenarioIngestSource() override;
+
+        // Valid before start() and after join().
+        const ScenarioGenerator& generator() const { return generator_; }
+};
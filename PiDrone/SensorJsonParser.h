@@ -0,0 +1,237 @@
+/**
+    * @file SensorJsonParser.h
+    * @brief Streaming parser specialized for the sensor reading JSON schema.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Reads "range", "speed", "ts" and "presence" straight from the payload
+    * bytes, skipping every other key in place, without building a DOM and
+    * without allocating. It only accepts a conservative subset of JSON: a flat
+    * or nested object whose strings are plain ASCII without escapes. Anything
+    * else, including input the generic parser would reject, makes it return
+    * false so the caller can fall back to nlohmann::json and get exactly the
+    * result (or the exception) it would have got before.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+/**
+    * @struct SensorJsonFields
+    * @brief The known fields of a reading, each left untouched if its key is absent.
+*/
+struct SensorJsonFields {
+    double range = 0.0;
+    double speed = 0.0;
+    long long ts = 0;
+    bool presence = true;
+};
+
+class SensorJsonParser {
+    // --- Private var declaration to be used ---
+    private:
+        static constexpr int MAX_DEPTH = 16;
+
+        const char* p_;
+        const char* end_;
+
+        explicit SensorJsonParser(std::string_view text) : p_(text.data()), end_(text.data() + text.size()) {}
+
+        void skip_ws() {
+            while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) ++p_;
+        }
+
+        bool consume(char c) {
+            if (p_ < end_ && *p_ == c) {
+                ++p_;
+                return true;
+            }
+            return false;
+        }
+
+        // A string without escapes, control characters or non-ASCII bytes.
+        bool string(std::string_view& out) {
+            if (!consume('"')) return false;
+            const char* start = p_;
+            while (p_ < end_) {
+                const unsigned char c = static_cast<unsigned char>(*p_);
+                if (c == '"') {
+                    out = std::string_view(start, static_cast<size_t>(p_ - start));
+                    ++p_;
+                    return true;
+                }
+                if (c == '\\' || c < 0x20 || c >= 0x80) return false;
+                ++p_;
+            }
+            return false;
+        }
+
+        // Validates the JSON number grammar, out spans the number.
+        bool number(std::string_view& out, bool& integral) {
+            const char* start = p_;
+            integral = true;
+            consume('-');
+            if (p_ >= end_) return false;
+            if (*p_ == '0') {
+                ++p_;
+            } else if (*p_ >= '1' && *p_ <= '9') {
+                while (p_ < end_ && *p_ >= '0' && *p_ <= '9') ++p_;
+            } else {
+                return false;
+            }
+            if (consume('.')) {
+                integral = false;
+                if (p_ >= end_ || *p_ < '0' || *p_ > '9') return false;
+                while (p_ < end_ && *p_ >= '0' && *p_ <= '9') ++p_;
+            }
+            if (p_ < end_ && (*p_ == 'e' || *p_ == 'E')) {
+                integral = false;
+                ++p_;
+                if (!consume('+')) consume('-');
+                if (p_ >= end_ || *p_ < '0' || *p_ > '9') return false;
+                while (p_ < end_ && *p_ >= '0' && *p_ <= '9') ++p_;
+            }
+            out = std::string_view(start, static_cast<size_t>(p_ - start));
+            return true;
+        }
+
+        bool literal(const char* word) {
+            const size_t n = std::strlen(word);
+            if (static_cast<size_t>(end_ - p_) < n || std::memcmp(p_, word, n) != 0) return false;
+            p_ += n;
+            return true;
+        }
+
+        bool double_value(double& out) {
+            std::string_view text;
+            bool integral;
+            if (!number(text, integral)) return false;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            double value;
+            auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (result.ec != std::errc{} || result.ptr != text.data() + text.size()) return false;
+            // The generic parser reads "-0" as the integer 0, not as -0.0.
+            out = integral && value == 0.0 ? 0.0 : value;
+            return true;
+#else
+            // No correctly rounded double parsing available, leave it to the generic parser.
+            (void)integral;
+            return false;
+#endif
+        }
+
+        // Only plain integers that fit, fractional or huge timestamps go to the generic parser.
+        bool integer_value(long long& out) {
+            std::string_view text;
+            bool integral;
+            if (!number(text, integral) || !integral) return false;
+            long long value;
+            auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (result.ec != std::errc{} || result.ptr != text.data() + text.size()) return false;
+            out = value;
+            return true;
+        }
+
+        bool bool_value(bool& out) {
+            if (literal("true")) {
+                out = true;
+                return true;
+            }
+            if (literal("false")) {
+                out = false;
+                return true;
+            }
+            return false;
+        }
+
+        bool skip_value(int depth) {
+            if (depth > MAX_DEPTH || p_ >= end_) return false;
+            std::string_view ignored;
+            double number_ignored;
+            switch (*p_) {
+                case '"':
+                    return string(ignored);
+                case '{':
+                    ++p_;
+                    skip_ws();
+                    if (consume('}')) return true;
+                    do {
+                        skip_ws();
+                        if (!string(ignored)) return false;
+                        skip_ws();
+                        if (!consume(':')) return false;
+                        skip_ws();
+                        if (!skip_value(depth + 1)) return false;
+                        skip_ws();
+                    } while (consume(','));
+                    return consume('}');
+                case '[':
+                    ++p_;
+                    skip_ws();
+                    if (consume(']')) return true;
+                    do {
+                        skip_ws();
+                        if (!skip_value(depth + 1)) return false;
+                        skip_ws();
+                    } while (consume(','));
+                    return consume(']');
+                case 't':
+                    return literal("true");
+                case 'f':
+                    return literal("false");
+                case 'n':
+                    return literal("null");
+                default:
+                    // Still converted, the generic parser rejects numbers that overflow.
+                    return double_value(number_ignored);
+            }
+        }
+
+        bool object(SensorJsonFields& fields) {
+            skip_ws();
+            if (!consume('{')) return false;
+            skip_ws();
+            if (!consume('}')) {
+                do {
+                    skip_ws();
+                    std::string_view key;
+                    if (!string(key)) return false;
+                    skip_ws();
+                    if (!consume(':')) return false;
+                    skip_ws();
+
+                    // A known key with an unexpected type is an error for the generic
+                    // parser too, let it produce that error.
+                    bool ok;
+                    if (key == "range") ok = double_value(fields.range);
+                    else if (key == "speed") ok = double_value(fields.speed);
+                    else if (key == "ts") ok = integer_value(fields.ts);
+                    else if (key == "presence") ok = bool_value(fields.presence);
+                    else ok = skip_value(1);
+                    if (!ok) return false;
+                    skip_ws();
+                } while (consume(','));
+                if (!consume('}')) return false;
+            }
+            skip_ws();
+            return p_ == end_;
+        }
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @brief Parses a sensor reading, later duplicate keys override earlier ones.
+            * @return false if the payload is outside the supported subset, fields
+            * may then be partially written and must be discarded.
+        */
+        static bool parse(std::string_view text, SensorJsonFields& fields) {
+            SensorJsonParser parser(text);
+            return parser.object(fields);
+        }
+};
@@ -2,56 +2,431 @@
 
 // --- Import Statements ---
 #include <string>
-#include <deque>
-#include <numeric> // For std:: accumulate
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
 #include "nlohmann/json.hpp"
+#include "SensorJsonParser.h"
 #include <iostream>
+#include <stdexcept>
 
 struct Point {
     double x = 0.0;
     double y = 0.0;
 };
 
+/**
+    * Binary sensor payload, the compact alternative to the JSON body.
+    *
+    * Fixed 20 byte little endian layout, produced by DroneSensor::buildBinaryPayload
+    * on the ESP32 (see DroneSensor.h there, keep both in sync):
+    *
+    *   offset  size  field
+    *   0       1     magic, BINARY_PAYLOAD_MAGIC (never the first byte of a JSON document)
+    *   1       1     version, BINARY_PAYLOAD_VERSION
+    *   2       1     sensor type, see SensorType
+    *   3       1     flags, bit 0 = presence
+    *   4       4     sequence number, per sensor, wraps around
+    *   8       4     timestamp_ms, millis() of the reading
+    *   12      4     range_m, float
+    *   16      4     speed_ms, float
+*/
+constexpr uint8_t BINARY_PAYLOAD_MAGIC = 0xD5;
+constexpr uint8_t BINARY_PAYLOAD_VERSION = 1;
+constexpr size_t BINARY_PAYLOAD_SIZE = 20;
+constexpr uint8_t BINARY_FLAG_PRESENCE = 0x01;
+
+enum class SensorType : uint8_t {
+    Unknown = 0,
+    C4001 = 1,
+    RCWL = 2
+};
+
+/**
+    * Batched frame, every reading a node took during one polling window in a
+    * single message, published on "<base topic>/<esp_id>/_batch".
+    *
+    * Produced by BatchFrameBuilder on the ESP32 (see BatchFrame.h there, keep
+    * both in sync):
+    *
+    *   offset  size  field
+    *   0       1     magic, BATCH_FRAME_MAGIC
+    *   1       1     version, BATCH_FRAME_VERSION
+    *   2       1     entry count
+    *   3       1     reserved, 0
+    *
+    * followed by the entries, back to back:
+    *
+    *   0       1     sensor id length n, 1 to BATCH_MAX_SENSOR_ID
+    *   1       n     sensor id, the <sensor_id> the reading would have been published under
+    *   1 + n   20    the reading, in the binary payload layout above
+*/
+constexpr uint8_t BATCH_FRAME_MAGIC = 0xD6;
+constexpr uint8_t BATCH_FRAME_VERSION = 1;
+constexpr size_t BATCH_FRAME_HEADER_SIZE = 4;
+constexpr size_t BATCH_MAX_SENSOR_ID = 63;
+constexpr std::string_view BATCH_SENSOR_ID = "_batch";
+
+enum class PayloadFormat : uint8_t {
+    Json,
+    Binary,
+    Batch
+};
+
+// Every payload is exactly one of them, neither magic byte can start a JSON document.
+inline PayloadFormat detect_payload_format(std::string_view payload) {
+    if (payload.empty()) return PayloadFormat::Json;
+    switch (static_cast<uint8_t>(payload[0])) {
+        case BINARY_PAYLOAD_MAGIC:
+            return PayloadFormat::Binary;
+        case BATCH_FRAME_MAGIC:
+            return PayloadFormat::Batch;
+        default:
+            return PayloadFormat::Json;
+    }
+}
+
+inline const char* payload_format_name(PayloadFormat format) {
+    switch (format) {
+        case PayloadFormat::Binary:
+            return "binary";
+        case PayloadFormat::Batch:
+            return "batched";
+        default:
+            return "JSON";
+    }
+}
+
+/**
+    * @class BinaryPayloadView
+    * @brief Reads the fields of a binary payload in place, without copying or allocating.
+    *
+    * The view does not own the bytes, they must outlive it. valid() must be
+    * checked before any field is read.
+*/
+class BinaryPayloadView {
+    private:
+        const unsigned char* data_;
+        size_t size_;
+
+        template <typename T>
+        T read(size_t offset) const {
+            static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "binary payload decoding assumes a little endian host");
+            T value;
+            std::memcpy(&value, data_ + offset, sizeof(T));
+            return value;
+        }
+
+    public:
+        explicit BinaryPayloadView(std::string_view payload)
+            : data_(reinterpret_cast<const unsigned char*>(payload.data())), size_(payload.size()) {}
+
+        // Longer payloads are accepted so later versions may append fields. A NaN or
+        // infinite range or speed is rejected, it would poison the filter state.
+        bool valid() const {
+            return size_ >= BINARY_PAYLOAD_SIZE && data_[0] == BINARY_PAYLOAD_MAGIC && data_[1] == BINARY_PAYLOAD_VERSION
+                && std::isfinite(range()) && std::isfinite(speed());
+        }
+
+        SensorType sensor_type() const { return static_cast<SensorType>(data_[2]); }
+        bool presence() const { return (data_[3] & BINARY_FLAG_PRESENCE) != 0; }
+        uint32_t sequence() const { return read<uint32_t>(4); }
+        uint32_t timestamp_ms() const { return read<uint32_t>(8); }
+        float range() const { return read<float>(12); }
+        float speed() const { return read<float>(16); }
+};
+
+/**
+    * @class BatchFrameView
+    * @brief Walks the entries of a batched frame in place, without copying or allocating.
+    *
+    * The view does not own the bytes, they must outlive it. valid() checks the
+    * whole frame, so a truncated or corrupted frame is rejected as a unit rather
+    * than delivering its first few readings.
+*/
+class BatchFrameView {
+    private:
+        const unsigned char* data_;
+        size_t size_;
+
+    public:
+        explicit BatchFrameView(std::string_view frame)
+            : data_(reinterpret_cast<const unsigned char*>(frame.data())), size_(frame.size()) {}
+
+        bool valid() const {
+            if (size_ < BATCH_FRAME_HEADER_SIZE || data_[0] != BATCH_FRAME_MAGIC || data_[1] != BATCH_FRAME_VERSION) {
+                return false;
+            }
+            size_t offset = BATCH_FRAME_HEADER_SIZE;
+            for (size_t i = 0; i < count(); ++i) {
+                if (offset >= size_) return false;
+                const size_t id_length = data_[offset];
+                if (id_length == 0 || id_length > BATCH_MAX_SENSOR_ID
+                    || size_ - offset < 1 + id_length + BINARY_PAYLOAD_SIZE) {
+                    return false;
+                }
+                offset += 1 + id_length;
+                BinaryPayloadView reading(std::string_view(reinterpret_cast<const char*>(data_ + offset), BINARY_PAYLOAD_SIZE));
+                if (!reading.valid()) return false;
+                offset += BINARY_PAYLOAD_SIZE;
+            }
+            return offset == size_;
+        }
+
+        size_t count() const { return data_[2]; }
+
+        // Calls visit(std::string_view sensor_id, std::string_view reading) per entry, in frame order.
+        template <typename Visit>
+        void for_each(Visit&& visit) const {
+            const char* bytes = reinterpret_cast<const char*>(data_);
+            size_t offset = BATCH_FRAME_HEADER_SIZE;
+            for (size_t i = 0; i < count(); ++i) {
+                const size_t id_length = data_[offset];
+                visit(std::string_view(bytes + offset + 1, id_length),
+                      std::string_view(bytes + offset + 1 + id_length, BINARY_PAYLOAD_SIZE));
+                offset += 1 + id_length + BINARY_PAYLOAD_SIZE;
+            }
+        }
+};
+
 struct SensorData {
     double range = 0.0;
     double speed = 0.0;
     long long timestamp_ms = 0;
+    bool presence = true;
+    uint32_t sequence = 0;
+    SensorType sensor_type = SensorType::Unknown;
 
     static SensorData from_json(const nlohmann::json& j) {
         SensorData d;
         d.range = j.value("range", d.range);
         d.speed = j.value("speed", d.speed);
         d.timestamp_ms = j.value("ts", 0LL);
+        d.presence = j.value("presence", d.presence);
+        return d;
+    }
+
+    /**
+        * Decodes a JSON payload without building a DOM when it has the usual flat
+        * shape, falling back to the generic parser and from_json() otherwise, so
+        * the result, or the exception, is always the same as from_json(json::parse()).
+    */
+    static SensorData from_json_text(std::string_view payload) {
+        SensorJsonFields fields;
+        if (SensorJsonParser::parse(payload, fields)) {
+            SensorData d;
+            d.range = fields.range;
+            d.speed = fields.speed;
+            d.timestamp_ms = fields.ts;
+            d.presence = fields.presence;
+            return d;
+        }
+        return from_json(nlohmann::json::parse(payload.begin(), payload.end()));
+    }
+
+    static SensorData from_binary(std::string_view payload) {
+        BinaryPayloadView view(payload);
+        if (!view.valid()) {
+            throw std::runtime_error("malformed binary sensor payload");
+        }
+        SensorData d;
+        d.range = view.range();
+        d.speed = view.speed();
+        d.timestamp_ms = view.timestamp_ms();
+        d.presence = view.presence();
+        d.sequence = view.sequence();
+        d.sensor_type = view.sensor_type();
         return d;
     }
+
+    // Detects the format of a single reading payload and decodes it accordingly, see BatchFrameView for batches.
+    static SensorData from_payload(std::string_view payload) {
+        switch (detect_payload_format(payload)) {
+            case PayloadFormat::Binary:
+                return from_binary(payload);
+            case PayloadFormat::Batch:
+                throw std::runtime_error("batched frame passed as a single sensor payload");
+            default:
+                return from_json_text(payload);
+        }
+    }
+
+    // Host side encoder of the binary layout, for replay captures, generators and benchmarks.
+    std::string to_binary() const {
+        std::string out(BINARY_PAYLOAD_SIZE, '\0');
+        const uint32_t ts = static_cast<uint32_t>(timestamp_ms);
+        const float r = static_cast<float>(range);
+        const float s = static_cast<float>(speed);
+        out[0] = static_cast<char>(BINARY_PAYLOAD_MAGIC);
+        out[1] = static_cast<char>(BINARY_PAYLOAD_VERSION);
+        out[2] = static_cast<char>(sensor_type);
+        out[3] = static_cast<char>(presence ? BINARY_FLAG_PRESENCE : 0);
+        std::memcpy(&out[4], &sequence, 4);
+        std::memcpy(&out[8], &ts, 4);
+        std::memcpy(&out[12], &r, 4);
+        std::memcpy(&out[16], &s, 4);
+        return out;
+    }
+};
+
+/**
+    * Mean, variance and sum of one quantity over a window of readings.
+    * The variance is the population variance, 0 for fewer than two readings.
+*/
+struct SeriesStats {
+    double sum = 0.0;
+    double mean = 0.0;
+    double variance = 0.0;
+};
+
+struct WindowStats {
+    size_t count = 0;
+    long long span_ms = 0; // newest minus oldest timestamp in the window
+    SeriesStats range;
+    SeriesStats speed;
 };
 
+/**
+    * Latest readings of one sensor in a fixed-capacity ring.
+    *
+    * Storage is allocated once, at construction. Every slot carries the
+    * running sums of range, range squared, speed and speed squared up to and
+    * including its reading, so the statistics of any suffix of the history
+    * (last N readings, or last T milliseconds, which is a binary search on
+    * the timestamps) are a difference of two slots instead of a pass over the
+    * history. The ring holds one slot more than the capacity so that the sums
+    * just before the oldest reading are still available.
+    *
+    * Values are summed relative to the first reading to keep the squares
+    * small, and the running sums are periodically rebased so their magnitude,
+    * and with it the rounding error, stays bounded however long the sensor runs.
+*/
 class TrackedSensor {
     private:
+        struct Slot {
+            SensorData data;
+            double range_sum = 0.0;
+            double range_sq_sum = 0.0;
+            double speed_sum = 0.0;
+            double speed_sq_sum = 0.0;
+        };
+
+        static constexpr uint64_t REBASE_INTERVAL = 1 << 16;
+
         std::string id_;
-        std::deque<SensorData> history_;
-        const size_t max_history_size_;
+        std::vector<Slot> slots_; // capacity + 1
+        size_t capacity_;
+        uint64_t total_ = 0;         // readings ever added, the next reading's absolute index
+        uint64_t clock_start_ = 0;   // first reading after the node's clock last went backwards (reboot)
+        size_t next_ = 0;            // slot of the next reading, total_ % slots_.size() without the division
+        double range_origin_ = 0.0;
+        double speed_origin_ = 0.0;
+
+        const Slot& slot(uint64_t index) const { return slots_[index % slots_.size()]; }
+        Slot& slot(uint64_t index) { return slots_[index % slots_.size()]; }
+
+        size_t latest_slot() const { return (next_ > 0 ? next_ : slots_.size()) - 1; }
+        uint64_t oldest() const { return total_ - size(); }
+
+        // Statistics of the readings with absolute index in [first, total_).
+        WindowStats window(uint64_t first) const {
+            WindowStats stats;
+            if (first >= total_) return stats;
+            const Slot& last = slots_[latest_slot()];
+            Slot before;
+            if (first > 0) before = slot(first - 1);
+            stats.count = static_cast<size_t>(total_ - first);
+            stats.span_ms = last.data.timestamp_ms - slot(first).data.timestamp_ms;
+            const double n = static_cast<double>(stats.count);
+            auto series = [n](double origin, double sum, double sq_sum) {
+                SeriesStats s;
+                const double mean = sum / n;
+                s.mean = origin + mean;
+                s.sum = origin * n + sum;
+                s.variance = n > 1.0 ? sq_sum / n - mean * mean : 0.0;
+                if (s.variance < 0.0) s.variance = 0.0;
+                return s;
+            };
+            stats.range = series(range_origin_, last.range_sum - before.range_sum, last.range_sq_sum - before.range_sq_sum);
+            stats.speed = series(speed_origin_, last.speed_sum - before.speed_sum, last.speed_sq_sum - before.speed_sq_sum);
+            return stats;
+        }
+
+        // Subtracts the oldest retained sums from every slot, differences are unchanged.
+        void rebase() {
+            const Slot base = slot(total_ - slots_.size());
+            for (Slot& s : slots_) {
+                s.range_sum -= base.range_sum;
+                s.range_sq_sum -= base.range_sq_sum;
+                s.speed_sum -= base.speed_sum;
+                s.speed_sq_sum -= base.speed_sq_sum;
+            }
+        }
 
     public:
         TrackedSensor(std::string id, size_t history_size = 20)
-            : id_(id), max_history_size_(history_size) {}
+            : id_(std::move(id)), slots_((history_size > 0 ? history_size : 1) + 1),
+              capacity_(history_size > 0 ? history_size : 1) {}
 
         const std::string& getId() const { return id_; }
-        const SensorData& getLatestData() const { return history_.front(); }
-        
+        // The newest reading, a default SensorData before the first one.
+        const SensorData& getLatestData() const { return slots_[latest_slot()].data; }
+
+        size_t size() const { return total_ < capacity_ ? static_cast<size_t>(total_) : capacity_; }
+        size_t capacity() const { return capacity_; }
+
+        // age 0 is the newest reading, size() - 1 the oldest.
+        const SensorData& getReading(size_t age) const { return slot(total_ - 1 - age).data; }
+
         void addDataPoint(const SensorData& data) {
-            history_.push_front(data);
-            if (history_.size() > max_history_size_) {
-                history_.pop_back();
+            if (total_ == 0) {
+                range_origin_ = data.range;
+                speed_origin_ = data.speed;
+            } else if (data.timestamp_ms < getLatestData().timestamp_ms) {
+                clock_start_ = total_;
             }
+            const Slot previous = total_ > 0 ? slots_[latest_slot()] : Slot{};
+            const double range = data.range - range_origin_;
+            const double speed = data.speed - speed_origin_;
+            Slot& next = slots_[next_];
+            next.data = data;
+            next.range_sum = previous.range_sum + range;
+            next.range_sq_sum = previous.range_sq_sum + range * range;
+            next.speed_sum = previous.speed_sum + speed;
+            next.speed_sq_sum = previous.speed_sq_sum + speed * speed;
+            ++total_;
+            if (++next_ == slots_.size()) next_ = 0;
+            if (total_ % REBASE_INTERVAL == 0 && total_ > slots_.size()) {
+                rebase();
+            }
+        }
+
+        // Whole history.
+        WindowStats getStats() const { return window(oldest()); }
+
+        // The newest min(readings, size()) readings.
+        WindowStats getStatsForLast(size_t readings) const {
+            return window(total_ - (readings < size() ? readings : size()));
         }
 
-        double getAverageSpeed() const {
-            if (history_.empty()) return 0.0;
-            double sum = std::accumulate(history_.begin(), history_.end(), 0.0,
-                [](double sum, const SensorData& data) {
-                    return sum + data.speed;
-                });
-            return sum / history_.size();
+        /**
+            * Readings at most ms older than the newest one, by the node's own timestamps.
+            * Stops at a reboot of the node (its clock going backwards).
+        */
+        WindowStats getStatsForLastMs(long long ms) const {
+            uint64_t lo = oldest() > clock_start_ ? oldest() : clock_start_;
+            uint64_t hi = total_;
+            if (lo >= hi) return WindowStats{};
+            const long long cutoff = getLatestData().timestamp_ms - ms;
+            while (lo < hi) {
+                const uint64_t mid = lo + (hi - lo) / 2;
+                if (slot(mid).data.timestamp_ms < cutoff) lo = mid + 1;
+                else hi = mid;
+            }
+            return window(lo);
         }
+
+        double getAverageSpeed() const { return getStats().speed.mean; }
 };
\ No newline at end of file
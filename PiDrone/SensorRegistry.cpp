@@ -0,0 +1,129 @@
+/**
+    * @file SensorRegistry.cpp
+    * @brief Lock-free lookup, mutex-protected interning of node and sensor ids.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "SensorRegistry.h"
+#include <stdexcept>
+// --- End Imports ---
+
+InternTable::InternTable(size_t capacity) : capacity_(capacity) {
+    // Keep the load factor at or below one half so probes stay short.
+    size_t slots = 1;
+    while (slots < capacity * 2) slots <<= 1;
+    mask_ = slots - 1;
+    slots_.reset(new std::atomic<uint64_t>[slots]);
+    for (size_t i = 0; i < slots; ++i) {
+        slots_[i].store(0, std::memory_order_relaxed);
+    }
+    names_.reset(new std::string[capacity]);
+}
+
+// FNV-1a, good enough for short ASCII ids and cheap to compute.
+uint64_t InternTable::hash(std::string_view key) {
+    uint64_t h = 1469598103934665603ULL;
+    for (char c : key) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+uint32_t InternTable::find(std::string_view key) const {
+    const uint64_t h = hash(key);
+    const uint32_t tag = static_cast<uint32_t>(h >> 32);
+
+    for (size_t i = h & mask_;; i = (i + 1) & mask_) {
+        uint64_t slot = slots_[i].load(std::memory_order_acquire);
+        if (slot == 0) {
+            return std::numeric_limits<uint32_t>::max();
+        }
+        if (static_cast<uint32_t>(slot >> 32) == tag) {
+            uint32_t index = static_cast<uint32_t>(slot) - 1;
+            if (names_[index] == key) {
+                return index;
+            }
+        }
+    }
+}
+
+uint32_t InternTable::insert(std::string_view key) {
+    uint32_t existing = find(key);
+    if (existing != std::numeric_limits<uint32_t>::max()) {
+        return existing;
+    }
+
+    uint32_t index = size_.load(std::memory_order_relaxed);
+    if (index >= capacity_) {
+        throw std::runtime_error("intern table full, cannot add '" + std::string(key) + "'");
+    }
+    names_[index] = std::string(key);
+
+    const uint64_t h = hash(key);
+    size_t i = h & mask_;
+    while (slots_[i].load(std::memory_order_relaxed) != 0) {
+        i = (i + 1) & mask_;
+    }
+    slots_[i].store((h & 0xFFFFFFFF00000000ULL) | (uint64_t(index) + 1), std::memory_order_release);
+    size_.store(index + 1, std::memory_order_release);
+    return index;
+}
+
+SensorRegistry::SensorRegistry(size_t max_nodes, size_t max_sensors)
+    : nodes_(max_nodes), sensors_(max_sensors),
+      node_info_(new NodeInfo[max_nodes]), sensor_info_(new SensorInfo[max_sensors]) {}
+
+NodeHandle SensorRegistry::find_node(std::string_view esp_id) const {
+    return nodes_.find(esp_id);
+}
+
+NodeHandle SensorRegistry::intern_node(std::string_view esp_id) {
+    std::lock_guard<std::mutex> lock(intern_mutex_);
+    NodeHandle handle = nodes_.find(esp_id);
+    if (handle == INVALID_NODE) {
+        // Full: ids arriving from the network must not be able to throw out of the ingest path.
+        uint32_t next = nodes_.size();
+        if (next >= nodes_.capacity()) {
+            return INVALID_NODE;
+        }
+        // Fill in the info before the handle becomes visible to readers.
+        node_info_[next].esp_id = std::string(esp_id);
+        handle = nodes_.insert(esp_id);
+    }
+    return handle;
+}
+
+SensorHandle SensorRegistry::find_sensor(std::string_view full_id) const {
+    return sensors_.find(full_id);
+}
+
+SensorHandle SensorRegistry::intern_sensor(std::string_view full_id) {
+    size_t slash = full_id.find('/');
+    if (slash == std::string_view::npos || slash == 0 || slash + 1 == full_id.size()
+        || full_id.find('/', slash + 1) != std::string_view::npos) {
+        return INVALID_SENSOR;
+    }
+
+    NodeHandle node = intern_node(full_id.substr(0, slash));
+    if (node == INVALID_NODE) {
+        return INVALID_SENSOR;
+    }
+
+    std::lock_guard<std::mutex> lock(intern_mutex_);
+    SensorHandle handle = sensors_.find(full_id);
+    if (handle == INVALID_SENSOR) {
+        uint32_t next = sensors_.size();
+        if (next >= sensors_.capacity()) {
+            return INVALID_SENSOR;
+        }
+        SensorInfo& info = sensor_info_[next];
+        info.full_id = std::string(full_id);
+        info.sensor_id = std::string(full_id.substr(slash + 1));
+        info.node = node;
+        handle = sensors_.insert(full_id);
+    }
+    return handle;
+}
@@ -0,0 +1,102 @@
+/**
+    * @file SensorRegistry.h
+    * @brief Interns ESP node ids and "esp_id/sensor_id" strings into dense integer handles.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Sensors are interned once, the first time they are seen, and every later
+    * stage of the pipeline (NodeManager, DroneTracker) works on the SensorHandle.
+    * Lookups take a std::string_view straight into the topic and never allocate.
+    *
+    * Storage is sized at construction and never reallocates, so lookups are
+    * lock-free: only interning a new node or sensor takes the mutex.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+using SensorHandle = uint32_t;
+using NodeHandle = uint32_t;
+
+constexpr SensorHandle INVALID_SENSOR = std::numeric_limits<SensorHandle>::max();
+constexpr NodeHandle INVALID_NODE = std::numeric_limits<NodeHandle>::max();
+
+struct NodeInfo {
+    std::string esp_id;
+};
+
+struct SensorInfo {
+    std::string full_id;   // "esp_id/sensor_id"
+    std::string sensor_id; // just the part after the slash
+    NodeHandle node = INVALID_NODE;
+};
+
+/**
+    * @class InternTable
+    * @brief Fixed-capacity open-addressing table from string to dense index.
+    *
+    * Readers never lock: a slot is published with a release store after the name
+    * it points to has been written. Writers are serialized by the owner.
+*/
+class InternTable {
+    private:
+        // Slot layout: upper 32 bits hash, lower 32 bits index + 1, 0 means empty.
+        std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+        std::unique_ptr<std::string[]> names_;
+        size_t mask_;
+        size_t capacity_;
+        std::atomic<uint32_t> size_{0};
+
+    public:
+        explicit InternTable(size_t capacity);
+
+        static uint64_t hash(std::string_view key);
+
+        uint32_t find(std::string_view key) const;
+        // Caller must hold the owner's write lock. Returns the index, new or existing.
+        uint32_t insert(std::string_view key);
+
+        const std::string& name(uint32_t index) const { return names_[index]; }
+        uint32_t size() const { return size_.load(std::memory_order_acquire); }
+        size_t capacity() const { return capacity_; }
+};
+
+class SensorRegistry {
+    // --- Private var declaration to be used ---
+    private:
+        InternTable nodes_;
+        InternTable sensors_;
+        std::unique_ptr<NodeInfo[]> node_info_;
+        std::unique_ptr<SensorInfo[]> sensor_info_;
+        std::mutex intern_mutex_;
+
+    // --- Public method declarations ---
+    public:
+        SensorRegistry(size_t max_nodes = 1024, size_t max_sensors = 4096);
+
+        NodeHandle find_node(std::string_view esp_id) const;
+        // INVALID_NODE once max_nodes ids are interned.
+        NodeHandle intern_node(std::string_view esp_id);
+
+        // full_id is "esp_id/sensor_id". Returns INVALID_SENSOR if it is not in that form,
+        // or when the node or sensor table is full.
+        SensorHandle find_sensor(std::string_view full_id) const;
+        SensorHandle intern_sensor(std::string_view full_id);
+
+        const NodeInfo& node(NodeHandle handle) const { return node_info_[handle]; }
+        const SensorInfo& sensor(SensorHandle handle) const { return sensor_info_[handle]; }
+
+        size_t node_count() const { return nodes_.size(); }
+        size_t sensor_count() const { return sensors_.size(); }
+        size_t max_nodes() const { return nodes_.capacity(); }
+        size_t max_sensors() const { return sensors_.capacity(); }
+};
@@ -0,0 +1,88 @@
+/**
+    * @file SeqLock.h
+    * @brief Single-writer sequence lock for small trivially copyable values.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The writer never waits and readers never block the writer: a reader simply
+    * retries if the value changed while it was being copied. The payload is kept
+    * in relaxed atomic words so concurrent copies are well defined.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "SpscRing.h"
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock payload must be trivially copyable");
+
+    // --- Private var declaration to be used ---
+    private:
+        static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        std::atomic<uint32_t> seq_{0};
+        std::atomic<uint64_t> words_[WORDS] = {};
+
+    // --- Public method declarations ---
+    public:
+        // Only one thread may store at a time.
+        void store(const T& value) {
+            uint64_t buffer[WORDS] = {};
+            std::memcpy(buffer, &value, sizeof(T));
+
+            uint32_t seq = seq_.load(std::memory_order_relaxed);
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < WORDS; ++i) {
+                words_[i].store(buffer[i], std::memory_order_relaxed);
+            }
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        // Like store(), for several writers: stores nothing and returns false while another try_store() is running.
+        bool try_store(const T& value) {
+            uint32_t seq = seq_.load(std::memory_order_relaxed);
+            if ((seq & 1) || !seq_.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed)) {
+                return false;
+            }
+            uint64_t buffer[WORDS] = {};
+            std::memcpy(buffer, &value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < WORDS; ++i) {
+                words_[i].store(buffer[i], std::memory_order_relaxed);
+            }
+            seq_.store(seq + 2, std::memory_order_release);
+            return true;
+        }
+
+        T load() const {
+            uint64_t buffer[WORDS];
+            uint32_t before, after;
+            do {
+                before = seq_.load(std::memory_order_acquire);
+                while (before & 1) {
+                    cpu_relax();
+                    before = seq_.load(std::memory_order_acquire);
+                }
+                for (size_t i = 0; i < WORDS; ++i) {
+                    buffer[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = seq_.load(std::memory_order_relaxed);
+            } while (before != after);
+
+            T value;
+            std::memcpy(&value, buffer, sizeof(T));
+            return value;
+        }
+
+        // Number of completed stores, handy to tell whether anything changed.
+        uint32_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+};
@@ -0,0 +1,66 @@
+/**
+    * @file SpatialGrid.h
+    * @brief Uniform grid index over a set of points, rebuilt once per scan.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Points are bucketed into square cells of a fixed size by sorting their
+    * cell keys, so a rebuild is one sort and a lookup is a binary search per
+    * neighbouring cell. With the cell size set to the largest search radius,
+    * every point within that radius of a query lies in the 3 x 3 block of
+    * cells around it. Storage is kept between rebuilds.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "SensorModel.h"
+
+class SpatialGrid {
+    // --- Private var declaration to be used ---
+    private:
+        double inv_cell_;
+        // (cell key, point index) sorted by key.
+        std::vector<std::pair<uint64_t, uint32_t>> entries_;
+
+        static uint64_t key(int64_t cx, int64_t cy) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+        }
+
+        int64_t cell(double v) const { return static_cast<int64_t>(std::floor(v * inv_cell_)); }
+
+    // --- Public method declarations ---
+    public:
+        explicit SpatialGrid(double cell_size) : inv_cell_(1.0 / cell_size) {}
+
+        template <typename PointAt>
+        void rebuild(size_t count, PointAt&& point_at) {
+            entries_.clear();
+            for (size_t i = 0; i < count; ++i) {
+                const Point p = point_at(i);
+                entries_.emplace_back(key(cell(p.x), cell(p.y)), static_cast<uint32_t>(i));
+            }
+            std::sort(entries_.begin(), entries_.end());
+        }
+
+        // Calls visit(index) for every point in the 3 x 3 cells around p.
+        template <typename Visit>
+        void for_each_near(const Point& p, Visit&& visit) const {
+            const int64_t cx = cell(p.x);
+            const int64_t cy = cell(p.y);
+            for (int64_t dx = -1; dx <= 1; ++dx)
+                for (int64_t dy = -1; dy <= 1; ++dy) {
+                    const uint64_t k = key(cx + dx, cy + dy);
+                    auto it = std::lower_bound(entries_.begin(), entries_.end(), std::make_pair(k, uint32_t(0)));
+                    for (; it != entries_.end() && it->first == k; ++it) {
+                        visit(it->second);
+                    }
+                }
+        }
+};
@@ -0,0 +1,78 @@
+/**
+    * @file SpinParkWaiter.h
+    * @brief Adaptive spin-then-park wait strategy for a single waiting thread.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The waiter spins for a while before falling back to a condition variable.
+    * The spin budget adapts: it grows when work tends to show up while spinning
+    * and shrinks when the waiter ends up parking anyway. notify() only touches
+    * the mutex when the waiter is actually parked, so a busy producer pays a
+    * fence and a load per notification rather than a futex call.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "SpscRing.h"
+
+class SpinParkWaiter {
+    // --- Private var declaration to be used ---
+    private:
+        static constexpr unsigned MIN_SPINS = 64;
+        static constexpr unsigned MAX_SPINS = 16384;
+        static constexpr unsigned YIELDS = 4;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> parked_{false};
+        std::mutex park_mutex_;
+        std::condition_variable park_cv_;
+        unsigned spin_budget_ = 1024;
+
+    // --- Public method declarations ---
+    public:
+        /**
+            * @brief Blocks until ready() returns true.
+            *
+            * ready() must become true only through state that the notifying thread
+            * publishes before calling notify().
+        */
+        template <typename Pred>
+        void wait(Pred ready) {
+            for (unsigned i = 0; i < spin_budget_; ++i) {
+                if (ready()) {
+                    if (spin_budget_ < MAX_SPINS) spin_budget_ *= 2;
+                    return;
+                }
+                cpu_relax();
+            }
+            for (unsigned i = 0; i < YIELDS; ++i) {
+                if (ready()) return;
+                std::this_thread::yield();
+            }
+            if (spin_budget_ > MIN_SPINS) spin_budget_ /= 2;
+
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            parked_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            park_cv_.wait(lock, ready);
+            parked_.store(false, std::memory_order_relaxed);
+        }
+
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parked_.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(park_mutex_);
+                park_cv_.notify_one();
+            }
+        }
+
+        bool parked() const {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return parked_.load(std::memory_order_relaxed);
+        }
+};
@@ -0,0 +1,134 @@
+/**
+    * @file SpscRing.h
+    * @brief Bounded lock-free single-producer/single-consumer ring buffer.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Producer and consumer indices live on separate cache lines and each side
+    * keeps a cached copy of the other side's index, so in steady state a push
+    * or a pop touches no cache line owned by the other thread. The consumer
+    * drains everything available in one batch and publishes its progress once
+    * per batch instead of once per element.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+    * @brief Hints the CPU that we are in a spin-wait loop.
+*/
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+    * @class SpscRing
+    * @brief Fixed-capacity FIFO for exactly one producer thread and one consumer thread.
+    *
+    * The capacity is rounded up to a power of two. T must be default constructible
+    * and movable, slots are reused in place.
+*/
+template <typename T>
+class SpscRing {
+    // --- Private var declaration to be used ---
+    private:
+        struct alignas(CACHE_LINE_SIZE) ProducerSide {
+            std::atomic<size_t> tail{0};
+            size_t cached_head = 0;
+        };
+
+        struct alignas(CACHE_LINE_SIZE) ConsumerSide {
+            std::atomic<size_t> head{0};
+            size_t cached_tail = 0;
+        };
+
+        ProducerSide producer_;
+        ConsumerSide consumer_;
+        const size_t capacity_;
+        const size_t mask_;
+        std::unique_ptr<T[]> slots_;
+
+        static size_t round_up_pow2(size_t n) {
+            size_t p = 1;
+            while (p < n) p <<= 1;
+            return p;
+        }
+
+    // --- Public method declarations ---
+    public:
+        explicit SpscRing(size_t capacity)
+            : capacity_(round_up_pow2(capacity < 2 ? 2 : capacity)),
+              mask_(capacity_ - 1),
+              slots_(new T[capacity_]) {}
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        /**
+            * @brief Producer side. Moves value into the ring if there is room.
+            *
+            * @return false if the ring is full, value is left untouched in that case.
+        */
+        bool try_push(T&& value) {
+            const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+            if (tail - producer_.cached_head >= capacity_) {
+                producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+                if (tail - producer_.cached_head >= capacity_) {
+                    return false;
+                }
+            }
+            slots_[tail & mask_] = std::move(value);
+            producer_.tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+            * @brief Consumer side. Hands every available element to fn, oldest first.
+            *
+            * fn receives a T& it may move from. The consumed slots are released to the
+            * producer once, after the whole batch has been processed.
+            *
+            * @return Number of elements consumed.
+        */
+        template <typename Fn>
+        size_t drain(Fn&& fn, size_t max_items = std::numeric_limits<size_t>::max()) {
+            const size_t head = consumer_.head.load(std::memory_order_relaxed);
+            if (head == consumer_.cached_tail) {
+                consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+                if (head == consumer_.cached_tail) {
+                    return 0;
+                }
+            }
+
+            size_t available = consumer_.cached_tail - head;
+            size_t count = available < max_items ? available : max_items;
+            for (size_t i = 0; i < count; ++i) {
+                fn(slots_[(head + i) & mask_]);
+            }
+            consumer_.head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        // Safe to call from either side, the answer may be stale by the time it is used.
+        bool empty() const {
+            return producer_.tail.load(std::memory_order_acquire) == consumer_.head.load(std::memory_order_acquire);
+        }
+
+        size_t size_approx() const {
+            return producer_.tail.load(std::memory_order_acquire) - consumer_.head.load(std::memory_order_acquire);
+        }
+
+        size_t capacity() const { return capacity_; }
+};
@@ -0,0 +1,219 @@
+/**
+    * @file SubsetGrid.cpp
+    * @brief Grid construction, dilution of precision and the greedy subset search.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "SubsetGrid.h"
+#include <algorithm>
+#include <cmath>
+#include "Multilateration.h"
+// --- End Imports ---
+
+namespace {
+
+constexpr size_t MIN_SUBSET = 3;
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+size_t bits(uint64_t mask) {
+    return static_cast<size_t>(__builtin_popcountll(mask));
+}
+
+} // namespace
+
+SubsetGrid::SubsetGrid(std::vector<Point> positions_by_slot, uint64_t sensors, const SubsetSelectionConfig& config)
+    : positions_(std::move(positions_by_slot)), sensors_(sensors), degraded_(new SeqLock<Degraded>[DEGRADED_SLOTS]) {
+    for (size_t i = 0; i < DEGRADED_SLOTS; ++i) {
+        degraded_[i].store(Degraded{NO_CELL, 0, {}});
+    }
+    if (sensors_ == 0) return;
+
+    Point lo{INF, INF};
+    Point hi{-INF, -INF};
+    for (uint64_t m = sensors_; m; m &= m - 1) {
+        const Point& p = positions_[__builtin_ctzll(m)];
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y)};
+    }
+    origin_ = {lo.x - config.margin_m, lo.y - config.margin_m};
+    const double width = hi.x - lo.x + 2.0 * config.margin_m;
+    const double height = hi.y - lo.y + 2.0 * config.margin_m;
+    cell_m_ = std::max({config.cell_m, std::sqrt(width * height / static_cast<double>(MAX_CELLS)), 1e-3});
+    nx_ = static_cast<uint32_t>(std::ceil(width / cell_m_));
+    ny_ = static_cast<uint32_t>(std::ceil(height / cell_m_));
+    nx_ = std::max<uint32_t>(nx_, 1);
+    ny_ = std::max<uint32_t>(ny_, 1);
+    // Rounding up both sides can still overshoot MAX_CELLS by a row or column.
+    while (static_cast<size_t>(nx_) * ny_ > MAX_CELLS) {
+        cell_m_ *= 1.01;
+        nx_ = std::max<uint32_t>(static_cast<uint32_t>(std::ceil(width / cell_m_)), 1);
+        ny_ = std::max<uint32_t>(static_cast<uint32_t>(std::ceil(height / cell_m_)), 1);
+    }
+
+    const size_t cells = static_cast<size_t>(nx_) * ny_;
+    const double reach_sq = config.max_range_m * config.max_range_m;
+    visible_.resize(cells);
+    best_.resize(cells);
+    for (uint32_t cell = 0; cell < cells; ++cell) {
+        const Point c = center(cell);
+        uint64_t visible = 0;
+        for (uint64_t m = sensors_; m; m &= m - 1) {
+            const int slot = __builtin_ctzll(m);
+            const double dx = positions_[slot].x - c.x;
+            const double dy = positions_[slot].y - c.y;
+            if (config.max_range_m <= 0.0 || dx * dx + dy * dy <= reach_sq) visible |= uint64_t(1) << slot;
+        }
+        // Where fewer than three can see, they all have to do.
+        visible_[cell] = bits(visible) >= MIN_SUBSET ? visible : sensors_;
+        best_[cell] = search(cell, sensors_);
+    }
+}
+
+SubsetGrid::~SubsetGrid() = default;
+
+Point SubsetGrid::center(uint32_t cell) const {
+    return {origin_.x + (static_cast<double>(cell % nx_) + 0.5) * cell_m_,
+            origin_.y + (static_cast<double>(cell / nx_) + 0.5) * cell_m_};
+}
+
+uint32_t SubsetGrid::cell_of(const Point& p) const {
+    const double fx = (p.x - origin_.x) / cell_m_;
+    const double fy = (p.y - origin_.y) / cell_m_;
+    if (!(fx >= 0.0 && fy >= 0.0 && fx < static_cast<double>(nx_) && fy < static_cast<double>(ny_))) {
+        return NO_CELL;
+    }
+    return static_cast<uint32_t>(fy) * nx_ + static_cast<uint32_t>(fx);
+}
+
+double SubsetGrid::dilution(uint64_t mask, const std::vector<Point>& positions_by_slot, const Point& at) {
+    const size_t n = bits(mask);
+    if (n < MIN_SUBSET || n > SubsetSolver::MAX_SENSORS) return INF;
+
+    double ax[SubsetSolver::MAX_SENSORS], ay[SubsetSolver::MAX_SENSORS], d_sq[SubsetSolver::MAX_SENSORS];
+    const Point& s0 = positions_by_slot[__builtin_ctzll(mask)];
+    const double d0_sq = (at.x - s0.x) * (at.x - s0.x) + (at.y - s0.y) * (at.y - s0.y);
+    double n11 = 0.0, n12 = 0.0, n22 = 0.0;
+    size_t rows = 0;
+    for (uint64_t m = mask & (mask - 1); m; m &= m - 1) {
+        const Point& si = positions_by_slot[__builtin_ctzll(m)];
+        ax[rows] = 2.0 * (si.x - s0.x);
+        ay[rows] = 2.0 * (si.y - s0.y);
+        d_sq[rows] = (at.x - si.x) * (at.x - si.x) + (at.y - si.y) * (at.y - si.y);
+        n11 += ax[rows] * ax[rows];
+        n12 += ax[rows] * ay[rows];
+        n22 += ay[rows] * ay[rows];
+        ++rows;
+    }
+
+    // Same degeneracy test as SubsetSolver, a subset it refuses must never be chosen.
+    const double trace = n11 + n22;
+    const double det = n11 * n22 - n12 * n12;
+    const double disc = std::sqrt(std::max(0.0, trace * trace / 4.0 - det));
+    const double lmax = trace / 2.0 + disc;
+    const double lmin = trace / 2.0 - disc;
+    if (lmin <= 0.0 || lmax / lmin > SubsetSolver::MAX_CONDITION * SubsetSolver::MAX_CONDITION) {
+        return INF;
+    }
+
+    // Rows of M = (A^T A)^-1 A^T, the reference error is common to all of b.
+    const double i11 = n22 / det, i12 = -n12 / det, i22 = n11 / det;
+    double sum_x = 0.0, sum_y = 0.0, own = 0.0;
+    for (size_t i = 0; i < rows; ++i) {
+        const double mx = i11 * ax[i] + i12 * ay[i];
+        const double my = i12 * ax[i] + i22 * ay[i];
+        sum_x += mx;
+        sum_y += my;
+        own += d_sq[i] * (mx * mx + my * my);
+    }
+    return 2.0 * std::sqrt(d0_sq * (sum_x * sum_x + sum_y * sum_y) + own);
+}
+
+SubsetGrid::Choice SubsetGrid::search(uint32_t cell, uint64_t live) const {
+    const Point at = center(cell);
+    uint64_t current = visible_[cell] & live;
+    if (bits(current) < MIN_SUBSET) current = live;
+
+    if (bits(current) > MAX_CANDIDATES) {
+        // The nearest sensor in each of MAX_CANDIDATES directions, the nearest
+        // overall would often all sit on one side of the drone.
+        std::vector<std::pair<double, int>> by_distance;
+        for (uint64_t m = current; m; m &= m - 1) {
+            const int slot = __builtin_ctzll(m);
+            by_distance.push_back({std::hypot(positions_[slot].x - at.x, positions_[slot].y - at.y), slot});
+        }
+        std::sort(by_distance.begin(), by_distance.end());
+        uint64_t picked = 0;
+        uint32_t sectors = 0;
+        for (const auto& candidate : by_distance) {
+            const Point& p = positions_[candidate.second];
+            const double bearing = std::atan2(p.y - at.y, p.x - at.x) + M_PI;
+            const uint32_t sector = std::min<uint32_t>(static_cast<uint32_t>(bearing / (2.0 * M_PI) * MAX_CANDIDATES),
+                                                       MAX_CANDIDATES - 1);
+            if (!(sectors >> sector & 1)) {
+                sectors |= uint32_t(1) << sector;
+                picked |= uint64_t(1) << candidate.second;
+            }
+        }
+        for (size_t i = 0; i < by_distance.size() && bits(picked) < MAX_CANDIDATES; ++i) {
+            picked |= uint64_t(1) << by_distance[i].second;
+        }
+        current = picked;
+    }
+
+    Choice best{current, dilution(current, positions_, at)};
+    while (bits(current) > MIN_SUBSET) {
+        uint64_t step = 0;
+        double step_dop = INF;
+        for (uint64_t m = current; m; m &= m - 1) {
+            const uint64_t without = current & ~(m & -m);
+            const double dop = dilution(without, positions_, at);
+            if (dop < step_dop) {
+                step_dop = dop;
+                step = without;
+            }
+        }
+        if (step == 0) break;
+        current = step;
+        if (step_dop < best.dop) best = {current, step_dop};
+    }
+    return best;
+}
+
+SubsetGrid::Choice SubsetGrid::choose(uint32_t cell, uint64_t live) {
+    const Choice& stored = best_[cell];
+    if ((stored.mask & ~live) == 0) {
+        return stored;
+    }
+
+    // Fibonacci hashing of cell and live set, as in MultilaterationEngine::solver().
+    const uint64_t key = (live ^ (uint64_t(cell) * 0xD6E8FEB86659FD93ULL)) * 0x9E3779B97F4A7C15ULL;
+    const size_t home = static_cast<size_t>(key >> 54) & (DEGRADED_SLOTS - 1);
+    // With the window full, the victim is picked by other bits of the key, so keys sharing a home spread over it.
+    size_t victim = (home + static_cast<size_t>(key >> 40) % DEGRADED_PROBES) & (DEGRADED_SLOTS - 1);
+    for (size_t probe = 0; probe < DEGRADED_PROBES; ++probe) {
+        const size_t index = (home + probe) & (DEGRADED_SLOTS - 1);
+        const Degraded entry = degraded_[index].load();
+        if (entry.cell == cell && entry.live == live) {
+            return entry.choice;
+        }
+        if (entry.cell == NO_CELL) {
+            victim = index;
+            break;
+        }
+    }
+    // Entries are never removed, only replaced, so an empty slot ends the window.
+    const Choice choice = search(cell, live);
+    // Another thread writing the slot right now wins, this result is only not cached.
+    degraded_[victim].try_store(Degraded{cell, live, choice});
+    return choice;
+}
+
+std::vector<uint64_t> SubsetGrid::best_masks() const {
+    std::vector<uint64_t> masks;
+    for (const Choice& choice : best_) masks.push_back(choice.mask);
+    std::sort(masks.begin(), masks.end());
+    masks.erase(std::unique(masks.begin(), masks.end()), masks.end());
+    return masks;
+}
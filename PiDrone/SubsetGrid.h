@@ -0,0 +1,148 @@
+/**
+    * @file SubsetGrid.h
+    * @brief Precomputed best sensor subset and its dilution of precision for every cell of the site.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Solving with every sensor that has a range is not the best a site can
+    * do. A radar out of reach of the drone (the C4001 sees 12 m) only holds
+    * the range from before it lost it, and the linearized solver (see
+    * Multilateration.h) subtracts the squared range of a reference sensor
+    * from every other one, so the noise of a far sensor enters b scaled by
+    * its distance: adding it can make the fix worse, and a nearly collinear
+    * subset makes it much worse. Which subset is best depends on where the
+    * drone is.
+    *
+    * The grid covers the sensors' bounding box grown by margin_m in square
+    * cells. For every cell it stores the sensors that can see the cell
+    * center (within max_range_m) and, among those, the subset with the
+    * smallest dilution of precision at the center: the standard deviation of
+    * the linearized solver's position error per meter of range noise, with
+    * the same reference sensor SubsetSolver uses. The search starts from all
+    * visible sensors (at most MAX_CANDIDATES, spread around the cell) and
+    * greedily drops the sensor whose removal helps most, keeping the best
+    * subset seen, down to three. The grid is built with the geometry, off
+    * the update path.
+    *
+    * A fix then looks up the cell of the previous fix. When a sensor of the
+    * cell's best subset has no live range, the best subset of the live ones
+    * is searched for that cell once and cached per (cell, live sensors) in a
+    * fixed lock-free table, so only the cells the drone actually visits are
+    * recomputed and only while that sensor is out. A lookup probes a short
+    * window of slots, each a seqlock, and a miss in a full window replaces one
+    * of its entries: a long run of outages evicts old ones instead of filling
+    * the table for good.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "SensorModel.h"
+#include "SeqLock.h"
+#include "SpscRing.h"
+
+struct SubsetSelectionConfig {
+    // Off solves with every sensor that has a range, as before the grid.
+    bool grid = true;
+    double cell_m = 1.0;
+    double margin_m = 2.0;
+    // Sensors farther than this from a cell are not used for it, 0 for no limit.
+    double max_range_m = 12.0;
+    // Leave a sensor out once it reports that it lost the target, see DroneTracker::withdraw().
+    bool drop_lost = true;
+    // Leave a sensor out once its latest range arrived this long ago, 0 never.
+    double stale_after_s = 2.0;
+};
+
+class SubsetGrid {
+    public:
+        static constexpr uint32_t NO_CELL = std::numeric_limits<uint32_t>::max();
+        // The cell size grows to keep the grid within this many cells.
+        static constexpr size_t MAX_CELLS = size_t(1) << 16;
+        // Visible sensors a cell's subset is searched among, the nearest one in each of as many directions.
+        static constexpr size_t MAX_CANDIDATES = 16;
+
+        struct Choice {
+            uint64_t mask = 0;
+            // Position error per meter of range noise, infinity if every subset is degenerate.
+            double dop = 0.0;
+        };
+
+    // --- Private var declaration to be used ---
+    private:
+        // Searched subsets of cells with sensors out, keyed by (cell, live sensors). A lookup
+        // probes at most DEGRADED_PROBES slots, a miss overwrites one of them once full.
+        static constexpr size_t DEGRADED_SLOTS = 1024;
+        static constexpr size_t DEGRADED_PROBES = 8;
+
+        struct Degraded {
+            // NO_CELL for a slot never written.
+            uint32_t cell;
+            uint64_t live;
+            Choice choice;
+        };
+
+        std::vector<Point> positions_;
+        uint64_t sensors_;
+        Point origin_{0.0, 0.0};
+        double cell_m_ = 1.0;
+        uint32_t nx_ = 0;
+        uint32_t ny_ = 0;
+        // Per cell, sensors that can see its center and the best subset over all of them.
+        std::vector<uint64_t> visible_;
+        std::vector<Choice> best_;
+        std::unique_ptr<SeqLock<Degraded>[]> degraded_;
+        // Cell of the last fix, written only when the drone changes cell.
+        alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> last_cell_{NO_CELL};
+
+        Point center(uint32_t cell) const;
+        Choice search(uint32_t cell, uint64_t live) const;
+
+    // --- Public method declarations ---
+    public:
+        // sensors is the mask of slots in use, positions_by_slot as for MultilaterationEngine.
+        SubsetGrid(std::vector<Point> positions_by_slot, uint64_t sensors, const SubsetSelectionConfig& config);
+        ~SubsetGrid();
+
+        SubsetGrid(const SubsetGrid&) = delete;
+        SubsetGrid& operator=(const SubsetGrid&) = delete;
+
+        // NO_CELL outside the grid.
+        uint32_t cell_of(const Point& p) const;
+
+        /**
+            * @brief Best subset of the live sensors for a cell. Thread-safe, never takes a lock.
+            *
+            * The stored subset if all of its sensors are live, else the cached or
+            * newly searched best subset of the live ones. A miss searches once and
+            * caches the result, evicting an older entry of the same probe window.
+        */
+        Choice choose(uint32_t cell, uint64_t live);
+
+        uint32_t last_cell() const { return last_cell_.load(std::memory_order_relaxed); }
+        void note_fix(const Point& p) {
+            const uint32_t cell = cell_of(p);
+            if (cell != last_cell()) last_cell_.store(cell, std::memory_order_relaxed);
+        }
+
+        size_t cells() const { return best_.size(); }
+        double cell_m() const { return cell_m_; }
+        // Distinct best subsets over all cells, what the solver cache is warmed with.
+        std::vector<uint64_t> best_masks() const;
+
+        /**
+            * @brief Dilution of precision of SubsetSolver for mask at a point.
+            *
+            * With independent range errors of 1 m standard deviation, the solver's
+            * b has covariance 4 (d0^2 11^T + diag(di^2)), so the position error has
+            * covariance M C M^T. Returns the square root of its trace, infinity
+            * for fewer than three sensors or a degenerate subset.
+        */
+        static double dilution(uint64_t mask, const std::vector<Point>& positions_by_slot, const Point& at);
+};
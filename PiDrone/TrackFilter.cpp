@@ -0,0 +1,183 @@
+/**
+    * @file TrackFilter.cpp
+    * @brief Kalman smoothing of raw fixes and fixed-rate extrapolation of the track.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "TrackFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+// --- End Imports ---
+
+namespace {
+
+int64_t to_ns(IngestClock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+double seconds_between(IngestClock::time_point from, IngestClock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+}
+
+TrackFilter::TrackFilter(TrackFilterConfig config) : config_(config) {
+    if (config_.model == TrackModel::ConstantAcceleration) {
+        filter_.emplace<KinematicKalman<3>>();
+    }
+    publish();
+}
+
+TrackFilter::~TrackFilter() {
+    stop_output();
+}
+
+/**
+    * @brief Copies the filter state into the seqlock snapshot read by extrapolate().
+    * Caller holds update_mutex_ (or is the constructor).
+*/
+void TrackFilter::publish() {
+    Snapshot snap{};
+    std::visit([&snap](const auto& filter) {
+        using Filter = std::decay_t<decltype(filter)>;
+        constexpr size_t order = Filter::STATE / 2;
+        const auto& x = filter.state();
+        for (size_t k = 0; k < order; ++k) {
+            snap.x[k] = x.m[Filter::X + k][0];
+            snap.y[k] = x.m[Filter::Y + k][0];
+        }
+        const auto& p = filter.covariance();
+        snap.position_sigma = std::sqrt(0.5 * (p.m[Filter::X][Filter::X] + p.m[Filter::Y][Filter::Y]));
+    }, filter_);
+    snap.at_ns = to_ns(last_update_);
+    snap.updates = updates_;
+    snapshot_.store(snap);
+}
+
+/**
+    * @brief Folds one fix into the track.
+    *
+    * The fix residual is used as its measurement sigma, floored at
+    * min_measurement_sigma. The first fix, and the first one after the track
+    * went stale, restarts the filter at the fix position with unknown motion.
+    * A fix older than the last update (solved out of order by another worker)
+    * is applied without a predict step.
+    *
+    * @param fix Output of DroneTracker::updateAndCalculate
+    * @param received_at Arrival time of the reading that produced the fix
+    * @return TrackState The filtered state at received_at
+*/
+TrackState TrackFilter::update(const Fix& fix, IngestClock::time_point received_at) {
+    const double sigma = std::max(config_.min_measurement_sigma, fix.residual_rms);
+    const double measurement_var = sigma * sigma;
+
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        const double dt = seconds_between(last_update_, received_at);
+        const bool restart = updates_ == 0 || dt > config_.max_coast_s;
+
+        std::visit([&](auto& filter) {
+            if (restart) {
+                const double motion_sigma = config_.initial_motion_sigma;
+                filter.reset(fix.position, measurement_var, motion_sigma * motion_sigma);
+            } else {
+                filter.predict(dt, config_.process_noise);
+                filter.update(fix.position, measurement_var);
+            }
+        }, filter_);
+
+        if (restart) updates_ = 0;
+        last_update_ = std::max(last_update_, received_at);
+        ++updates_;
+        publish();
+    }
+    return extrapolate(received_at);
+}
+
+bool TrackFilter::hand_over(TrackFilter& to, IngestClock::time_point at) {
+    std::scoped_lock lock(update_mutex_, to.update_mutex_);
+    auto live = [at](const TrackFilter& filter) {
+        return filter.updates_ > 0 && seconds_between(filter.last_update_, at) <= filter.config_.max_coast_s;
+    };
+    if (!live(*this) || live(to) || filter_.index() != to.filter_.index()) {
+        return false;
+    }
+    to.filter_ = filter_;
+    to.last_update_ = last_update_;
+    to.updates_ = updates_;
+    to.publish();
+    updates_ = 0;
+    publish();
+    return true;
+}
+
+/**
+    * @brief Predicts the track forward (or back) to an arbitrary instant.
+    *
+    * Pure kinematics on the last published state, the covariance is not
+    * propagated. The result is marked invalid before the first fix and once
+    * the last fix is more than max_coast_s old.
+*/
+TrackState TrackFilter::extrapolate(IngestClock::time_point at) const {
+    const Snapshot snap = snapshot_.load();
+    TrackState out;
+    out.at = at;
+    out.updates = snap.updates;
+    if (snap.updates == 0) {
+        return out;
+    }
+
+    const double dt = static_cast<double>(to_ns(at) - snap.at_ns) * 1e-9;
+    const double half_dt2 = 0.5 * dt * dt;
+    out.position = {snap.x[0] + snap.x[1] * dt + snap.x[2] * half_dt2,
+                    snap.y[0] + snap.y[1] * dt + snap.y[2] * half_dt2};
+    out.velocity = {snap.x[1] + snap.x[2] * dt, snap.y[1] + snap.y[2] * dt};
+    out.acceleration = {snap.x[2], snap.y[2]};
+    out.position_sigma = snap.position_sigma;
+    out.valid = dt <= config_.max_coast_s;
+    return out;
+}
+
+/**
+    * @brief Starts a thread that emits the extrapolated track at a fixed rate.
+    * Ticks are scheduled on absolute deadlines so the rate does not drift with
+    * the time spent in the handler.
+*/
+void TrackFilter::start_output(double rate_hz, OutputHandler handler) {
+    if (rate_hz <= 0.0) {
+        throw std::runtime_error("TrackFilter output rate must be positive");
+    }
+    stop_output();
+    output_stop_ = false;
+
+    const auto period = std::chrono::duration_cast<IngestClock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+    output_thread_ = std::thread([this, period, handler = std::move(handler)] {
+        auto next = IngestClock::now();
+        std::unique_lock<std::mutex> lock(output_mutex_);
+        while (true) {
+            next += period;
+            if (output_cv_.wait_until(lock, next, [this] { return output_stop_; })) {
+                return;
+            }
+            lock.unlock();
+            handler(extrapolate(next));
+            lock.lock();
+            // Skip ticks a slow handler missed instead of emitting a burst.
+            next = std::max(next, IngestClock::now() - period);
+        }
+    });
+}
+
+void TrackFilter::stop_output() {
+    {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        output_stop_ = true;
+    }
+    output_cv_.notify_all();
+    if (output_thread_.joinable()) {
+        output_thread_.join();
+    }
+}
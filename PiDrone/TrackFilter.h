@@ -0,0 +1,123 @@
+/**
+    * @file TrackFilter.h
+    * @brief Smoothing and prediction stage that sits after the DroneTracker.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Raw fixes from the multilateration jitter with every range sample. The
+    * TrackFilter runs them through a constant-velocity (or constant-acceleration)
+    * Kalman filter and publishes the filtered state, which can then be
+    * extrapolated to any instant, e.g. on a fixed-rate output thread that keeps
+    * emitting positions between sensor updates.
+    *
+    * Fixes arrive from whichever executor worker solved them, so update() is
+    * serialized by a mutex. extrapolate() only reads a seqlock snapshot and
+    * never waits on an update.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <variant>
+#include "IngestSource.h"
+#include "KalmanFilter.h"
+#include "Multilateration.h"
+#include "SeqLock.h"
+
+enum class TrackModel {
+    ConstantVelocity,
+    ConstantAcceleration
+};
+
+struct TrackFilterConfig {
+    TrackModel model = TrackModel::ConstantVelocity;
+    // Standard deviation of the unmodelled acceleration (CV, m/s^2) or jerk (CA, m/s^3).
+    double process_noise = 2.0;
+    // Floor on the per-axis fix sigma, the residual of a 3-sensor fix is always zero.
+    double min_measurement_sigma = 0.25;
+    // Initial sigma of the velocity / acceleration terms of a new track.
+    double initial_motion_sigma = 10.0;
+    // A track with no fix for this long is stale and restarts on the next fix.
+    double max_coast_s = 2.0;
+};
+
+/**
+    * @struct TrackState
+    * @brief Filtered (or extrapolated) kinematic state of the drone at one instant.
+*/
+struct TrackState {
+    Point position;
+    Point velocity;
+    Point acceleration;             // always zero for the constant-velocity model
+    double position_sigma = 0.0;    // per axis, at the last update, in meters
+    IngestClock::time_point at;
+    uint64_t updates = 0;           // fixes folded into this track
+    bool valid = false;             // false before the first fix and once the track is stale
+};
+
+class TrackFilter {
+    public:
+        using OutputHandler = std::function<void(const TrackState&)>;
+
+    // --- Private var declaration to be used ---
+    private:
+        // What extrapolate() needs, published after every update.
+        struct Snapshot {
+            double x[3];
+            double y[3];
+            double position_sigma;
+            int64_t at_ns;
+            uint64_t updates;
+        };
+
+        TrackFilterConfig config_;
+        std::mutex update_mutex_;
+        std::variant<KinematicKalman<2>, KinematicKalman<3>> filter_;
+        IngestClock::time_point last_update_;
+        uint64_t updates_ = 0;
+        SeqLock<Snapshot> snapshot_;
+
+        std::thread output_thread_;
+        std::mutex output_mutex_;
+        std::condition_variable output_cv_;
+        bool output_stop_ = false;
+
+        void publish();
+
+    // --- Public method declarations ---
+    public:
+        explicit TrackFilter(TrackFilterConfig config = {});
+        ~TrackFilter();
+
+        TrackFilter(const TrackFilter&) = delete;
+        TrackFilter& operator=(const TrackFilter&) = delete;
+
+        // Folds one fix in and returns the filtered state at received_at. Thread-safe.
+        TrackState update(const Fix& fix, IngestClock::time_point received_at);
+
+        // Predicted state at the given instant from the last published update. Never blocks.
+        TrackState extrapolate(IngestClock::time_point at) const;
+
+        /**
+            * @brief Moves the track into another filter, for a drone crossing into a neighbouring zone.
+            *
+            * Does nothing and returns false unless this filter has a live track at
+            * `at` and `to` has none, and both run the same model. On success `to`
+            * continues with the full state and covariance, and this filter has no
+            * track until its next fix. Thread-safe, never call it with to == this.
+        */
+        bool hand_over(TrackFilter& to, IngestClock::time_point at);
+
+        // Calls handler with extrapolate(now) rate_hz times per second until stop_output().
+        void start_output(double rate_hz, OutputHandler handler);
+        void stop_output();
+
+        const TrackFilterConfig& config() const { return config_; }
+};
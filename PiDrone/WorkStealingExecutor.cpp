@@ -0,0 +1,196 @@
+/**
+    * @file WorkStealingExecutor.cpp
+    * @brief Work-stealing pool used to run NodeManager task chains.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "WorkStealingExecutor.h"
+// --- End Imports ---
+
+namespace {
+    thread_local int t_worker_index = -1;
+    thread_local const WorkStealingExecutor* t_executor = nullptr;
+}
+
+bool ChaseLevDeque::push(ExecutorTask* task) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY) {
+        return false;
+    }
+    buffer_[b & MASK].store(task, std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+ExecutorTask* ChaseLevDeque::pop() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    ExecutorTask* task = buffer_[b & MASK].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last element, race against thieves for it.
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+ExecutorTask* ChaseLevDeque::steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return nullptr;
+    }
+    ExecutorTask* task = buffer_[t & MASK].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return task;
+}
+
+WorkStealingExecutor::WorkStealingExecutor(size_t threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+    }
+
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread(&WorkStealingExecutor::worker_loop, this, i);
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    stop_flag_ = true;
+    for (auto& worker : workers_) {
+        worker->waiter.notify();
+    }
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+int WorkStealingExecutor::current_worker() {
+    return t_worker_index;
+}
+
+void WorkStealingExecutor::submit(ExecutorTask* task) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+
+    if (t_executor == this && workers_[t_worker_index]->local.push(task)) {
+        wake_one();
+        return;
+    }
+
+    push_inbox(*workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size()], task);
+}
+
+void WorkStealingExecutor::submit(ExecutorTask* task, size_t home_worker) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+
+    const size_t home = home_worker % workers_.size();
+    if (t_executor == this && static_cast<size_t>(t_worker_index) == home && workers_[home]->local.push(task)) {
+        wake_one();
+        return;
+    }
+    push_inbox(*workers_[home], task);
+}
+
+void WorkStealingExecutor::push_inbox(Worker& target, ExecutorTask* task) {
+    {
+        std::lock_guard<std::mutex> lock(target.inbox_mutex);
+        target.inbox.push_back(task);
+    }
+    // A busy target will not get to it soon, let a parked worker steal it instead.
+    if (target.waiter.parked()) {
+        target.waiter.notify();
+    } else {
+        wake_one();
+    }
+}
+
+/**
+    * @brief Wakes one parked worker so queued work can be stolen.
+    *
+    * Cheap when nobody is parked: one fence and a load per worker.
+*/
+void WorkStealingExecutor::wake_one() {
+    for (auto& worker : workers_) {
+        if (worker->waiter.parked()) {
+            worker->waiter.notify();
+            return;
+        }
+    }
+}
+
+ExecutorTask* WorkStealingExecutor::pop_inbox(Worker& worker, bool blocking) {
+    std::unique_lock<std::mutex> lock(worker.inbox_mutex, std::defer_lock);
+    if (blocking) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return nullptr;
+    }
+    if (worker.inbox.empty()) {
+        return nullptr;
+    }
+    ExecutorTask* task = worker.inbox.front();
+    worker.inbox.pop_front();
+    return task;
+}
+
+ExecutorTask* WorkStealingExecutor::find_task(size_t index) {
+    Worker& self = *workers_[index];
+
+    if (ExecutorTask* task = self.local.pop()) return task;
+    if (ExecutorTask* task = pop_inbox(self, true)) return task;
+
+    // Steal, starting from our neighbour so thieves spread out.
+    for (size_t i = 1; i < workers_.size(); ++i) {
+        Worker& victim = *workers_[(index + i) % workers_.size()];
+        if (ExecutorTask* task = victim.local.steal()) return task;
+        if (ExecutorTask* task = pop_inbox(victim, false)) return task;
+    }
+    return nullptr;
+}
+
+void WorkStealingExecutor::worker_loop(size_t index) {
+    t_worker_index = static_cast<int>(index);
+    t_executor = this;
+    Worker& self = *workers_[index];
+
+    while (true) {
+        if (ExecutorTask* task = find_task(index)) {
+            // More work queued than we can take, get another worker going.
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) > 1) {
+                wake_one();
+            }
+            task->run();
+            continue;
+        }
+
+        if (stop_flag_ && pending_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+        self.waiter.wait([this] {
+            return pending_.load(std::memory_order_acquire) > 0 || stop_flag_.load(std::memory_order_relaxed);
+        });
+    }
+}
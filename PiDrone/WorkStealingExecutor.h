@@ -0,0 +1,113 @@
+/**
+    * @file WorkStealingExecutor.h
+    * @brief Fixed-size work-stealing thread pool shared by all NodeManagers.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Every worker owns a lock-free Chase-Lev deque for tasks it spawns itself and
+    * a small mutex-protected inbox for tasks submitted from outside the pool (the
+    * ingest thread). Idle workers steal from the top of other workers' deques and
+    * inboxes before spinning and finally parking.
+    *
+    * Tasks are intrusive (ExecutorTask) so submitting one never allocates.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SpinParkWaiter.h"
+
+/**
+    * @class ExecutorTask
+    * @brief Unit of work run by the executor. The submitter owns the object.
+*/
+class ExecutorTask {
+    public:
+        virtual ~ExecutorTask() = default;
+        virtual void run() = 0;
+};
+
+/**
+    * @class ChaseLevDeque
+    * @brief Fixed-capacity work-stealing deque (Chase & Lev, C11 formulation by Le et al.).
+    *
+    * push() and pop() may only be called by the owning worker, steal() by anyone.
+*/
+class ChaseLevDeque {
+    private:
+        static constexpr int64_t CAPACITY = 1024;
+        static constexpr int64_t MASK = CAPACITY - 1;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom_{0};
+        std::atomic<ExecutorTask*> buffer_[CAPACITY] = {};
+
+    public:
+        bool push(ExecutorTask* task);
+        ExecutorTask* pop();
+        ExecutorTask* steal();
+};
+
+class WorkStealingExecutor {
+    // --- Private var declaration to be used ---
+    private:
+        struct alignas(CACHE_LINE_SIZE) Worker {
+            ChaseLevDeque local;
+            std::mutex inbox_mutex;
+            std::deque<ExecutorTask*> inbox;
+            SpinParkWaiter waiter;
+            std::thread thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> pending_{0};
+        std::atomic<size_t> next_worker_{0};
+        std::atomic<bool> stop_flag_{false};
+
+        void worker_loop(size_t index);
+        ExecutorTask* find_task(size_t index);
+        ExecutorTask* pop_inbox(Worker& worker, bool blocking);
+        void wake_one();
+        void push_inbox(Worker& target, ExecutorTask* task);
+
+    // --- Public method declarations ---
+    public:
+        // threads == 0 sizes the pool to std::thread::hardware_concurrency().
+        explicit WorkStealingExecutor(size_t threads = 0);
+
+        // Runs every task that is still queued, then joins the workers.
+        ~WorkStealingExecutor();
+
+        WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+        WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+        /**
+            * @brief Queues a task. Safe to call from any thread.
+            *
+            * From a worker thread the task goes onto that worker's own deque, from
+            * anywhere else it goes into the inbox of the next worker in round robin order.
+        */
+        void submit(ExecutorTask* task);
+
+        /**
+            * @brief Queues a task on a preferred worker, home_worker modulo size().
+            *
+            * On that worker the task goes onto its own deque, from anywhere else
+            * into its inbox, so related tasks keep running where their data is
+            * cached. Idle workers may still steal it.
+        */
+        void submit(ExecutorTask* task, size_t home_worker);
+
+        size_t size() const { return workers_.size(); }
+
+        // Index of the calling worker, or -1 when called from outside the pool.
+        static int current_worker();
+};
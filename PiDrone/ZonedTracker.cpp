@@ -0,0 +1,186 @@
+/**
+    * @file ZonedTracker.cpp
+    * @brief Zone lookup, handoff between neighbouring zones, and the zone file reader.
+    * @version 1.0
+    * @date 2026-10-16
+*/
+
+// --- Imports ---
+#include "ZonedTracker.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+// --- End Imports ---
+
+namespace {
+
+Point read_point(const nlohmann::json& j) {
+    if (!j.is_array() || j.size() != 2) throw std::runtime_error("points are written as [x, y]");
+    return {j[0].get<double>(), j[1].get<double>()};
+}
+
+} // namespace
+
+std::vector<ZoneConfig> load_zones(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("Cannot open zones " + path);
+
+    std::vector<ZoneConfig> zones;
+    try {
+        const nlohmann::json j = nlohmann::json::parse(file);
+        for (const auto& z : j.at("zones")) {
+            ZoneConfig zone;
+            zone.name = z.at("name").get<std::string>();
+            zone.margin_m = z.value("margin_m", zone.margin_m);
+            if (z.contains("area")) {
+                const nlohmann::json& area = z.at("area");
+                if (!area.is_array() || area.size() != 2) throw std::runtime_error("area is written as [[x0, y0], [x1, y1]]");
+                zone.area_min = read_point(area[0]);
+                zone.area_max = read_point(area[1]);
+            }
+            for (const auto& [id, position] : z.at("sensors").items()) {
+                zone.sensor_positions[id] = read_point(position);
+            }
+            zones.push_back(std::move(zone));
+        }
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Invalid zones " + path + ": " + e.what());
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error("Invalid zones " + path + ": " + e.what());
+    }
+    return zones;
+}
+
+ZonedTracker::ZonedTracker(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry,
+                           const SubsetSelectionConfig& selection)
+    : ZonedTracker(std::vector<ZoneConfig>{ZoneConfig{"site", sensor_positions}}, registry, selection) {}
+
+ZonedTracker::ZonedTracker(const std::vector<ZoneConfig>& zones, SensorRegistry& registry, const SubsetSelectionConfig& selection)
+    : zones_(new Zone[zones.size()]), zone_count_(zones.size()) {
+    if (zones.empty() || zones.size() >= NO_ZONE) {
+        throw std::runtime_error("ZonedTracker needs between 1 and " + std::to_string(NO_ZONE - 1) + " zones");
+    }
+    for (size_t z = 0; z < zone_count_; ++z) {
+        zones_[z].name = zones[z].name;
+        zones_[z].tracker = std::make_unique<DroneTracker>(zones[z].sensor_positions, registry, selection);
+    }
+    layout_.store(build_layout(zones, registry).release(), std::memory_order_release);
+}
+
+// Nothing may be updating by now, so the current layout goes straight away.
+ZonedTracker::~ZonedTracker() {
+    delete layout_.load(std::memory_order_relaxed);
+}
+
+std::unique_ptr<const ZonedTracker::Layout> ZonedTracker::build_layout(const std::vector<ZoneConfig>& zones,
+                                                                       const SensorRegistry& registry) const {
+    auto layout = std::make_unique<Layout>();
+    layout->areas.resize(zones.size());
+    for (size_t z = 0; z < zones.size(); ++z) {
+        const ZoneConfig& config = zones[z];
+        ZoneArea& area = layout->areas[z];
+
+        for (const auto& pair : config.sensor_positions) {
+            const SensorHandle handle = registry.find_sensor(pair.first);
+            if (handle == INVALID_SENSOR) continue;
+            if (handle >= layout->zone_of_handle.size()) {
+                layout->zone_of_handle.resize(handle + 1, NO_ZONE);
+            }
+            if (layout->zone_of_handle[handle] != NO_ZONE) {
+                throw std::runtime_error("Sensor " + pair.first + " is in zones " + zones[layout->zone_of_handle[handle]].name
+                                         + " and " + config.name);
+            }
+            layout->zone_of_handle[handle] = static_cast<uint16_t>(z);
+        }
+
+        if (config.area_min.x != config.area_max.x || config.area_min.y != config.area_max.y) {
+            area.area_min = {std::min(config.area_min.x, config.area_max.x), std::min(config.area_min.y, config.area_max.y)};
+            area.area_max = {std::max(config.area_min.x, config.area_max.x), std::max(config.area_min.y, config.area_max.y)};
+        } else if (!config.sensor_positions.empty()) {
+            area.area_min = area.area_max = config.sensor_positions.begin()->second;
+            for (const auto& pair : config.sensor_positions) {
+                area.area_min = {std::min(area.area_min.x, pair.second.x), std::min(area.area_min.y, pair.second.y)};
+                area.area_max = {std::max(area.area_max.x, pair.second.x), std::max(area.area_max.y, pair.second.y)};
+            }
+            area.area_min = {area.area_min.x - config.margin_m, area.area_min.y - config.margin_m};
+            area.area_max = {area.area_max.x + config.margin_m, area.area_max.y + config.margin_m};
+        }
+    }
+
+    // A zone only hands off to zones whose area comes within its margin, fixes farther out stay with it.
+    for (size_t z = 0; z < zones.size(); ++z) {
+        const double margin = zones[z].margin_m;
+        const ZoneArea& a = layout->areas[z];
+        for (size_t n = 0; n < zones.size(); ++n) {
+            if (n == z) continue;
+            const ZoneArea& b = layout->areas[n];
+            if (b.area_min.x <= a.area_max.x + margin && b.area_max.x >= a.area_min.x - margin
+                && b.area_min.y <= a.area_max.y + margin && b.area_max.y >= a.area_min.y - margin) {
+                layout->areas[z].neighbours.push_back(static_cast<uint16_t>(n));
+            }
+        }
+    }
+    return layout;
+}
+
+void ZonedTracker::reload(const std::vector<ZoneConfig>& zones, SensorRegistry& registry) {
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    if (zones.size() != zone_count_) {
+        throw std::runtime_error("Zones cannot be added or removed while running, restart to apply");
+    }
+    for (size_t z = 0; z < zone_count_; ++z) {
+        if (zones[z].name != zones_[z].name) {
+            throw std::runtime_error("Zone " + zones_[z].name + " became " + zones[z].name + ", restart to apply");
+        }
+    }
+
+    std::vector<std::unique_ptr<const DroneTracker::Geometry>> geometries;
+    for (size_t z = 0; z < zone_count_; ++z) {
+        geometries.push_back(zones_[z].tracker->build_geometry(zones[z].sensor_positions, registry));
+    }
+    std::unique_ptr<const Layout> layout = build_layout(zones, registry);
+
+    // Nothing below throws.
+    for (size_t z = 0; z < zone_count_; ++z) {
+        zones_[z].tracker->publish(std::move(geometries[z]));
+    }
+    epoch_domain().retire(layout_.exchange(layout.release(), std::memory_order_acq_rel));
+}
+
+std::optional<Fix> ZonedTracker::updateAndCalculate(SensorHandle sensor, double distance, long long timestamp_ms,
+                                                    IngestClock::time_point received_at) {
+    // The zone's tracker enters its own guard, nested in this one it costs nothing more.
+    EpochDomain::Guard guard;
+    const Layout& layout = *layout_.load(std::memory_order_acquire);
+    const uint16_t z = layout.zone_of(sensor);
+    if (z == NO_ZONE) {
+        return std::nullopt;
+    }
+    Zone& zone = zones_[z];
+    std::optional<Fix> fix = zone.tracker->updateAndCalculate(sensor, distance, timestamp_ms, received_at);
+    if (!fix) {
+        return fix;
+    }
+
+    fix->zone = fix->source_zone = z;
+    // Inside its own area a fix stays put even where areas overlap, so it does not flap between zones.
+    const ZoneArea& area = layout.areas[z];
+    if (!inside(area, fix->position)) {
+        for (const uint16_t n : area.neighbours) {
+            if (inside(layout.areas[n], fix->position)) {
+                fix->zone = n;
+                zone.handed_off.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+    return fix;
+}
+
+void ZonedTracker::withdraw(SensorHandle sensor) {
+    EpochDomain::Guard guard;
+    const uint16_t z = layout_.load(std::memory_order_acquire)->zone_of(sensor);
+    if (z != NO_ZONE) {
+        zones_[z].tracker->withdraw(sensor);
+    }
+}
@@ -0,0 +1,155 @@
+/**
+    * @file ZonedTracker.h
+    * @brief Sensors grouped into zones, each solved by its own DroneTracker shard.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * One tracker process can watch several separate areas, each covered by
+    * its own cluster of sensors. Ranges of sensors in different zones must
+    * never be combined into one solve, and a zone's updates should not touch
+    * any state of another zone, so every zone gets its own DroneTracker:
+    * its own range slots, fresh mask and cached solver subsets. A sensor
+    * belongs to exactly one zone and the zone is looked up by SensorHandle,
+    * the shards share nothing and zones solve fully in parallel.
+    *
+    * Every zone protects an area, by default the bounding box of its sensors
+    * grown by margin_m. A fix is reported as belonging to the zone whose area
+    * it falls in: a fix a zone solves outside its own area, inside the area
+    * of a neighbouring zone, is handed off to that zone (Fix::zone), so a
+    * drone crossing from one area into the next keeps being reported where
+    * it is. Zones are neighbours if their areas come within margin_m of each
+    * other, only those are checked.
+    *
+    * reload() replaces the sensor positions, zone membership and areas while
+    * updates keep running, the set of zones itself is fixed for the tracker's
+    * lifetime. Like each zone's geometry (see DroneTracker), the zone lookup
+    * and areas are one immutable Layout behind an atomic pointer, reclaimed
+    * through epoch_domain().
+    *
+    * Zones are described in JSON, see load_zones():
+    *
+    *   {
+    *     "zones": [
+    *       {"name": "north", "margin_m": 2, "area": [[-2, -2], [7, 6]],
+    *        "sensors": {"esp32_1/radar_A": [0, 0], "esp32_2/radar_A": [5, 0]}}
+    *     ]
+    *   }
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "DroneTracker.h"
+#include "SensorRegistry.h"
+
+struct ZoneConfig {
+    std::string name;
+    // "<esp_id>/<sensor_id>" to position, in the one coordinate frame all zones share.
+    std::map<std::string, Point> sensor_positions;
+    // Left equal, the area is the bounding box of the sensors grown by margin_m.
+    Point area_min{0.0, 0.0};
+    Point area_max{0.0, 0.0};
+    double margin_m = 2.0;
+};
+
+// Reads zones as documented above, throws std::runtime_error if they cannot be read or are invalid.
+std::vector<ZoneConfig> load_zones(const std::string& path);
+
+class ZonedTracker {
+    public:
+        static constexpr uint16_t NO_ZONE = 0xFFFF;
+
+    // --- Private var declaration to be used ---
+    private:
+        // Each zone on its own cache lines, nothing in it is written by another zone's updaters.
+        struct alignas(CACHE_LINE_SIZE) Zone {
+            std::string name;
+            std::unique_ptr<DroneTracker> tracker;
+            std::atomic<uint64_t> handed_off{0};
+        };
+
+        struct ZoneArea {
+            Point area_min;
+            Point area_max;
+            std::vector<uint16_t> neighbours;
+        };
+
+        // Everything reload() can change besides the zones' own geometry, never changed once published.
+        struct Layout {
+            // SensorHandle -> zone, NO_ZONE for sensors no zone uses.
+            std::vector<uint16_t> zone_of_handle;
+            std::vector<ZoneArea> areas;
+
+            uint16_t zone_of(SensorHandle sensor) const {
+                return sensor < zone_of_handle.size() ? zone_of_handle[sensor] : NO_ZONE;
+            }
+        };
+
+        std::unique_ptr<Zone[]> zones_;
+        size_t zone_count_ = 0;
+        std::atomic<const Layout*> layout_{nullptr};
+        std::mutex reload_mutex_;
+
+        std::unique_ptr<const Layout> build_layout(const std::vector<ZoneConfig>& zones, const SensorRegistry& registry) const;
+
+        static bool inside(const ZoneArea& area, const Point& p) {
+            return p.x >= area.area_min.x && p.x <= area.area_max.x && p.y >= area.area_min.y && p.y <= area.area_max.y;
+        }
+
+    // --- Public method declarations ---
+    public:
+        ZonedTracker(const std::vector<ZoneConfig>& zones, SensorRegistry& registry, const SubsetSelectionConfig& selection = {});
+        // A single zone holding every sensor, what a one-room setup uses.
+        ZonedTracker(const std::map<std::string, Point>& sensor_positions, SensorRegistry& registry,
+                     const SubsetSelectionConfig& selection = {});
+
+        ~ZonedTracker();
+
+        ZonedTracker(const ZonedTracker&) = delete;
+        ZonedTracker& operator=(const ZonedTracker&) = delete;
+
+        /**
+            * @brief Passes the range to the tracker of the sensor's zone and assigns any fix to a zone.
+            *
+            * Same contract as DroneTracker::updateAndCalculate(), Fix::sensor_mask
+            * refers to the slots of the zone that solved it (Fix::source_zone).
+        */
+        std::optional<Fix> updateAndCalculate(SensorHandle sensor, double distance, long long timestamp_ms = 0,
+                                              IngestClock::time_point received_at = {});
+
+        // See DroneTracker::withdraw().
+        void withdraw(SensorHandle sensor);
+
+        /**
+            * @brief Replaces sensor positions, zone membership and areas without stopping updates.
+            *
+            * zones must name the same zones in the same order as the tracker was
+            * built with. Every zone's geometry and the new layout are built first,
+            * on the calling thread, so on any error (std::runtime_error) nothing
+            * changes. Then each zone's geometry is swapped in, and the layout last:
+            * every update solves on one complete geometry of its zone, a sensor that
+            * moves to another zone loses the readings that arrive during the swap.
+        */
+        void reload(const std::vector<ZoneConfig>& zones, SensorRegistry& registry);
+
+        bool tracks(SensorHandle sensor) const { return zone_of(sensor) != NO_ZONE; }
+        uint16_t zone_of(SensorHandle sensor) const {
+            EpochDomain::Guard guard;
+            return layout_.load(std::memory_order_acquire)->zone_of(sensor);
+        }
+
+        size_t zone_count() const { return zone_count_; }
+        const std::string& zone_name(size_t zone) const { return zones_[zone].name; }
+        DroneTracker& zone_tracker(size_t zone) { return *zones_[zone].tracker; }
+        // Fixes the zone solved but handed off to a neighbour.
+        uint64_t handed_off(size_t zone) const { return zones_[zone].handed_off.load(std::memory_order_relaxed); }
+};
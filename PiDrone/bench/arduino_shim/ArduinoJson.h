@@ -0,0 +1,19 @@
+/**
+    * @file ArduinoJson.h
+    * @brief Host stand-in for the ArduinoJson names the ESP32 firmware headers use.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Just enough to compile DroneSensor.h and BatchFrame.h off target, so the
+    * firmware encoders can be checked against the Pi decoders in the benchmarks.
+*/
+
+// --- ensure single compilation ---
+#pragma once
+
+// --- import statements ---
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+class JsonDocument {};
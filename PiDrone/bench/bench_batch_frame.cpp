@@ -0,0 +1,191 @@
+/**
+    * @file bench_batch_frame.cpp
+    * @brief Round trip and per-reading cost of batched frames vs. a message per reading.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Drives the firmware's BatchFrameBuilder on the host, through the Arduino
+    * shim, with sensors that report at random in every polling cycle, flushing
+    * full frames the way Sensor_node_1.ino does. Every frame is decoded with the
+    * Pi's BatchFrameView and must give back each reading, in order, with its
+    * own timestamp and sequence number. Every truncation of a frame must be
+    * rejected. Then compares bytes and messages on the wire and decode time per
+    * reading against publishing each reading on its own topic.
+    *
+    * Usage: bench_batch_frame [cycles] [sensors]
+*/
+
+// --- Imports ---
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../SensorModel.h"
+// --- End Imports ---
+
+// Both sides call their reading SensorData, keep the firmware's apart. The C
+// headers it pulls in are already included above, so nothing else lands in here.
+namespace firmware {
+#include "../../ESP32_base_MQTT_protocol/Sensor_node_1/Sensor_node_1/BatchFrame.h"
+} // namespace firmware
+
+namespace {
+
+// Topic prefix of the firmware, "drones/data/<esp_id>/".
+const size_t TOPIC_PREFIX_SIZE = std::char_traits<char>::length("drones/data/esp32_1/");
+// MQTT PUBLISH at QoS 0: fixed header (1 byte + 1 length byte below 128) and the 2 byte topic length.
+const size_t MQTT_OVERHEAD = 4;
+
+template <typename Fn>
+double time_it(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+class HostSensor : public firmware::DroneSensor {
+    public:
+        HostSensor(const char* id, uint8_t type) {
+            sensorId_ = id;
+            sensorType_ = type;
+        }
+
+        bool initialize() override { return true; }
+        bool readData() override { return true; }
+        void buildJsonPayload(firmware::JsonDocument&) override {}
+
+        void set(bool presence, float range, float speed, unsigned long timestamp) {
+            latestData_.presence = presence;
+            latestData_.range_m = range;
+            latestData_.speed_ms = speed;
+            latestData_.timestamp_ms = timestamp;
+        }
+};
+
+struct Reading {
+    size_t sensor;
+    SensorData data;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t cycles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    size_t sensor_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+    if (sensor_count == 0) sensor_count = 1;
+
+    std::vector<std::string> ids(sensor_count);
+    std::vector<HostSensor> sensors;
+    sensors.reserve(sensor_count);
+    for (size_t s = 0; s < sensor_count; ++s) {
+        ids[s] = s % 2 ? "radar_RCWL_" + std::to_string(s) : "radar_C4001_" + std::to_string(s);
+        sensors.emplace_back(ids[s].c_str(), s % 2 ? firmware::SENSOR_TYPE_RCWL : firmware::SENSOR_TYPE_C4001);
+    }
+
+    std::mt19937_64 rng(12);
+    std::uniform_real_distribution<float> range(0.6f, 12.0f);
+    std::uniform_real_distribution<float> speed(-5.0f, 5.0f);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    // Firmware side: a polling cycle every 100 ms, each sensor reports with 70% probability.
+    std::vector<std::string> frames;
+    std::vector<std::string> singles;
+    std::vector<Reading> sent;
+    size_t single_bytes = 0;
+    firmware::BatchFrameBuilder batch;
+    auto flush = [&] {
+        if (batch.empty()) return;
+        frames.emplace_back(reinterpret_cast<const char*>(batch.data()), batch.size());
+        batch.clear();
+    };
+    for (size_t cycle = 0; cycle < cycles; ++cycle) {
+        const unsigned long now = 5000 + static_cast<unsigned long>(cycle) * 100;
+        for (size_t s = 0; s < sensor_count; ++s) {
+            if (percent(rng) >= 70) continue;
+            const bool presence = percent(rng) < 90;
+            HostSensor& sensor = sensors[s];
+            sensor.set(presence, range(rng), speed(rng), now + s);
+
+            // The same reading as a message of its own, for the comparison.
+            uint8_t single[BINARY_PAYLOAD_SIZE];
+            HostSensor copy = sensor;
+            copy.buildBinaryPayload(single, sizeof(single));
+            singles.emplace_back(reinterpret_cast<const char*>(single), sizeof(single));
+            single_bytes += MQTT_OVERHEAD + TOPIC_PREFIX_SIZE + ids[s].size() + sizeof(single);
+
+            Reading r{s, SensorData::from_binary(singles.back())};
+            sent.push_back(r);
+            if (!batch.add(sensor)) {
+                flush();
+                if (!batch.add(sensor)) {
+                    std::printf("reading of %s does not fit an empty frame\n", ids[s].c_str());
+                    return 1;
+                }
+            }
+        }
+        flush();
+    }
+
+    // Pi side: decode every frame and compare against what was sent.
+    size_t next = 0, frame_bytes = 0;
+    std::vector<uint32_t> last_sequence(sensor_count, 0);
+    for (const std::string& frame : frames) {
+        frame_bytes += MQTT_OVERHEAD + TOPIC_PREFIX_SIZE + BATCH_SENSOR_ID.size() + frame.size();
+        BatchFrameView view(frame);
+        if (!view.valid()) {
+            std::printf("frame %zu rejected\n", static_cast<size_t>(&frame - frames.data()));
+            return 1;
+        }
+        bool ok = true;
+        view.for_each([&](std::string_view id, std::string_view reading) {
+            const Reading& expected = sent[next++];
+            SensorData d = SensorData::from_binary(reading);
+            ok = ok && id == ids[expected.sensor] && d.timestamp_ms == expected.data.timestamp_ms
+                 && d.presence == expected.data.presence && d.range == expected.data.range
+                 && d.speed == expected.data.speed && d.sensor_type == expected.data.sensor_type
+                 // The copy used for the single message did not advance the real sensor's sequence.
+                 && d.sequence == last_sequence[expected.sensor]++;
+        });
+        if (!ok) {
+            std::printf("frame %zu does not match the readings sent\n", static_cast<size_t>(&frame - frames.data()));
+            return 1;
+        }
+        for (size_t cut = 0; cut < frame.size(); ++cut) {
+            if (BatchFrameView(std::string_view(frame.data(), cut)).valid()) {
+                std::printf("truncated frame accepted\n");
+                return 1;
+            }
+        }
+    }
+    if (next != sent.size()) {
+        std::printf("decoded %zu readings, sent %zu\n", next, sent.size());
+        return 1;
+    }
+
+    double sink = 0.0;
+    double single_s = time_it([&] {
+        for (const std::string& p : singles) sink += SensorData::from_binary(p).range;
+    });
+    double batch_s = time_it([&] {
+        for (const std::string& f : frames) {
+            BatchFrameView view(f);
+            if (!view.valid()) continue;
+            view.for_each([&](std::string_view, std::string_view reading) { sink += SensorData::from_binary(reading).range; });
+        }
+    });
+
+    const double n = static_cast<double>(sent.size());
+    std::printf("readings: %zu from %zu sensors over %zu cycles, every frame round trips\n", sent.size(), sensor_count, cycles);
+    std::printf("%-22s %10.2f msgs/reading %8.1f bytes/reading %8.1f ns/reading\n", "message per reading",
+                1.0, single_bytes / n, single_s / n * 1e9);
+    std::printf("%-22s %10.2f msgs/reading %8.1f bytes/reading %8.1f ns/reading\n", "batched frames",
+                static_cast<double>(frames.size()) / n, frame_bytes / n, batch_s / n * 1e9);
+    std::printf("batched: %.1fx fewer messages, %.1fx fewer bytes (checksum %.1f)\n",
+                n / static_cast<double>(frames.size()), static_cast<double>(single_bytes) / frame_bytes, sink);
+    return 0;
+}
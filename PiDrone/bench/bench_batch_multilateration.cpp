@@ -0,0 +1,151 @@
+/**
+    * @file bench_batch_multilateration.cpp
+    * @brief Per-epoch trilaterate() vs. the batch SoA kernels on millions of epochs.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Every batch kernel's output is checked against the scalar batch kernel
+    * before its timing is reported.
+    *
+    * Usage: bench_batch_multilateration [epochs] [sensors]
+*/
+
+// --- Imports ---
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../BatchMultilateration.h"
+#include "../Multilateration.h"
+#include "../Trilateration.h"
+// --- End Imports ---
+
+namespace {
+
+template <typename Fn>
+double time_it(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, size_t epochs, double seconds, double baseline) {
+    std::printf("%-28s %10.1f Mepoch/s %8.2fx\n", name, epochs / seconds / 1e6, baseline / seconds);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t epochs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    size_t sensors = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 3;
+    if (sensors < 3) sensors = 3;
+
+    std::vector<Point> positions;
+    for (size_t i = 0; i < sensors; ++i) {
+        double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(sensors);
+        positions.push_back({5.0 * std::cos(angle), 5.0 * std::sin(angle)});
+    }
+    MultilaterationEngine engine(positions);
+    const SubsetSolver& solver = *engine.solver((uint64_t(1) << sensors) - 1);
+
+    // Random targets inside the array, ranges with 5 cm of noise.
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> pos(-3.0, 3.0);
+    std::normal_distribution<double> noise(0.0, 0.05);
+    std::vector<std::vector<double>> ranges(sensors, std::vector<double>(epochs));
+    for (size_t e = 0; e < epochs; ++e) {
+        Point t{pos(rng), pos(rng)};
+        for (size_t i = 0; i < sensors; ++i) {
+            ranges[i][e] = std::hypot(t.x - positions[i].x, t.y - positions[i].y) + noise(rng);
+        }
+    }
+    std::vector<const double*> columns;
+    for (auto& column : ranges) columns.push_back(column.data());
+
+    std::printf("epochs: %zu, sensors: %zu, best kernel: %s\n", epochs, sensors,
+                simd_level_name(detect_simd_level()));
+
+    volatile double sink = 0.0;
+    double baseline = 0.0;
+
+    if (sensors == 3) {
+        baseline = time_it([&] {
+            double acc = 0.0;
+            for (size_t e = 0; e < epochs; ++e) {
+                auto p = trilaterate(positions[0], ranges[0][e], positions[1], ranges[1][e],
+                                     positions[2], ranges[2][e]);
+                if (p) acc += p->x + p->y;
+            }
+            sink = acc;
+        });
+        report("trilaterate() per epoch", epochs, baseline, baseline);
+    }
+
+    double per_epoch = time_it([&] {
+        double acc = 0.0;
+        std::vector<double> slot_ranges(sensors);
+        for (size_t e = 0; e < epochs; ++e) {
+            for (size_t i = 0; i < sensors; ++i) slot_ranges[i] = ranges[i][e];
+            auto fix = solver.solve(slot_ranges.data());
+            if (fix) acc += fix->position.x + fix->position.y;
+        }
+        sink = acc;
+    });
+    if (baseline == 0.0) baseline = per_epoch;
+    report("SubsetSolver::solve per epoch", epochs, per_epoch, baseline);
+
+    RangeBatch input{columns.data(), epochs};
+
+    // Positions only, the same work trilaterate() does.
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) continue;
+
+        std::vector<double> x(epochs), y(epochs);
+        std::vector<uint8_t> valid(epochs);
+        PositionBatch output{x.data(), y.data(), nullptr, valid.data()};
+
+        double seconds = time_it([&] { multilaterate_batch(solver, input, output, INFINITY, level); });
+        char name[64];
+        std::snprintf(name, sizeof(name), "batch %s positions", simd_level_name(level));
+        report(name, epochs, seconds, baseline);
+    }
+
+    // Positions, residuals and a 0.5 m residual gate, checked against the scalar kernel.
+    std::vector<double> ref_x(epochs), ref_y(epochs), ref_res(epochs);
+    std::vector<uint8_t> ref_valid(epochs);
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (static_cast<int>(level) > static_cast<int>(detect_simd_level())) continue;
+
+        std::vector<double> x(epochs), y(epochs), res(epochs);
+        std::vector<uint8_t> valid(epochs);
+        PositionBatch output{x.data(), y.data(), res.data(), valid.data()};
+
+        size_t valid_count = 0;
+        double seconds = time_it([&] { valid_count = multilaterate_batch(solver, input, output, 0.5, level); });
+
+        if (level == SimdLevel::Scalar) {
+            ref_x = x; ref_y = y; ref_res = res; ref_valid = valid;
+        } else {
+            double max_err = 0.0;
+            size_t mismatched = 0;
+            for (size_t e = 0; e < epochs; ++e) {
+                max_err = std::max(max_err, std::max(std::abs(x[e] - ref_x[e]), std::abs(y[e] - ref_y[e])));
+                // Borderline residuals may land on either side of the threshold with FMA.
+                if (valid[e] != ref_valid[e] && std::abs(ref_res[e] - 0.5) > 1e-9) ++mismatched;
+            }
+            if (max_err > 1e-9 || mismatched) {
+                std::printf("!!! %s disagrees with scalar: max error %g, %zu validity mismatches\n",
+                            simd_level_name(level), max_err, mismatched);
+                return 1;
+            }
+        }
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "batch %s gated (%zu ok)", simd_level_name(level), valid_count);
+        report(name, epochs, seconds, baseline);
+    }
+    return 0;
+}
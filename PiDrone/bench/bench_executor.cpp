@@ -0,0 +1,160 @@
+/**
+    * @file bench_executor.cpp
+    * @brief Throughput vs. ESP node count: thread-per-node vs. the work-stealing executor.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * The legacy model is a faithful copy of the old NodeManager: one std::thread,
+    * a mutex + condition variable and a std::queue per node. Both models run the
+    * same per-message work (JSON parse, TrackedSensor update, DroneTracker update).
+    *
+    * Usage: bench_executor [total_messages] [max_nodes]
+*/
+
+// --- Imports ---
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../NodeManager.h"
+#include "../WorkStealingExecutor.h"
+#include "../ZonedTracker.h"
+#include "../SensorRegistry.h"
+// --- End Imports ---
+
+static std::atomic<size_t> g_processed{0};
+
+void process_sensor_update(const std::string&, const TrackedSensor&) {
+    g_processed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void process_drone_location(const Fix&, IngestClock::time_point) {}
+
+namespace {
+
+class LegacyNode {
+    private:
+        std::string esp_id_;
+        const SensorRegistry& registry_;
+        DroneTracker& tracker_;
+        std::map<std::string, TrackedSensor> sensors_;
+        std::queue<IngestMessage> msg_queue_;
+        std::mutex queue_mutex_;
+        std::condition_variable cv_;
+        std::atomic<bool> stop_flag_{false};
+        std::thread worker_;
+
+        void process_loop() {
+            while (true) {
+                IngestMessage msg;
+                {
+                    std::unique_lock<std::mutex> lock(queue_mutex_);
+                    cv_.wait(lock, [this] { return !msg_queue_.empty() || stop_flag_; });
+                    if (stop_flag_ && msg_queue_.empty()) return;
+                    msg = std::move(msg_queue_.front());
+                    msg_queue_.pop();
+                }
+
+                std::string sensor_id = msg.topic.substr(msg.topic.find_last_of('/') + 1);
+                std::string full_sensor_id = esp_id_ + "/" + sensor_id;
+                if (sensors_.find(sensor_id) == sensors_.end()) {
+                    sensors_.emplace(sensor_id, TrackedSensor(sensor_id));
+                }
+                auto& sensor = sensors_.at(sensor_id);
+                SensorData point = SensorData::from_json(nlohmann::json::parse(msg.payload));
+                sensor.addDataPoint(point);
+                process_sensor_update(esp_id_, sensor);
+                tracker_.updateAndCalculate(registry_.find_sensor(full_sensor_id), point.range);
+            }
+        }
+
+    public:
+        LegacyNode(std::string esp_id, const SensorRegistry& registry, DroneTracker& tracker)
+            : esp_id_(std::move(esp_id)), registry_(registry), tracker_(tracker),
+              worker_(&LegacyNode::process_loop, this) {}
+
+        ~LegacyNode() {
+            stop_flag_ = true;
+            cv_.notify_one();
+            worker_.join();
+        }
+
+        void add_message(IngestMessage&& msg) {
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                msg_queue_.push(std::move(msg));
+            }
+            cv_.notify_one();
+        }
+};
+
+std::vector<IngestMessage> make_messages(size_t nodes, SensorRegistry& registry) {
+    std::vector<IngestMessage> messages;
+    for (size_t i = 0; i < nodes; ++i) {
+        std::string full_id = "esp32_" + std::to_string(i) + "/radar_A";
+        messages.push_back({"drones/data/" + full_id,
+                            "{\"presence\":true,\"ts\":123456,\"range\":2.75,\"speed\":0.42}", {},
+                            registry.intern_sensor(full_id)});
+    }
+    return messages;
+}
+
+template <typename Node, typename MakeNode>
+double run_model(size_t nodes, size_t total, SensorRegistry& registry, MakeNode make_node) {
+    auto messages = make_messages(nodes, registry);
+    std::vector<std::unique_ptr<Node>> managers;
+    for (size_t i = 0; i < nodes; ++i) {
+        managers.push_back(make_node("esp32_" + std::to_string(i)));
+    }
+
+    g_processed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < total; ++i) {
+        IngestMessage msg = messages[i % nodes];
+        managers[i % nodes]->add_message(std::move(msg));
+    }
+    while (g_processed.load(std::memory_order_relaxed) < total) {
+        std::this_thread::yield();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    managers.clear();
+    return total / elapsed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 400000;
+    size_t max_nodes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+    std::map<std::string, Point> sensor_positions = {
+        {"esp32_0/radar_A", {0.0, 0.0}},
+        {"esp32_1/radar_A", {5.0, 0.0}},
+        {"esp32_2/radar_A", {2.5, 4.33}}
+    };
+    SensorRegistry registry;
+    ZonedTracker tracker(sensor_positions, registry);
+    WorkStealingExecutor executor;
+
+    std::printf("messages: %zu, pool workers: %zu\n", total, executor.size());
+    std::printf("%8s %18s %18s %8s\n", "nodes", "thread/node msg/s", "pool msg/s", "ratio");
+
+    for (size_t nodes = 1; nodes <= max_nodes; nodes *= 2) {
+        double legacy = run_model<LegacyNode>(nodes, total, registry, [&](std::string id) {
+            return std::make_unique<LegacyNode>(std::move(id), registry, tracker.zone_tracker(0));
+        });
+        double pooled = run_model<NodeManager>(nodes, total, registry, [&](std::string id) {
+            return std::make_unique<NodeManager>(registry.intern_node(id), registry, tracker, executor);
+        });
+        std::printf("%8zu %18.0f %18.0f %8.2f\n", nodes, legacy, pooled, pooled / legacy);
+    }
+    return 0;
+}
@@ -0,0 +1,309 @@
+/**
+    * @file bench_gdop.cpp
+    * @brief Fix accuracy and update cost with and without per-position sensor subset selection.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * A site wider than a radar can see: RADARS radars on the perimeter of a
+    * SITE_W x SITE_H m hall, 12 m reach, one drone flying at random inside.
+    * The simulated traffic goes through IngestRouter, NodeManager, the range
+    * filter and DroneTracker paced at PACED_RATE msg/s, every fix is scored
+    * against the ground truth as in bench_scenario, three ways:
+    *
+    *   all ranges   every sensor's latest range, also of radars that lost the drone
+    *   live ranges  radars that reported presence=false or went quiet left out
+    *   grid         live ranges, and of those the subset the SubsetGrid picks
+    *
+    * The grid row also reports the median dilution of precision it expected
+    * (Fix::dop), times the 0.05 m range noise that is about the error to expect.
+    *
+    * Then the cost of building the grid and of one update on a tracker with
+    * and without it, updates of a drone standing still at a known point, and
+    * of SubsetGrid::choose() with a sensor of the cell's subset out: first
+    * once for every such (cell, sensor) outage, far more than the cache holds,
+    * then over and over for a few of them, which must be cache hits again.
+    *
+    * Checked: the grid's fixes are no worse than all ranges at p95 and within
+    * P95_NOISE of live ranges, which scatter by a few percent between runs
+    * with the pacing, the dilution of precision of a collinear subset is
+    * infinite, and repeated outage lookups after the cache overflowed are at
+    * least HIT_SPEEDUP times cheaper than searching.
+    *
+    * Usage: bench_gdop [messages]
+*/
+
+// --- Imports ---
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ScenarioGenerator.h"
+#include "../IngestRouter.h"
+#include "../WorkStealingExecutor.h"
+#include "../ZonedTracker.h"
+#include "../SubsetGrid.h"
+#include "../SensorRegistry.h"
+// --- End Imports ---
+
+namespace {
+
+constexpr size_t RADARS = 12;
+constexpr size_t HOT_OUTAGES = 32;
+constexpr double HIT_SPEEDUP = 5.0;
+constexpr double P95_NOISE = 1.1;
+const double SITE_W = 24.0;
+const double SITE_H = 16.0;
+const double SAMPLE_HZ = 20.0;
+const double PACED_RATE = 20000.0;
+const size_t UPDATES = 2000000;
+
+std::atomic<size_t> g_processed{0};
+
+struct Scoring {
+    const ScenarioGenerator* generator = nullptr;
+    std::unique_ptr<IngestClock::time_point[]> received;
+    std::unique_ptr<double[]> sim_time;
+    std::atomic<size_t> routed{0};
+    std::unique_ptr<double[]> errors;
+    std::unique_ptr<double[]> dops;
+    std::atomic<size_t> fixes{0};
+    size_t capacity = 0;
+};
+
+Scoring g_scoring;
+
+} // namespace
+
+void process_sensor_update(const std::string&, const TrackedSensor&) {
+    g_processed.fetch_add(1, std::memory_order_release);
+}
+
+// The message that led to the fix is the last one routed at or before received_at.
+void process_drone_location(const Fix& fix, IngestClock::time_point received_at) {
+    const size_t routed = g_scoring.routed.load(std::memory_order_acquire);
+    const IngestClock::time_point* begin = g_scoring.received.get();
+    const size_t index = static_cast<size_t>(std::upper_bound(begin, begin + routed, received_at) - begin);
+    if (index == 0) return;
+    const Point p = g_scoring.generator->drone_position(0, g_scoring.sim_time[index - 1]);
+    const size_t slot = g_scoring.fixes.fetch_add(1, std::memory_order_relaxed);
+    if (slot < g_scoring.capacity) {
+        g_scoring.errors[slot] = std::hypot(fix.position.x - p.x, fix.position.y - p.y);
+        g_scoring.dops[slot] = fix.dop;
+    }
+}
+
+namespace {
+
+// Four radars on each long wall, two on each short one, one per node.
+ScenarioConfig hall() {
+    ScenarioConfig config;
+    const Point spots[RADARS] = {{0, 0}, {8, 0}, {16, 0}, {24, 0}, {0, 16}, {8, 16}, {16, 16}, {24, 16},
+                                 {0, 5.3}, {0, 10.7}, {24, 5.3}, {24, 10.7}};
+    for (size_t i = 0; i < RADARS; ++i) {
+        ScenarioNode node;
+        node.esp_id = "esp32_" + std::to_string(i + 1);
+        node.sensors.push_back({"radar_A", spots[i]});
+        config.nodes.push_back(node);
+    }
+    ScenarioDrone drone;
+    drone.random = true;
+    drone.speed_mps = 2.0;
+    config.drones.push_back(drone);
+    config.sample_hz = SAMPLE_HZ;
+    config.range_noise_m = 0.05;
+    config.dropout = 0.01;
+    config.max_range_m = 12.0;
+    config.area_min = {1.0, 1.0};
+    config.area_max = {SITE_W - 1.0, SITE_H - 1.0};
+    config.seed = 7;
+    return config;
+}
+
+struct AccuracyResult {
+    size_t fixes;
+    double p50;
+    double p95;
+    double dop_p50;
+};
+
+AccuracyResult accuracy(const SubsetSelectionConfig& selection, size_t count) {
+    const ScenarioConfig config = hall();
+    ScenarioGenerator generator(config);
+
+    g_scoring.generator = &generator;
+    g_scoring.received = std::make_unique<IngestClock::time_point[]>(count);
+    g_scoring.sim_time = std::make_unique<double[]>(count);
+    g_scoring.errors = std::make_unique<double[]>(count);
+    g_scoring.dops = std::make_unique<double[]>(count);
+    g_scoring.capacity = count;
+    g_scoring.routed = 0;
+    g_scoring.fixes = 0;
+    g_processed = 0;
+
+    SensorRegistry registry;
+    ZonedTracker tracker(config.sensor_positions(), registry, selection);
+    WorkStealingExecutor executor;
+    RangeFilterConfig filter;
+    filter.require_presence = true;
+    filter.hampel = true;
+    IngestRouter router("drones/data", registry, tracker, executor, {}, filter);
+
+    size_t sent = 0;
+    const auto start = IngestClock::now();
+    const auto period = std::chrono::duration<double>(1.0 / PACED_RATE);
+    IngestMessage msg;
+    while (sent < count && generator.next(msg)) {
+        const auto due = start + std::chrono::duration_cast<IngestClock::duration>(period * static_cast<double>(sent));
+        while (IngestClock::now() < due) {
+            std::this_thread::yield();
+        }
+        msg.received_at = IngestClock::now();
+        g_scoring.received[sent] = msg.received_at;
+        g_scoring.sim_time[sent] = generator.time_s();
+        g_scoring.routed.store(sent + 1, std::memory_order_release);
+        router.route(std::move(msg));
+        msg = IngestMessage{};
+        ++sent;
+    }
+    while (g_processed.load(std::memory_order_acquire) < sent) {
+        std::this_thread::yield();
+    }
+    router.clear();
+
+    AccuracyResult result{std::min(g_scoring.fixes.load(), count), 0.0, 0.0, 0.0};
+    if (result.fixes > 0) {
+        double* errors = g_scoring.errors.get();
+        std::sort(errors, errors + result.fixes);
+        result.p50 = errors[result.fixes / 2];
+        result.p95 = errors[result.fixes * 95 / 100];
+        double* dops = g_scoring.dops.get();
+        std::sort(dops, dops + result.fixes);
+        result.dop_p50 = dops[result.fixes / 2];
+    }
+    return result;
+}
+
+// ns per update of a drone hovering where a subset of the radars sees it.
+double update_ns(const SubsetSelectionConfig& selection) {
+    const ScenarioConfig config = hall();
+    SensorRegistry registry;
+    DroneTracker tracker(config.sensor_positions(), registry, selection);
+    const Point drone{6.0, 5.0};
+    std::vector<SensorHandle> handles;
+    std::vector<double> ranges;
+    for (const auto& pair : config.sensor_positions()) {
+        const double range = std::hypot(pair.second.x - drone.x, pair.second.y - drone.y);
+        if (range > config.max_range_m) continue;
+        handles.push_back(registry.find_sensor(pair.first));
+        ranges.push_back(range);
+    }
+    size_t fixes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < UPDATES; ++i) {
+        const size_t k = i % handles.size();
+        fixes += tracker.updateAndCalculate(handles[k], ranges[k], static_cast<long long>(i)).has_value();
+    }
+    const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return fixes > 0 ? elapsed / static_cast<double>(UPDATES) : 0.0;
+}
+
+struct DegradedCost {
+    size_t outages;
+    double search_ns;
+    double hit_ns;
+};
+
+DegradedCost degraded_cost(SubsetGrid& subsets, uint64_t sensors) {
+    std::vector<std::pair<uint32_t, uint64_t>> outages;
+    for (uint32_t cell = 0; cell < subsets.cells(); ++cell) {
+        const uint64_t best = subsets.choose(cell, sensors).mask;
+        for (uint64_t m = best; m; m &= m - 1) outages.push_back({cell, sensors & ~(m & -m)});
+    }
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& outage : outages) sink += subsets.choose(outage.first, outage.second).mask;
+    const double search_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                             / static_cast<double>(outages.size());
+
+    // A drone hovering in a few cells while a radar is out, outages first seen after the cache filled up.
+    const size_t hot = std::min<size_t>(HOT_OUTAGES, outages.size());
+    const size_t first_hot = outages.size() - hot;
+    for (size_t i = first_hot; i < outages.size(); ++i) sink += subsets.choose(outages[i].first, outages[i].second).mask;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < UPDATES; ++i) {
+        const auto& outage = outages[first_hot + i % hot];
+        sink += subsets.choose(outage.first, outage.second).mask;
+    }
+    const double hit_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                          / static_cast<double>(UPDATES);
+    if (sink == 1) std::printf(" ");
+    return {outages.size(), search_ns, hit_ns};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    const std::vector<Point> line = {{0, 0}, {5, 0}, {10, 0}};
+    if (std::isfinite(SubsetGrid::dilution(0b111, line, {5, 3}))) {
+        std::printf("CHECK FAILED: collinear sensors have a finite dilution of precision\n");
+        return 1;
+    }
+
+    // Simulated time runs this much faster than real time, the staleness window shrinks with it.
+    const double speedup = PACED_RATE / (SAMPLE_HZ * RADARS);
+    SubsetSelectionConfig all;
+    all.grid = false;
+    all.drop_lost = false;
+    all.stale_after_s = 0.0;
+    SubsetSelectionConfig live = all;
+    live.drop_lost = true;
+    live.stale_after_s = 2.0 / speedup;
+    SubsetSelectionConfig grid = live;
+    grid.grid = true;
+
+    std::printf("%zu radars around a %.0f x %.0f m hall, 12 m reach, %zu messages at %.0f msg/s\n", RADARS, SITE_W, SITE_H,
+                count, PACED_RATE);
+    std::printf("%-12s %10s %12s %12s %12s\n", "ranges", "fixes", "err p50 m", "err p95 m", "dop p50");
+    const struct {
+        const char* name;
+        const SubsetSelectionConfig& selection;
+    } rows[] = {{"all", all}, {"live", live}, {"grid", grid}};
+    AccuracyResult results[3];
+    for (size_t i = 0; i < 3; ++i) {
+        results[i] = accuracy(rows[i].selection, count);
+        std::printf("%-12s %10zu %12.3f %12.3f %12.2f\n", rows[i].name, results[i].fixes, results[i].p50, results[i].p95,
+                    results[i].dop_p50);
+    }
+
+    const ScenarioConfig config = hall();
+    std::vector<Point> positions;
+    for (const auto& pair : config.sensor_positions()) positions.push_back(pair.second);
+    const auto build_start = std::chrono::steady_clock::now();
+    SubsetGrid subsets(positions, (uint64_t(1) << RADARS) - 1, grid);
+    const double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+    std::printf("\ngrid: %zu cells of %.2f m, %zu distinct subsets, built in %.1f ms\n", subsets.cells(), subsets.cell_m(),
+                subsets.best_masks().size(), build_ms);
+    std::printf("update: %.1f ns without the grid, %.1f ns with it\n", update_ns(live), update_ns(grid));
+    const DegradedCost degraded = degraded_cost(subsets, (uint64_t(1) << RADARS) - 1);
+    std::printf("choose() with a sensor out: %.1f ns to search %zu outages, %.1f ns for %zu of them again\n",
+                degraded.search_ns, degraded.outages, degraded.hit_ns, HOT_OUTAGES);
+
+    if (results[2].fixes == 0 || results[2].p95 > results[0].p95 || results[2].p95 > results[1].p95 * P95_NOISE) {
+        std::printf("CHECK FAILED: grid p95 %.3f m, all ranges %.3f m, live ranges %.3f m\n", results[2].p95,
+                    results[0].p95, results[1].p95);
+        return 1;
+    }
+    if (degraded.hit_ns * HIT_SPEEDUP > degraded.search_ns) {
+        std::printf("CHECK FAILED: repeated outage lookups miss the cache once it overflowed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+    * @file bench_journal.cpp
+    * @brief Cost of journaling on the ingest path, read back check and replay throughput.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Appends a recorded-looking stream of messages (three nodes, JSON and
+    * binary payloads, 1 ms apart) to a JournalWriter from one thread, the way
+    * the Paho callback would, and times append(). The journal is then read
+    * back and every topic, payload and receive time must match what was
+    * appended. Finally the journal is replayed through IngestRouter,
+    * NodeManager and DroneTracker as fast as possible, and a short prefix at
+    * 10x the recorded pace to check the pacing.
+    *
+    * Usage: bench_journal [messages] [journal_path]
+*/
+
+// --- Imports ---
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include "../Journal.h"
+#include "../JournalIngestSource.h"
+#include "../IngestRouter.h"
+#include "../WorkStealingExecutor.h"
+#include "../ZonedTracker.h"
+#include "../SensorRegistry.h"
+// --- End Imports ---
+
+namespace {
+
+std::atomic<size_t> g_processed{0};
+std::atomic<size_t> g_fixes{0};
+
+} // namespace
+
+void process_sensor_update(const std::string&, const TrackedSensor&) {
+    g_processed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void process_drone_location(const Fix&, IngestClock::time_point) {
+    g_fixes.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+
+std::vector<IngestMessage> make_stream(size_t count) {
+    const char* const sensors[] = {"esp32_1/radar_A", "esp32_2/radar_A", "esp32_3/radar_A"};
+    const double ranges[] = {2.9, 3.6, 2.4};
+    std::vector<IngestMessage> stream(count);
+    const auto start = IngestClock::now();
+    char payload[128];
+    for (size_t i = 0; i < count; ++i) {
+        const size_t s = i % 3;
+        SensorData d;
+        d.range = ranges[s] + 0.01 * static_cast<double>(i % 7);
+        d.speed = 0.4;
+        d.timestamp_ms = static_cast<long long>(i);
+        d.sequence = static_cast<uint32_t>(i);
+        stream[i].topic = std::string("drones/data/") + sensors[s];
+        if (s == 2) { // one node already on the binary firmware
+            stream[i].payload = d.to_binary();
+        } else {
+            std::snprintf(payload, sizeof(payload), "{\"presence\":true,\"ts\":%lld,\"range\":%.2f,\"speed\":%.2f}",
+                          d.timestamp_ms, d.range, d.speed);
+            stream[i].payload = payload;
+        }
+        stream[i].received_at = start + std::chrono::milliseconds(i);
+    }
+    return stream;
+}
+
+// Replays the journal through a fresh pipeline, returns the wall time in seconds.
+double replay(const std::string& path, double speed, size_t expected) {
+    std::map<std::string, Point> sensor_positions = {
+        {"esp32_1/radar_A", {0.0, 0.0}},
+        {"esp32_2/radar_A", {5.0, 0.0}},
+        {"esp32_3/radar_A", {2.5, 4.33}}
+    };
+    SensorRegistry registry;
+    ZonedTracker tracker(sensor_positions, registry);
+    WorkStealingExecutor executor;
+    IngestRouter router("drones/data", registry, tracker, executor);
+    JournalIngestSource source(path, speed);
+
+    g_processed = 0;
+    g_fixes = 0;
+    auto start = std::chrono::steady_clock::now();
+    source.start(router.handler());
+    source.join();
+    while (g_processed.load(std::memory_order_relaxed) < expected) {
+        std::this_thread::yield();
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    router.clear();
+    return elapsed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "/tmp/bench_journal.pdj";
+
+    std::vector<IngestMessage> stream = make_stream(count);
+
+    // The first messages fit in the ring and show the cost the ingest thread pays. After that
+    // the bench retries when the ring is full, where the Paho callback would drop, to measure
+    // what the writer sustains and to get every message into the journal for the check below.
+    const size_t burst = count < 10000 ? count : 10000;
+    double burst_s = 0.0, total_s = 0.0;
+    uint64_t ring_full = 0;
+    {
+        JournalWriter writer(path);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < burst; ++i) writer.append(stream[i]);
+        burst_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        for (size_t i = burst; i < count; ++i) {
+            while (!writer.append(stream[i])) std::this_thread::yield();
+        }
+        while (writer.written() < count) std::this_thread::yield();
+        total_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        ring_full = writer.dropped();
+    }
+
+    size_t mismatches = 0, read = 0;
+    {
+        JournalReader reader(path);
+        const auto origin = stream.empty() ? IngestClock::time_point{} : stream.front().received_at;
+        reader.for_each([&](std::string_view topic, int64_t time_ns, std::string_view payload) {
+            const IngestMessage& m = stream[read++];
+            const int64_t expected_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(m.received_at - origin).count();
+            mismatches += topic != m.topic || payload != m.payload || time_ns != expected_ns;
+            return read < stream.size();
+        });
+    }
+    if (mismatches > 0 || read != count) {
+        std::printf("READ BACK FAILED: %zu of %zu messages read, %zu mismatches\n", read, count, mismatches);
+        return 1;
+    }
+
+    const double fast_s = replay(path, 0.0, count);
+    const size_t fixes = g_fixes.load();
+
+    // A one second prefix at 10x should take about 100 ms.
+    const std::string short_path = path + ".short";
+    const size_t short_count = count < 1000 ? count : 1000;
+    {
+        JournalWriter writer(short_path);
+        for (size_t i = 0; i < short_count; ++i) writer.append(stream[i]);
+    }
+    const double paced_s = replay(short_path, 10.0, short_count);
+    std::remove(short_path.c_str());
+
+    const double n = static_cast<double>(count);
+    std::printf("messages: %zu, journal %s, read back matches\n", count, path.c_str());
+    std::printf("%-30s %10.1f ns/msg on the ingest thread\n", "append, ring not full", burst_s / static_cast<double>(burst) * 1e9);
+    std::printf("%-30s %10.0f msg/s, ring was full %llu times\n", "journal sustained", n / total_s,
+                static_cast<unsigned long long>(ring_full));
+    std::printf("%-30s %10.0f msg/s, %zu fixes\n", "replay, as fast as possible", n / fast_s, fixes);
+    std::printf("%-30s %10.3f s for %.3f s recorded\n", "replay, 10x", paced_s,
+                static_cast<double>(short_count - 1) * 1e-3);
+    return 0;
+}
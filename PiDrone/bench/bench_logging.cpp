@@ -0,0 +1,181 @@
+/**
+    * @file bench_logging.cpp
+    * @brief Pipeline throughput with console logging off, synchronous and asynchronous.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Pushes JSON readings through NodeManagers on the work-stealing executor,
+    * with the sensor update and location hooks either doing nothing, formatting
+    * and flushing a line per call the way main.cpp used to with std::endl, or
+    * handing a record to the AsyncLogger (unlimited, then capped at 200 lines
+    * per second and category). Output goes to /dev/null unless a path is given,
+    * pass /dev/tty to see what a real terminal does to the synchronous case.
+    *
+    * Usage: bench_logging [messages] [log_path]
+*/
+
+// --- Imports ---
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../AsyncLogger.h"
+#include "../NodeManager.h"
+#include "../WorkStealingExecutor.h"
+#include "../ZonedTracker.h"
+#include "../SensorRegistry.h"
+// --- End Imports ---
+
+namespace {
+
+enum class Mode { Off, Sync, Async };
+
+const size_t NODES = 8;
+
+std::atomic<size_t> g_processed{0};
+std::atomic<uint64_t> g_hook_ns{0};
+Mode g_mode = Mode::Off;
+FILE* g_sink = nullptr;
+AsyncLogger* g_logger = nullptr;
+
+} // namespace
+
+void process_sensor_update(const std::string& esp_id, const TrackedSensor& sensor) {
+    const SensorData& latest = sensor.getLatestData();
+    auto start = std::chrono::steady_clock::now();
+    if (g_mode == Mode::Sync) {
+        std::fprintf(g_sink, "UPDATE | ESP: %-10s | Sensor: %-9s | Range: %-6.2f m | Speed: %-5.2f m/s\n",
+                     esp_id.c_str(), sensor.getId().c_str(), latest.range, latest.speed);
+        std::fflush(g_sink);
+    } else if (g_mode == Mode::Async) {
+        g_logger->log(LogCategory::Sensor, LogKind::SensorUpdate, [&](LogRecord& r) {
+            r.set_text(esp_id, sensor.getId());
+            r.values[0] = latest.range;
+            r.values[1] = latest.speed;
+        });
+    }
+    g_hook_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+                        std::memory_order_relaxed);
+    g_processed.fetch_add(1, std::memory_order_release);
+}
+
+void process_drone_location(const Fix& fix, IngestClock::time_point) {
+    if (g_mode == Mode::Sync) {
+        std::fprintf(g_sink, ">>>>>> LOCATION (X,Y): (%6.2f, %6.2f) | Sensors: %zu | Residual: %.2f m | Cond: %.1f\n",
+                     fix.position.x, fix.position.y, fix.sensors_used, fix.residual_rms, fix.condition_number);
+        std::fflush(g_sink);
+    } else if (g_mode == Mode::Async) {
+        g_logger->log(LogCategory::Location, LogKind::Location, [&](LogRecord& r) {
+            r.values[0] = fix.position.x;
+            r.values[1] = fix.position.y;
+            r.values[2] = fix.residual_rms;
+            r.values[3] = fix.condition_number;
+            r.count = static_cast<uint32_t>(fix.sensors_used);
+        });
+    }
+}
+
+namespace {
+
+// Returns messages per second, the time spent in the hook per message is added to hook_ns.
+double run(Mode mode, AsyncLogger* logger, size_t total, const std::vector<IngestMessage>& messages,
+           SensorRegistry& registry, ZonedTracker& tracker, WorkStealingExecutor& executor) {
+    g_mode = mode;
+    g_logger = logger;
+    g_processed = 0;
+    g_hook_ns = 0;
+
+    std::vector<std::unique_ptr<NodeManager>> managers;
+    for (size_t i = 0; i < NODES; ++i) {
+        managers.push_back(std::make_unique<NodeManager>(registry.intern_node("esp32_" + std::to_string(i)), registry,
+                                                         tracker, executor));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < total; ++i) {
+        const IngestMessage& m = messages[i % messages.size()];
+        IngestMessage msg = m;
+        managers[registry.sensor(m.sensor).node % NODES]->add_message(std::move(msg));
+    }
+    while (g_processed.load(std::memory_order_acquire) < total) {
+        std::this_thread::yield();
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    managers.clear();
+    return static_cast<double>(total) / elapsed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 400000;
+    const char* path = argc > 2 ? argv[2] : "/dev/null";
+    g_sink = std::fopen(path, "w");
+    if (!g_sink) {
+        std::printf("cannot open %s\n", path);
+        return 1;
+    }
+
+    // Three sensors with known positions on three nodes, so every round of readings yields fixes.
+    std::map<std::string, Point> sensor_positions = {
+        {"esp32_0/radar_A", {0.0, 0.0}},
+        {"esp32_1/radar_A", {5.0, 0.0}},
+        {"esp32_2/radar_A", {2.5, 4.33}}
+    };
+    SensorRegistry registry;
+    ZonedTracker tracker(sensor_positions, registry);
+    WorkStealingExecutor executor;
+
+    std::vector<IngestMessage> messages;
+    const double ranges[3] = {2.9, 3.6, 2.4};
+    for (size_t i = 0; i < NODES; ++i) {
+        std::string full_id = "esp32_" + std::to_string(i) + "/radar_A";
+        char payload[128];
+        std::snprintf(payload, sizeof(payload), "{\"presence\":true,\"ts\":123456,\"range\":%.2f,\"speed\":0.42}",
+                      i < 3 ? ranges[i] : 1.0);
+        messages.push_back({"drones/data/" + full_id, payload, {}, registry.intern_sensor(full_id)});
+    }
+
+    std::printf("messages: %zu over %zu nodes, pool workers: %zu, log output: %s\n", total, NODES, executor.size(), path);
+    std::printf("%-24s %14s %16s %10s %10s\n", "logging", "msg/s", "hook ns/msg", "written", "suppressed");
+
+    auto report = [&](const char* name, double rate, AsyncLogger* logger) {
+        const double hook = static_cast<double>(g_hook_ns.load()) / static_cast<double>(total);
+        if (logger) {
+            logger->flush();
+            const uint64_t suppressed = logger->suppressed(LogCategory::Sensor) + logger->suppressed(LogCategory::Location);
+            std::printf("%-24s %14.0f %16.1f %10llu %10llu\n", name, rate, hook,
+                        static_cast<unsigned long long>(logger->written()), static_cast<unsigned long long>(suppressed));
+        } else {
+            std::printf("%-24s %14.0f %16.1f %10s %10s\n", name, rate, hook, "-", "-");
+        }
+    };
+
+    report("off", run(Mode::Off, nullptr, total, messages, registry, tracker, executor), nullptr);
+    report("sync, flush per line", run(Mode::Sync, nullptr, total, messages, registry, tracker, executor), nullptr);
+    {
+        AsyncLoggerConfig config;
+        config.out = g_sink;
+        config.capacity = 1 << 16;
+        AsyncLogger logger(config);
+        report("async", run(Mode::Async, &logger, total, messages, registry, tracker, executor), &logger);
+        if (logger.dropped() > 0) {
+            std::printf("%-24s %14s %16s %10llu dropped, ring full\n", "", "", "", static_cast<unsigned long long>(logger.dropped()));
+        }
+    }
+    {
+        AsyncLoggerConfig config;
+        config.out = g_sink;
+        config.limits[static_cast<size_t>(LogCategory::Sensor)].max_per_second = 200;
+        config.limits[static_cast<size_t>(LogCategory::Location)].max_per_second = 200;
+        AsyncLogger logger(config);
+        report("async, 200/s per category", run(Mode::Async, &logger, total, messages, registry, tracker, executor), &logger);
+    }
+    std::fclose(g_sink);
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+    * @file bench_micro.cpp
+    * @brief Cost of each hot function on the per-message path, one at a time.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Times the functions every reading goes through, in isolation and on
+    * warm caches: payload decoding (generic JSON, the allocation-free JSON
+    * parser, binary), the TrackedSensor history update, the range filter,
+    * the queue hand-off into a NodeManager (push and drain of an
+    * IngestMessage on one thread, without the cross-thread wake-up), the
+    * closed-form trilateration and a DroneTracker update with 3 and 16
+    * sensors. Calls are timed in batches of 64, reported are the mean and
+    * the p50 / p99 of the per-call time over all batches.
+    *
+    * Usage: bench_micro [calls_per_function]
+*/
+
+// --- Imports ---
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include "../SensorModel.h"
+#include "../RangeFilter.h"
+#include "../Trilateration.h"
+#include "../DroneTracker.h"
+#include "../SensorRegistry.h"
+#include "../SpscRing.h"
+#include "../IngestSource.h"
+// --- End Imports ---
+
+namespace {
+
+const size_t BATCH = 64;
+
+volatile double g_sink = 0.0;
+
+// Calls fn(i) for i in [0, calls) and prints mean, p50 and p99 ns per call.
+template <typename Fn>
+void measure(const char* name, size_t calls, Fn&& fn) {
+    const size_t batches = calls / BATCH > 0 ? calls / BATCH : 1;
+    std::vector<double> per_call(batches);
+    double total = 0.0;
+    for (size_t b = 0; b < batches; ++b) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < BATCH; ++i) fn(b * BATCH + i);
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        per_call[b] = ns / BATCH;
+        total += ns;
+    }
+    std::sort(per_call.begin(), per_call.end());
+    std::printf("%-36s %10.1f %10.1f %10.1f\n", name, total / static_cast<double>(batches * BATCH),
+                per_call[batches / 2], per_call[std::min(batches - 1, batches * 99 / 100)]);
+}
+
+std::map<std::string, Point> ring_of_sensors(size_t count) {
+    std::map<std::string, Point> positions;
+    for (size_t i = 0; i < count; ++i) {
+        const double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(count);
+        positions["esp32_" + std::to_string(i) + "/radar_A"] = {5.0 * std::cos(angle), 5.0 * std::sin(angle)};
+    }
+    return positions;
+}
+
+void measure_tracker(const char* name, size_t sensors, size_t calls) {
+    const std::map<std::string, Point> positions = ring_of_sensors(sensors);
+    SensorRegistry registry;
+    DroneTracker tracker(positions, registry);
+    std::vector<SensorHandle> handles;
+    std::vector<double> ranges;
+    const Point drone{0.7, -1.2};
+    for (const auto& pair : positions) {
+        handles.push_back(registry.intern_sensor(pair.first));
+        ranges.push_back(std::hypot(pair.second.x - drone.x, pair.second.y - drone.y));
+    }
+    for (size_t i = 0; i < sensors; ++i) tracker.updateAndCalculate(handles[i], ranges[i], 0);
+    measure(name, calls, [&](size_t i) {
+        const size_t s = i % sensors;
+        auto fix = tracker.updateAndCalculate(handles[s], ranges[s] + 0.001 * static_cast<double>(i % 5), static_cast<long long>(i));
+        if (fix) g_sink = g_sink + fix->position.x;
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    // A few distinct readings so branch predictors do not learn a single input.
+    std::vector<std::string> json, binary;
+    std::vector<SensorData> readings;
+    char buffer[128];
+    for (size_t i = 0; i < 16; ++i) {
+        SensorData d;
+        d.range = 1.0 + 0.37 * static_cast<double>(i);
+        d.speed = -0.5 + 0.11 * static_cast<double>(i);
+        d.timestamp_ms = 1000000 + static_cast<long long>(i) * 100;
+        d.presence = i % 7 != 0;
+        std::snprintf(buffer, sizeof(buffer), "{\"presence\":%s,\"ts\":%lld,\"range\":%.2f,\"speed\":%.2f}",
+                      d.presence ? "true" : "false", d.timestamp_ms, d.range, d.speed);
+        json.push_back(buffer);
+        binary.push_back(d.to_binary());
+        readings.push_back(d);
+    }
+
+    std::printf("calls per function: %zu, timed in batches of %zu\n", calls, BATCH);
+    std::printf("%-36s %10s %10s %10s\n", "function", "mean ns", "p50 ns", "p99 ns");
+
+    measure("SensorData::from_json (nlohmann)", calls / 4, [&](size_t i) {
+        g_sink = g_sink + SensorData::from_json(nlohmann::json::parse(json[i % 16])).range;
+    });
+    measure("SensorData::from_json_text", calls, [&](size_t i) {
+        g_sink = g_sink + SensorData::from_json_text(json[i % 16]).range;
+    });
+    measure("SensorData::from_binary", calls, [&](size_t i) {
+        g_sink = g_sink + SensorData::from_binary(binary[i % 16]).range;
+    });
+
+    TrackedSensor sensor("radar_A");
+    measure("TrackedSensor::addDataPoint", calls, [&](size_t i) {
+        SensorData d = readings[i % 16];
+        d.timestamp_ms = static_cast<long long>(i) * 100;
+        sensor.addDataPoint(d);
+    });
+    g_sink = g_sink + sensor.getAverageSpeed();
+
+    RangeFilterConfig filter_config;
+    filter_config.require_presence = true;
+    filter_config.hampel = true;
+    RangeFilter filter(filter_config);
+    measure("RangeFilter::update (presence+hampel)", calls, [&](size_t i) {
+        SensorData d = readings[i % 16];
+        d.timestamp_ms = static_cast<long long>(i) * 100;
+        auto range = filter.update(d);
+        if (range) g_sink = g_sink + *range;
+    });
+
+    SpscRing<IngestMessage> queue(4096);
+    IngestMessage message;
+    message.topic = "drones/data/esp32_1/radar_A";
+    message.payload = json[0];
+    // The message is moved in and back out, so no string is copied, as on the ingest path.
+    measure("NodeManager queue push + drain", calls, [&](size_t) {
+        queue.try_push(std::move(message));
+        queue.drain([&](IngestMessage& m) {
+            message = std::move(m);
+            m = IngestMessage{};
+        });
+    });
+    g_sink = g_sink + static_cast<double>(message.payload.size());
+
+    const Point s1{0.0, 0.0}, s2{5.0, 0.0}, s3{2.5, 4.33};
+    measure("trilaterate", calls, [&](size_t i) {
+        const double jitter = 0.001 * static_cast<double>(i % 7);
+        auto p = trilaterate(s1, 2.9 + jitter, s2, 3.6, s3, 2.4 - jitter);
+        if (p) g_sink = g_sink + p->x;
+    });
+
+    measure_tracker("DroneTracker::updateAndCalculate, 3", 3, calls);
+    measure_tracker("DroneTracker::updateAndCalculate, 16", 16, calls / 4);
+    return 0;
+}
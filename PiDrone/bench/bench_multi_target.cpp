@@ -0,0 +1,151 @@
+/**
+    * @file bench_multi_target.cpp
+    * @brief Scan cost and track quality of the MultiTargetTracker as targets are added.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Targets fly gentle turns at constant target density (the area grows with
+    * their number) and steer back once they leave it. Every scan each target yields one fix with gaussian noise,
+    * a fraction of fixes is dropped and uniform clutter is added. Reports the
+    * time per scan and per target, so the growth with the target count shows
+    * whether association stays sub-quadratic, and the number of confirmed
+    * tracks, the RMS error and the identity switches against the ground truth.
+    *
+    * Usage: bench_multi_target [scans] [max_targets]
+*/
+
+// --- Imports ---
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../MultiTargetTracker.h"
+#include "../SpatialGrid.h"
+// --- End Imports ---
+
+namespace {
+
+const double SCAN_HZ = 10.0;
+const double FIX_SIGMA = 0.3;
+const double DETECTION_PROB = 0.9;
+const double CLUTTER_PER_TARGET = 0.05;
+// Area per target, 20 m x 20 m.
+const double AREA_PER_TARGET = 400.0;
+
+const double SPEED = 3.0;        // m/s
+const double TURN_RATE = 0.3;    // rad/s, at most
+
+struct Target {
+    Point position;
+    double heading = 0.0;
+    double turn = 0.0;
+    uint32_t track_id = 0;
+};
+
+void run(size_t target_count, size_t scans) {
+    std::mt19937_64 rng(11 + target_count);
+    const double side = std::sqrt(AREA_PER_TARGET * static_cast<double>(target_count));
+    std::uniform_real_distribution<double> coord(0.0, side);
+    std::uniform_real_distribution<double> heading(0.0, 2.0 * M_PI);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> turn(-TURN_RATE, TURN_RATE);
+    std::normal_distribution<double> noise(0.0, FIX_SIGMA);
+
+    std::vector<Target> targets(target_count);
+    for (Target& t : targets) {
+        t.position = {coord(rng), coord(rng)};
+        t.heading = heading(rng);
+        t.turn = turn(rng);
+    }
+
+    MultiTargetConfig config;
+    config.max_tracks = 2 * target_count + 64;
+    MultiTargetTracker tracker(config);
+    SpatialGrid grid(1.5);
+    const auto period = std::chrono::duration_cast<IngestClock::duration>(std::chrono::duration<double>(1.0 / SCAN_HZ));
+    auto now = IngestClock::time_point{} + std::chrono::hours(1);
+
+    double scan_seconds = 0.0;
+    size_t switches = 0, matched = 0;
+    double error_sq = 0.0;
+    size_t confirmed = 0;
+
+    for (size_t scan = 0; scan < scans; ++scan) {
+        now += period;
+        for (Target& t : targets) {
+            const bool outside = t.position.x < 0.0 || t.position.x > side || t.position.y < 0.0 || t.position.y > side;
+            if (outside) t.turn = TURN_RATE;
+            else if (unit(rng) < 0.01) t.turn = turn(rng);
+            t.heading += t.turn / SCAN_HZ;
+            t.position.x += SPEED * std::cos(t.heading) / SCAN_HZ;
+            t.position.y += SPEED * std::sin(t.heading) / SCAN_HZ;
+
+            if (unit(rng) < DETECTION_PROB) {
+                Fix fix;
+                fix.position = {t.position.x + noise(rng), t.position.y + noise(rng)};
+                fix.residual_rms = FIX_SIGMA;
+                tracker.add_fix(fix);
+            }
+        }
+        const size_t clutter = static_cast<size_t>(CLUTTER_PER_TARGET * static_cast<double>(target_count) + unit(rng));
+        for (size_t i = 0; i < clutter; ++i) {
+            Fix fix;
+            fix.position = {coord(rng), coord(rng)};
+            fix.residual_rms = FIX_SIGMA;
+            tracker.add_fix(fix);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        tracker.process_scan(now);
+        scan_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Score the second half of the run, once tracks had time to confirm.
+        if (scan < scans / 2) continue;
+        std::vector<TargetState> tracks = tracker.tracks();
+        grid.rebuild(tracks.size(), [&](size_t i) { return tracks[i].position; });
+        confirmed = 0;
+        for (const TargetState& s : tracks) confirmed += s.status == TrackStatus::Confirmed;
+
+        for (Target& t : targets) {
+            double best = 1.5 * 1.5;
+            const TargetState* nearest = nullptr;
+            grid.for_each_near(t.position, [&](uint32_t i) {
+                if (tracks[i].status != TrackStatus::Confirmed) return;
+                const double dx = tracks[i].position.x - t.position.x;
+                const double dy = tracks[i].position.y - t.position.y;
+                if (dx * dx + dy * dy < best) {
+                    best = dx * dx + dy * dy;
+                    nearest = &tracks[i];
+                }
+            });
+            if (!nearest) continue;
+            ++matched;
+            error_sq += best;
+            if (t.track_id != 0 && t.track_id != nearest->id) ++switches;
+            t.track_id = nearest->id;
+        }
+    }
+
+    const double per_scan_us = scan_seconds / static_cast<double>(scans) * 1e6;
+    const double scored = static_cast<double>(target_count * (scans - scans / 2));
+    std::printf("%7zu targets %10.1f us/scan %8.0f ns/target   confirmed %6zu   covered %5.1f%%   rms %.3f m   switches %zu\n",
+                target_count, per_scan_us, per_scan_us * 1e3 / static_cast<double>(target_count), confirmed,
+                100.0 * static_cast<double>(matched) / scored, std::sqrt(error_sq / static_cast<double>(matched ? matched : 1)),
+                switches);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t scans = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    size_t max_targets = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+    if (scans < 2) scans = 2;
+
+    std::printf("scans: %zu at %.0f Hz, fix sigma %.2f m, Pd %.2f\n", scans, SCAN_HZ, FIX_SIGMA, DETECTION_PROB);
+    for (size_t targets = 1; targets <= max_targets; targets *= 4) {
+        run(targets, scans);
+    }
+    return 0;
+}
@@ -0,0 +1,214 @@
+/**
+    * @file bench_overload.cpp
+    * @brief NodeManager overload policies: queue depth, staleness and loss when the worker falls behind.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * One node with four radars is offered messages several times faster than
+    * its worker can process them, the worker spending WORK_US on every
+    * reading. Each policy is run on the same traffic and reports what the
+    * producer achieved, the deepest the node's queue got, and how old a
+    * reading was when it was processed (the payload timestamp is the send
+    * time in microseconds). Block shows the backlog turning into producer
+    * stalls, DropOldest keeps latency at one full queue, LatestPerSensor at
+    * one reading per sensor.
+    *
+    * Checked: every message is processed, dropped or coalesced exactly once,
+    * Block loses nothing, no policy queues more than its capacity plus one
+    * reading per sensor, and LatestPerSensor processes fresher readings than
+    * DropOldest. Then times a push and a drain of DropOldestRing against the
+    * plain SpscRing it replaced.
+    *
+    * Usage: bench_overload [messages] [work_us]
+*/
+
+// --- Imports ---
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../IngestRouter.h"
+#include "../WorkStealingExecutor.h"
+#include "../ZonedTracker.h"
+#include "../SensorRegistry.h"
+#include "../SpscRing.h"
+#include "../DropOldestRing.h"
+// --- End Imports ---
+
+namespace {
+
+const size_t SENSORS = 4;
+const size_t QUEUE_CAPACITY = 1024;
+// Offered load as a multiple of what the worker can take.
+const double OVERLOAD = 4.0;
+
+std::chrono::microseconds g_work{20};
+IngestClock::time_point g_start;
+std::atomic<size_t> g_processed{0};
+std::unique_ptr<long long[]> g_staleness_us;
+size_t g_capacity = 0;
+
+long long micros_since_start() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(IngestClock::now() - g_start).count();
+}
+
+} // namespace
+
+void process_sensor_update(const std::string&, const TrackedSensor& sensor) {
+    const size_t slot = g_processed.load(std::memory_order_relaxed);
+    if (slot < g_capacity) g_staleness_us[slot] = micros_since_start() - sensor.getLatestData().timestamp_ms;
+    const auto until = IngestClock::now() + g_work;
+    while (IngestClock::now() < until) {
+        cpu_relax();
+    }
+    g_processed.store(slot + 1, std::memory_order_release);
+}
+
+void process_drone_location(const Fix&, IngestClock::time_point) {}
+
+namespace {
+
+struct RunResult {
+    double offered_rate;
+    size_t max_queued;
+    size_t processed;
+    uint64_t dropped;
+    uint64_t coalesced;
+    long long stale_p50_us;
+    long long stale_max_us;
+};
+
+RunResult run(OverloadPolicy policy, size_t count) {
+    std::map<std::string, Point> positions;
+    std::vector<std::string> topics;
+    for (size_t s = 0; s < SENSORS; ++s) {
+        const std::string id = "esp32_1/radar_" + std::to_string(s);
+        positions[id] = {static_cast<double>(s % 2) * 4.0, static_cast<double>(s / 2) * 4.0};
+        topics.push_back("drones/data/" + id);
+    }
+    g_staleness_us = std::make_unique<long long[]>(count);
+    g_capacity = count;
+    g_processed = 0;
+
+    SensorRegistry registry;
+    ZonedTracker tracker(positions, registry);
+    WorkStealingExecutor executor;
+    NodeQueueConfig queue;
+    queue.policy = policy;
+    queue.capacity = QUEUE_CAPACITY;
+    IngestRouter router("drones/data", registry, tracker, executor, {}, {}, queue);
+
+    const auto period = std::chrono::duration<double>(static_cast<double>(g_work.count()) * 1e-6 / OVERLOAD);
+    size_t max_queued = 0;
+    char payload[128];
+    g_start = IngestClock::now();
+    for (size_t i = 0; i < count; ++i) {
+        const auto due = g_start + std::chrono::duration_cast<IngestClock::duration>(period * static_cast<double>(i));
+        while (IngestClock::now() < due) {
+            std::this_thread::yield();
+        }
+        IngestMessage msg;
+        msg.topic = topics[i % SENSORS];
+        std::snprintf(payload, sizeof(payload), "{\"presence\":true,\"ts\":%lld,\"range\":%.2f,\"speed\":0.30}",
+                      micros_since_start(), 2.0 + static_cast<double>(i % 7) * 0.01);
+        msg.payload = payload;
+        msg.received_at = IngestClock::now();
+        router.route(std::move(msg));
+        if (i % 64 == 0) max_queued = std::max(max_queued, router.queued());
+    }
+    const double elapsed = std::chrono::duration<double>(IngestClock::now() - g_start).count();
+    while (g_processed.load(std::memory_order_acquire) + router.dropped() + router.coalesced() < count) {
+        std::this_thread::yield();
+    }
+    router.clear();
+
+    RunResult result{static_cast<double>(count) / elapsed, max_queued, g_processed.load(), router.dropped(),
+                     router.coalesced(), 0, 0};
+    const size_t processed = std::min(result.processed, count);
+    if (processed > 0) {
+        long long* staleness = g_staleness_us.get();
+        std::sort(staleness, staleness + processed);
+        result.stale_p50_us = staleness[processed / 2];
+        result.stale_max_us = staleness[processed - 1];
+    }
+    return result;
+}
+
+template <typename Ring>
+double ring_ns(Ring& ring, size_t count) {
+    IngestMessage msg;
+    msg.topic = "drones/data/esp32_1/radar_0";
+    msg.payload = "{\"presence\":true,\"ts\":1000,\"range\":2.00,\"speed\":0.30}";
+    size_t seen = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        IngestMessage copy = msg;
+        ring.try_push(std::move(copy));
+        if (i % 64 == 63) {
+            ring.drain([&](IngestMessage& m) { seen += m.payload.size(); m = IngestMessage{}; });
+        }
+    }
+    ring.drain([&](IngestMessage& m) { seen += m.payload.size(); m = IngestMessage{}; });
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return seen > 0 ? ns / static_cast<double>(count) : 0.0;
+}
+
+const char* policy_name(OverloadPolicy policy) {
+    switch (policy) {
+        case OverloadPolicy::Block: return "block";
+        case OverloadPolicy::DropOldest: return "drop_oldest";
+        case OverloadPolicy::LatestPerSensor: return "latest";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    if (argc > 2) g_work = std::chrono::microseconds(std::strtoll(argv[2], nullptr, 10));
+
+    std::printf("1 node, %zu radars, queue capacity %zu, worker %lld us per reading, offered %.0fx what it can take\n",
+                SENSORS, QUEUE_CAPACITY, static_cast<long long>(g_work.count()), OVERLOAD);
+    std::printf("%-12s %12s %10s %10s %10s %10s %14s %14s\n", "policy", "offered/s", "max queue", "processed",
+                "dropped", "coalesced", "stale p50 us", "stale max us");
+    std::map<OverloadPolicy, RunResult> results;
+    for (OverloadPolicy policy : {OverloadPolicy::Block, OverloadPolicy::DropOldest, OverloadPolicy::LatestPerSensor}) {
+        const RunResult r = run(policy, count);
+        results[policy] = r;
+        std::printf("%-12s %12.0f %10zu %10zu %10llu %10llu %14lld %14lld\n", policy_name(policy), r.offered_rate,
+                    r.max_queued, r.processed, static_cast<unsigned long long>(r.dropped),
+                    static_cast<unsigned long long>(r.coalesced), r.stale_p50_us, r.stale_max_us);
+        if (r.processed + r.dropped + r.coalesced != count) {
+            std::printf("CHECK FAILED: %s accounted for %llu of %zu messages\n", policy_name(policy),
+                        static_cast<unsigned long long>(r.processed + r.dropped + r.coalesced), count);
+            return 1;
+        }
+        if (r.max_queued > QUEUE_CAPACITY + SENSORS) {
+            std::printf("CHECK FAILED: %s queued %zu messages\n", policy_name(policy), r.max_queued);
+            return 1;
+        }
+        if (policy == OverloadPolicy::Block && (r.dropped != 0 || r.coalesced != 0)) {
+            std::printf("CHECK FAILED: block lost messages\n");
+            return 1;
+        }
+    }
+    if (results[OverloadPolicy::LatestPerSensor].stale_p50_us >= results[OverloadPolicy::DropOldest].stale_p50_us) {
+        std::printf("CHECK FAILED: latest-per-sensor readings are no fresher than drop-oldest ones\n");
+        return 1;
+    }
+
+    const size_t ring_count = count * 20;
+    SpscRing<IngestMessage> spsc(QUEUE_CAPACITY);
+    DropOldestRing<IngestMessage> drop_oldest(QUEUE_CAPACITY);
+    const double spsc_ns = ring_ns(spsc, ring_count);
+    const double drop_oldest_ns = ring_ns(drop_oldest, ring_count);
+    std::printf("\npush + drain, one thread: SpscRing %.1f ns, DropOldestRing %.1f ns per message\n", spsc_ns, drop_oldest_ns);
+    return 0;
+}
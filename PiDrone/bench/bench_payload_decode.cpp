@@ -0,0 +1,104 @@
+/**
+    * @file bench_payload_decode.cpp
+    * @brief Bytes on the wire and decode cost of the JSON vs. the binary sensor payload.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Builds the payloads the ESP32 firmware publishes for a stream of C4001
+    * readings, in both formats, then times the decoders the NodeManager uses.
+    * Every binary decode is checked against the JSON decode of the same reading
+    * before any timing is reported.
+    *
+    * Usage: bench_payload_decode [messages]
+*/
+
+// --- Imports ---
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "../SensorModel.h"
+// --- End Imports ---
+
+namespace {
+
+template <typename Fn>
+double time_it(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool close(double a, double b) {
+    return std::fabs(a - b) <= 1e-5 * std::max(1.0, std::fabs(a));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> range(0.6, 12.0);
+    std::uniform_real_distribution<double> speed(-5.0, 5.0);
+    std::uniform_int_distribution<int> absent(0, 9);
+
+    std::vector<std::string> json(count), binary(count);
+    size_t json_bytes = 0, binary_bytes = 0;
+    char buffer[256];
+    for (size_t i = 0; i < count; ++i) {
+        SensorData d;
+        d.presence = absent(rng) != 0;
+        d.timestamp_ms = 1000000 + static_cast<long long>(i) * 100;
+        d.sequence = static_cast<uint32_t>(i);
+        d.sensor_type = SensorType::C4001;
+        // The C4001 reports centimetre resolution, which JSON prints with two decimals.
+        d.range = d.presence ? std::round(range(rng) * 100.0) / 100.0 : 0.0;
+        d.speed = d.presence ? std::round(speed(rng) * 100.0) / 100.0 : 0.0;
+
+        // Same shape as RadarC4001::buildJsonPayload.
+        if (d.presence) {
+            std::snprintf(buffer, sizeof(buffer), "{\"presence\":true,\"ts\":%lld,\"range\":%.2f,\"speed\":%.2f}",
+                          d.timestamp_ms, d.range, d.speed);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "{\"presence\":false,\"ts\":%lld}", d.timestamp_ms);
+        }
+        json[i] = buffer;
+        binary[i] = d.to_binary();
+        json_bytes += json[i].size();
+        binary_bytes += binary[i].size();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        SensorData a = SensorData::from_json(nlohmann::json::parse(json[i]));
+        SensorData b = SensorData::from_binary(binary[i]);
+        if (!close(a.range, b.range) || !close(a.speed, b.speed) || a.timestamp_ms != b.timestamp_ms
+            || a.presence != b.presence || b.sequence != i) {
+            std::printf("MISMATCH at %zu: %s\n", i, json[i].c_str());
+            return 1;
+        }
+    }
+
+    double sink = 0.0;
+    double json_s = time_it([&] {
+        for (const std::string& p : json) sink += SensorData::from_json(nlohmann::json::parse(p)).range;
+    });
+    double binary_s = time_it([&] {
+        for (const std::string& p : binary) sink += SensorData::from_binary(p).range;
+    });
+    double detect_s = time_it([&] {
+        for (size_t i = 0; i < count; ++i) sink += SensorData::from_payload(i & 1 ? binary[i] : json[i]).range;
+    });
+
+    const double n = static_cast<double>(count);
+    std::printf("messages: %zu, decoded values match\n", count);
+    std::printf("%-24s %8.1f bytes/msg %10.1f ns/msg\n", "json (nlohmann DOM)", json_bytes / n, json_s / n * 1e9);
+    std::printf("%-24s %8.1f bytes/msg %10.1f ns/msg\n", "binary (in place)", binary_bytes / n, binary_s / n * 1e9);
+    std::printf("%-24s %8s           %10.1f ns/msg\n", "auto-detect, 50/50 mix", "", detect_s / n * 1e9);
+    std::printf("binary: %.1fx fewer bytes, %.0fx faster decode (checksum %.1f)\n",
+                static_cast<double>(json_bytes) / binary_bytes, json_s / binary_s, sink);
+    return 0;
+}
@@ -0,0 +1,162 @@
+/**
+    * @file bench_pipeline.cpp
+    * @brief Full ingest pipeline at a configurable number of nodes and sensors: throughput and latency.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Generates the readings of nodes x sensors radars (around a circle, all
+    * seeing one drone) and routes them through IngestRouter, NodeManager,
+    * the range filter and DroneTracker on the work-stealing executor, exactly
+    * as main.cpp wires it. Messages are sent as fast as possible, or paced
+    * at a given total rate to measure latency below saturation. Reports the
+    * delivered messages per second and the p50 / p99 of every stage from the
+    * pipeline metrics, arrival to fix (end_to_end) being the headline number.
+    *
+    * Usage: bench_pipeline [nodes] [sensors_per_node] [messages] [rate_msg_per_s, 0 = flood] [json|binary]
+*/
+
+// --- Imports ---
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../IngestRouter.h"
+#include "../Metrics.h"
+#include "../WorkStealingExecutor.h"
+#include "../ZonedTracker.h"
+#include "../SensorRegistry.h"
+// --- End Imports ---
+
+namespace {
+
+std::atomic<size_t> g_processed{0};
+
+} // namespace
+
+void process_sensor_update(const std::string&, const TrackedSensor&) {
+    g_processed.fetch_add(1, std::memory_order_release);
+}
+
+void process_drone_location(const Fix&, IngestClock::time_point) {}
+
+int main(int argc, char* argv[]) {
+    size_t nodes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4;
+    size_t per_node = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2;
+    size_t count = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 500000;
+    double rate = argc > 4 ? std::atof(argv[4]) : 0.0;
+    const bool binary = argc > 5 && std::strcmp(argv[5], "binary") == 0;
+
+    if (nodes * per_node > DroneTracker::MAX_SENSORS || nodes * per_node < DroneTracker::MIN_SENSORS) {
+        std::printf("nodes x sensors_per_node must be between %zu and %zu\n", DroneTracker::MIN_SENSORS,
+                    DroneTracker::MAX_SENSORS);
+        return 1;
+    }
+
+    // Sensors of a node sit 10 cm apart, nodes around a 5 m circle, the drone off center.
+    std::map<std::string, Point> positions;
+    std::vector<std::string> topics;
+    std::vector<double> ranges;
+    const Point drone{0.8, -1.1};
+    for (size_t n = 0; n < nodes; ++n) {
+        const double angle = 2.0 * M_PI * static_cast<double>(n) / static_cast<double>(nodes);
+        for (size_t s = 0; s < per_node; ++s) {
+            const std::string id = "esp32_" + std::to_string(n) + "/radar_" + std::to_string(s);
+            const Point p{5.0 * std::cos(angle) + 0.1 * static_cast<double>(s), 5.0 * std::sin(angle)};
+            positions[id] = p;
+            topics.push_back("drones/data/" + id);
+            ranges.push_back(std::hypot(p.x - drone.x, p.y - drone.y));
+        }
+    }
+
+    // Every sensor takes turns, a few range variations per sensor.
+    const size_t sensors = topics.size();
+    std::vector<IngestMessage> messages;
+    char payload[128];
+    for (size_t v = 0; v < 4; ++v) {
+        for (size_t i = 0; i < sensors; ++i) {
+            SensorData d;
+            d.range = std::round((ranges[i] + 0.01 * static_cast<double>(v)) * 100.0) / 100.0;
+            d.speed = 0.3;
+            d.timestamp_ms = 1000 + static_cast<long long>(v) * 100;
+            IngestMessage msg;
+            msg.topic = topics[i];
+            if (binary) {
+                msg.payload = d.to_binary();
+            } else {
+                std::snprintf(payload, sizeof(payload), "{\"presence\":true,\"ts\":%lld,\"range\":%.2f,\"speed\":%.2f}",
+                              d.timestamp_ms, d.range, d.speed);
+                msg.payload = payload;
+            }
+            messages.push_back(std::move(msg));
+        }
+    }
+
+    SensorRegistry registry;
+    ZonedTracker tracker(positions, registry);
+    WorkStealingExecutor executor;
+    RangeFilterConfig filter;
+    filter.require_presence = true;
+    filter.hampel = true;
+    IngestRouter router("drones/data", registry, tracker, executor, {}, filter);
+
+    // One reading from every sensor first, until then a node run ahead of the others has too few ranges to solve.
+    for (size_t i = 0; i < sensors; ++i) {
+        IngestMessage msg = messages[i];
+        msg.received_at = IngestClock::now();
+        router.route(std::move(msg));
+    }
+    while (g_processed.load(std::memory_order_acquire) < sensors) {
+        std::this_thread::yield();
+    }
+    g_processed = 0;
+
+    PipelineMetrics& metrics = pipeline_metrics();
+    metrics.enable(true);
+
+    const auto period = rate > 0.0 ? std::chrono::duration<double>(1.0 / rate) : std::chrono::duration<double>(0.0);
+    auto start = IngestClock::now();
+    for (size_t i = 0; i < count; ++i) {
+        if (rate > 0.0) {
+            const auto due = start + std::chrono::duration_cast<IngestClock::duration>(period * static_cast<double>(i));
+            while (IngestClock::now() < due) {
+                std::this_thread::yield();
+            }
+        }
+        IngestMessage msg = messages[i % messages.size()];
+        msg.received_at = IngestClock::now();
+        router.route(std::move(msg));
+    }
+    while (g_processed.load(std::memory_order_acquire) < count) {
+        std::this_thread::yield();
+    }
+    const double elapsed = std::chrono::duration<double>(IngestClock::now() - start).count();
+    router.clear();
+
+    // Every sensor sees the same drone and has reported, so every reading must give a fix.
+    const uint64_t fixes = metrics.counter(PipelineCounter::Fixes);
+    if (fixes < count) {
+        std::printf("CHECK FAILED: %llu fixes from %zu messages\n", static_cast<unsigned long long>(fixes), count);
+        return 1;
+    }
+
+    std::printf("nodes: %zu, sensors per node: %zu, messages: %zu (%s), offered: %s, pool workers: %zu\n", nodes, per_node,
+                count, binary ? "binary" : "JSON", rate > 0.0 ? (std::to_string(static_cast<long long>(rate)) + " msg/s").c_str() : "flood",
+                executor.size());
+    std::printf("delivered: %.0f msg/s, fixes: %llu\n", static_cast<double>(count) / elapsed,
+                static_cast<unsigned long long>(fixes));
+    std::printf("%-12s %12s %12s %12s\n", "stage", "p50 us", "p99 us", "max us");
+    for (size_t s = 0; s < LATENCY_STAGE_COUNT; ++s) {
+        const HistogramSnapshot h = metrics.snapshot(static_cast<LatencyStage>(s));
+        if (h.count == 0) continue;
+        std::printf("%-12s %12.2f %12.2f %12.2f\n", latency_stage_name(static_cast<LatencyStage>(s)),
+                    static_cast<double>(h.quantile_ns(0.5)) * 1e-3, static_cast<double>(h.quantile_ns(0.99)) * 1e-3,
+                    static_cast<double>(h.max_ns) * 1e-3);
+    }
+    return 0;
+}
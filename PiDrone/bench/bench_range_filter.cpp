@@ -0,0 +1,193 @@
+/**
+    * @file bench_range_filter.cpp
+    * @brief Fix accuracy, solves and per reading cost with the per-sensor range filters.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * A drone circles a 6 x 5 m room seen by four sensors in the corners at
+    * 10 Hz. Ranges get Gaussian noise of 3 cm and are rounded to centimeters
+    * like the C4001 reports them, 3% of the readings jump by 1 to 4 m and 5%
+    * report no target (range 0). Every reading goes through a RangeFilter and,
+    * unless rejected, into the DroneTracker, for several filter
+    * configurations. Reported are the solves, the RMS and worst position
+    * error against the true position and the share of fixes more than 0.5 m
+    * off, then the cost of one RangeFilter::update() per configuration.
+    *
+    * The running median and MAD of SortedWindow are first checked against a
+    * sort of the same window, for every window size and with many ties.
+    *
+    * Usage: bench_range_filter [epochs]
+*/
+
+// --- Imports ---
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "../RangeFilter.h"
+#include "../DroneTracker.h"
+#include "../SensorRegistry.h"
+// --- End Imports ---
+
+namespace {
+
+struct Variant {
+    const char* name;
+    RangeFilterConfig config;
+};
+
+std::vector<Variant> variants() {
+    std::vector<Variant> out;
+    RangeFilterConfig c;
+    out.push_back({"none (raw ranges)", c});
+    c.require_presence = true;
+    out.push_back({"presence", c});
+    c.smoothing = RangeSmoothing::Ewma;
+    out.push_back({"presence + ewma 0.4", c});
+    c.smoothing = RangeSmoothing::Median;
+    out.push_back({"presence + median 5", c});
+    c.smoothing = RangeSmoothing::None;
+    c.hampel = true;
+    out.push_back({"presence + hampel 7", c});
+    c.smoothing = RangeSmoothing::Ewma;
+    out.push_back({"presence + hampel + ewma", c});
+    c.smoothing = RangeSmoothing::Median;
+    c.median_window = 3;
+    out.push_back({"presence + hampel + median 3", c});
+    return out;
+}
+
+double sorted_median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    const size_t mid = v.size() / 2;
+    return v.size() % 2 ? v[mid] : 0.5 * (v[mid - 1] + v[mid]);
+}
+
+// Returns the number of disagreements with the reference.
+size_t check_windows() {
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int> value(0, 20); // few distinct values, many ties
+    size_t failures = 0;
+    for (size_t capacity = 1; capacity <= MAX_FILTER_WINDOW; ++capacity) {
+        SortedWindow window(capacity);
+        std::vector<double> recent;
+        for (size_t i = 0; i < 2000; ++i) {
+            const double v = 0.05 * value(rng);
+            window.push(v);
+            recent.push_back(v);
+            if (recent.size() > capacity) recent.erase(recent.begin());
+
+            const double m = sorted_median(recent);
+            std::vector<double> deviations;
+            for (double r : recent) deviations.push_back(std::fabs(r - m));
+            failures += window.size() != recent.size();
+            failures += std::fabs(window.median() - m) > 1e-12;
+            failures += std::fabs(window.mad() - sorted_median(deviations)) > 1e-12;
+        }
+    }
+    return failures;
+}
+
+struct Reading {
+    size_t sensor;
+    size_t epoch;
+    SensorData data;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t epochs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    const size_t failures = check_windows();
+    if (failures > 0) {
+        std::printf("CHECK FAILED: %zu running median / MAD results differ from sorting the window\n", failures);
+        return 1;
+    }
+
+    std::map<std::string, Point> positions = {
+        {"esp32_1/radar_A", {0.0, 0.0}},
+        {"esp32_2/radar_A", {6.0, 0.0}},
+        {"esp32_3/radar_A", {6.0, 5.0}},
+        {"esp32_4/radar_A", {0.0, 5.0}}
+    };
+    std::vector<Point> sensor_points;
+    for (const auto& pair : positions) sensor_points.push_back(pair.second);
+
+    // Drone path and the readings of every sensor, the same stream for every variant.
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> noise(0.0, 0.03);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Point> truth(epochs);
+    std::vector<Reading> readings;
+    readings.reserve(epochs * sensor_points.size());
+    for (size_t e = 0; e < epochs; ++e) {
+        const double t = static_cast<double>(e) * 0.1;
+        truth[e] = {3.0 + 1.8 * std::cos(0.3 * t), 2.5 + 1.5 * std::sin(0.3 * t)};
+        for (size_t s = 0; s < sensor_points.size(); ++s) {
+            Reading r{s, e, {}};
+            r.data.timestamp_ms = static_cast<long long>(e) * 100;
+            const double roll = unit(rng);
+            if (roll < 0.05) {
+                r.data.presence = false;
+            } else {
+                double d = std::hypot(truth[e].x - sensor_points[s].x, truth[e].y - sensor_points[s].y) + noise(rng);
+                if (roll < 0.08) d += 1.0 + 3.0 * unit(rng);
+                r.data.range = std::round(d * 100.0) / 100.0;
+            }
+            readings.push_back(r);
+        }
+    }
+
+    std::printf("epochs: %zu, sensors: %zu, readings: %zu, window checks passed\n", epochs, sensor_points.size(),
+                readings.size());
+    std::printf("%-30s %10s %10s %10s %10s %10s\n", "filter", "solves", "rejected", "rms err m", "max err m", "> 0.5 m");
+
+    const std::vector<Variant> all = variants();
+    for (const Variant& v : all) {
+        SensorRegistry registry;
+        DroneTracker tracker(positions, registry);
+        std::vector<SensorHandle> handles;
+        for (const auto& pair : positions) handles.push_back(registry.intern_sensor(pair.first));
+        std::vector<RangeFilter> filters(sensor_points.size(), RangeFilter(v.config));
+
+        size_t solves = 0, rejected = 0, far = 0;
+        double sq = 0.0, worst = 0.0;
+        for (const Reading& r : readings) {
+            const std::optional<double> range = filters[r.sensor].update(r.data);
+            if (!range) {
+                ++rejected;
+                continue;
+            }
+            const std::optional<Fix> fix = tracker.updateAndCalculate(handles[r.sensor], *range, r.data.timestamp_ms);
+            if (!fix) continue;
+            ++solves;
+            const double err = std::hypot(fix->position.x - truth[r.epoch].x, fix->position.y - truth[r.epoch].y);
+            sq += err * err;
+            worst = std::max(worst, err);
+            far += err > 0.5;
+        }
+        const double n = static_cast<double>(solves > 0 ? solves : 1);
+        std::printf("%-30s %10zu %10zu %10.3f %10.2f %9.2f%%\n", v.name, solves, rejected, std::sqrt(sq / n), worst,
+                    100.0 * static_cast<double>(far) / n);
+    }
+
+    std::printf("\n%-30s %14s\n", "filter", "ns/update");
+    double sink = 0.0;
+    for (const Variant& v : all) {
+        std::vector<RangeFilter> filters(sensor_points.size(), RangeFilter(v.config));
+        auto start = std::chrono::steady_clock::now();
+        for (const Reading& r : readings) {
+            const std::optional<double> range = filters[r.sensor].update(r.data);
+            if (range) sink += *range;
+        }
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-30s %14.1f\n", v.name, s / static_cast<double>(readings.size()) * 1e9);
+    }
+    return sink == 0.12345 ? 2 : 0;
+}
@@ -0,0 +1,222 @@
+/**
+    * @file bench_reload.cpp
+    * @brief Sensor geometry reloaded over and over while tracker updates keep running.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Two zones of eight radars on a ring, one updater thread per zone feeding
+    * the ranges of a drone standing still at a known point. A reloader thread
+    * swaps between two surveys of the site, the second one moved by SHIFT,
+    * RELOADS times spread evenly over the updates: reload k waits until every
+    * updater is past k / RELOADS of its updates, and an updater more than one
+    * interval ahead waits for the reloader, so every run does the same reloads
+    * with updates running around each of them, whatever the run length and
+    * however the threads get scheduled. A move of every sensor moves the fix
+    * by the same amount, so every fix has to be the drone's position on
+    * either survey: a solve that mixed positions of both would land anywhere
+    * else.
+    *
+    * Reports update throughput and the latency of single updates with and
+    * without the reloader, the time a reload takes (parsing excluded), and
+    * how many old geometries are still waiting to be freed at the end. The
+    * throughput with the reloader includes updaters waiting for it, on short
+    * runs that is most of the time.
+    *
+    * Checked: every fix matches one survey, nothing retired is left once the
+    * updaters are done, and exactly RELOADS reloads ran.
+    *
+    * Usage: bench_reload [updates_per_thread]
+*/
+
+// --- Imports ---
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ZonedTracker.h"
+#include "../SensorRegistry.h"
+#include "../Epoch.h"
+// --- End Imports ---
+
+namespace {
+
+constexpr size_t ZONES = 2;
+constexpr size_t SENSORS_PER_ZONE = 8;
+// Time every nth update, the clock reads would otherwise be most of what is measured.
+constexpr size_t LATENCY_EVERY = 16;
+constexpr size_t RELOADS = 200;
+const Point SHIFT{0.30, -0.20};
+const double ZONE_SPACING = 100.0;
+const double MATCH_M = 1e-4;
+
+struct Site {
+    std::vector<ZoneConfig> survey;
+    std::vector<ZoneConfig> resurvey;
+    std::vector<Point> drones;
+};
+
+Site site() {
+    Site s;
+    for (size_t z = 0; z < ZONES; ++z) {
+        ZoneConfig zone;
+        zone.name = "zone_" + std::to_string(z + 1);
+        const Point center{ZONE_SPACING * static_cast<double>(z), 0.0};
+        for (size_t i = 0; i < SENSORS_PER_ZONE; ++i) {
+            const double angle = 2.0 * M_PI * static_cast<double>(i) / SENSORS_PER_ZONE;
+            const std::string id = "esp32_" + std::to_string(z * SENSORS_PER_ZONE + i + 1) + "/radar_A";
+            zone.sensor_positions[id] = {center.x + 5.0 * std::cos(angle), center.y + 5.0 * std::sin(angle)};
+        }
+        ZoneConfig moved = zone;
+        for (auto& pair : moved.sensor_positions) {
+            pair.second = {pair.second.x + SHIFT.x, pair.second.y + SHIFT.y};
+        }
+        s.survey.push_back(zone);
+        s.resurvey.push_back(moved);
+        s.drones.push_back({center.x + 1.0, center.y + 0.5});
+    }
+    return s;
+}
+
+struct RunResult {
+    double updates_per_s;
+    double p50_ns;
+    double p99_ns;
+    double max_ns;
+    size_t fixes;
+    size_t mismatched;
+    size_t reloads;
+    double reload_us;
+};
+
+RunResult run(const Site& s, size_t updates, bool reloading) {
+    SensorRegistry registry;
+    ZonedTracker tracker(s.survey, registry);
+
+    std::atomic<bool> go{false};
+    std::atomic<size_t> running{ZONES};
+    std::atomic<size_t> fixes{0};
+    std::atomic<size_t> mismatched{0};
+    // Paces updaters and reloader against each other, see the file comment.
+    const size_t interval = std::max<size_t>(1, updates / RELOADS);
+    std::atomic<size_t> reloads_done{0};
+    std::vector<std::atomic<size_t>> progress(ZONES);
+    std::vector<std::vector<double>> latencies(ZONES);
+    std::vector<std::thread> threads;
+
+    for (size_t z = 0; z < ZONES; ++z) {
+        threads.emplace_back([&, z] {
+            std::vector<SensorHandle> handles;
+            std::vector<double> ranges;
+            for (const auto& pair : s.survey[z].sensor_positions) {
+                handles.push_back(registry.find_sensor(pair.first));
+                ranges.push_back(std::hypot(pair.second.x - s.drones[z].x, pair.second.y - s.drones[z].y));
+            }
+            const Point moved{s.drones[z].x + SHIFT.x, s.drones[z].y + SHIFT.y};
+            std::vector<double>& samples = latencies[z];
+            samples.reserve(updates / LATENCY_EVERY + 1);
+            while (!go.load(std::memory_order_acquire)) {}
+
+            size_t local_fixes = 0;
+            size_t local_mismatched = 0;
+            for (size_t i = 0; i < updates; ++i) {
+                if (reloading && i % interval == 0) {
+                    progress[z].store(i, std::memory_order_release);
+                    while (i >= (reloads_done.load(std::memory_order_acquire) + 2) * interval) {
+                        std::this_thread::yield();
+                    }
+                }
+                const size_t k = i % handles.size();
+                const bool timed = i % LATENCY_EVERY == 0;
+                const auto start = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+                const std::optional<Fix> fix = tracker.updateAndCalculate(handles[k], ranges[k], static_cast<long long>(i));
+                if (timed) {
+                    samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+                }
+                if (!fix) continue;
+                ++local_fixes;
+                const double a = std::hypot(fix->position.x - s.drones[z].x, fix->position.y - s.drones[z].y);
+                const double b = std::hypot(fix->position.x - moved.x, fix->position.y - moved.y);
+                if (std::min(a, b) > MATCH_M) ++local_mismatched;
+            }
+            fixes += local_fixes;
+            mismatched += local_mismatched;
+            progress[z].store(updates, std::memory_order_release);
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    size_t reloads = 0;
+    double reload_s = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    if (reloading) {
+        for (; reloads < RELOADS; reloads_done.store(++reloads, std::memory_order_release)) {
+            auto behind = [&] {
+                for (const auto& p : progress) {
+                    if (p.load(std::memory_order_acquire) < (reloads + 1) * interval) return true;
+                }
+                return false;
+            };
+            while (behind() && running.load(std::memory_order_acquire) > 0) {
+                std::this_thread::yield();
+            }
+            const auto t0 = std::chrono::steady_clock::now();
+            tracker.reload(reloads % 2 == 0 ? s.resurvey : s.survey, registry);
+            epoch_domain().reclaim();
+            reload_s += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        }
+    }
+    for (auto& t : threads) t.join();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    for (const auto& samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+    std::sort(all.begin(), all.end());
+    RunResult r{static_cast<double>(ZONES * updates) / elapsed, 0.0, 0.0, 0.0, fixes.load(), mismatched.load(),
+                reloads, reloads > 0 ? reload_s / static_cast<double>(reloads) * 1e6 : 0.0};
+    if (!all.empty()) {
+        r.p50_ns = all[all.size() / 2];
+        r.p99_ns = all[all.size() * 99 / 100];
+        r.max_ns = all.back();
+    }
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t updates = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    const Site s = site();
+    std::printf("%zu zones of %zu radars, %zu updates per zone, resurvey moves every sensor by (%.2f, %.2f) m\n", ZONES,
+                SENSORS_PER_ZONE, updates, SHIFT.x, SHIFT.y);
+    std::printf("%-10s %12s %10s %10s %12s %10s %10s %12s\n", "reloader", "upd/s", "p50 ns", "p99 ns", "max ns", "fixes",
+                "reloads", "reload us");
+    for (bool reloading : {false, true}) {
+        const RunResult r = run(s, updates, reloading);
+        std::printf("%-10s %12.0f %10.0f %10.0f %12.0f %10zu %10zu %12.1f\n", reloading ? "on" : "off", r.updates_per_s,
+                    r.p50_ns, r.p99_ns, r.max_ns, r.fixes, r.reloads, r.reload_us);
+        if (r.fixes == 0 || r.mismatched > 0) {
+            std::printf("CHECK FAILED: %zu of %zu fixes match neither survey\n", r.mismatched, r.fixes);
+            return 1;
+        }
+        if (reloading && r.reloads != RELOADS) {
+            std::printf("CHECK FAILED: %zu of %zu reloads\n", r.reloads, RELOADS);
+            return 1;
+        }
+    }
+
+    const size_t pending = epoch_domain().reclaim();
+    std::printf("retired geometries still waiting after the run: %zu\n", pending);
+    if (pending != 0) {
+        std::printf("CHECK FAILED: old geometries were never freed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+/**
+    * @file bench_router.cpp
+    * @brief IngestRouter with several ingest threads: global lock vs. single-writer per-node routing.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Paho can deliver on more than one callback thread if the nodes are split
+    * over several connections. Each thread routes its own pre-built binary
+    * messages to a disjoint set of nodes, which is what route() requires.
+    * "global lock" wraps route() in one mutex, which is what IngestRouter
+    * did before: every message of every node went through a lock shared by
+    * all of them. "per node" calls route() directly, it takes no lock or flag.
+    * Reports the delivered msg/s and the CPU time an ingest thread spends in
+    * one route() call, waiting for the lock included; with fewer cores than
+    * threads only the latter is telling. Every row is the best of REPEATS
+    * alternating runs.
+    *
+    * Checked: every message is processed, every node is discovered exactly
+    * once, per-node routing stays within MIN_MEAN_RATIO of the global lock's
+    * CPU per route() on the geometric mean over all thread counts, and no row
+    * falls below MIN_RATIO. The lock it saves is mostly uncontended on few
+    * cores, so the gain is a few percent and the margins only absorb noise.
+    *
+    * Usage: bench_router [messages_per_thread] [nodes]
+*/
+
+// --- Imports ---
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../IngestRouter.h"
+#include "../WorkStealingExecutor.h"
+#include "../ZonedTracker.h"
+#include "../SensorRegistry.h"
+#include "../SensorModel.h"
+// --- End Imports ---
+
+namespace {
+
+const size_t SENSORS_PER_NODE = 2;
+const size_t MAX_THREADS = 8;
+const int REPEATS = 3;
+const double MIN_MEAN_RATIO = 0.95;
+const double MIN_RATIO = 0.9;
+
+std::atomic<size_t> g_processed{0};
+
+long long thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+} // namespace
+
+void process_sensor_update(const std::string&, const TrackedSensor&) {
+    g_processed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void process_drone_location(const Fix&, IngestClock::time_point) {}
+
+namespace {
+
+struct RunResult {
+    double rate;
+    double route_ns;
+    size_t discovered;
+};
+
+RunResult run(size_t threads, size_t nodes, size_t per_thread, bool global_lock) {
+    std::map<std::string, Point> positions;
+    for (size_t n = 0; n < nodes && positions.size() < DroneTracker::MAX_SENSORS; ++n) {
+        for (size_t s = 0; s < SENSORS_PER_NODE; ++s) {
+            positions["esp32_" + std::to_string(n) + "/radar_" + std::to_string(s)] = {static_cast<double>(n), static_cast<double>(s)};
+        }
+    }
+
+    // Built up front, the timed loop only moves them.
+    std::vector<std::vector<IngestMessage>> traffic(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        // Thread t owns the nodes n with n % threads == t.
+        const size_t owned = (nodes - t + threads - 1) / threads;
+        for (size_t i = 0; i < per_thread; ++i) {
+            const size_t node = t + (i % owned) * threads;
+            SensorData d;
+            d.range = 2.0 + static_cast<double>(i % 10) * 0.01;
+            d.speed = 0.3;
+            d.timestamp_ms = 1000 + static_cast<long long>(i);
+            IngestMessage msg;
+            msg.topic = "drones/data/esp32_" + std::to_string(node) + "/radar_" + std::to_string(i / nodes % SENSORS_PER_NODE);
+            msg.payload = d.to_binary();
+            traffic[t].push_back(std::move(msg));
+        }
+    }
+
+    SensorRegistry registry;
+    ZonedTracker tracker(positions, registry);
+    WorkStealingExecutor executor;
+    std::atomic<size_t> discovered{0};
+    IngestRouter router("drones/data", registry, tracker, executor, [&](const std::string&) { discovered++; });
+    std::mutex global;
+    std::atomic<long long> route_ns{0};
+    g_processed = 0;
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            const long long cpu_start = thread_cpu_ns();
+            for (IngestMessage& msg : traffic[t]) {
+                msg.received_at = IngestClock::now();
+                if (global_lock) {
+                    std::lock_guard<std::mutex> lock(global);
+                    router.route(std::move(msg));
+                } else {
+                    router.route(std::move(msg));
+                }
+            }
+            route_ns += thread_cpu_ns() - cpu_start;
+        });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : pool) thread.join();
+    const size_t total = threads * per_thread;
+    while (g_processed.load(std::memory_order_relaxed) < total) {
+        std::this_thread::yield();
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    router.clear();
+    return {static_cast<double>(total) / elapsed, static_cast<double>(route_ns.load()) / static_cast<double>(total),
+            discovered.load()};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    size_t nodes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+    // Every thread needs a node of its own.
+    nodes = std::max(nodes, MAX_THREADS);
+
+    std::printf("%zu nodes x %zu radars, %zu messages per ingest thread, %u hardware threads\n", nodes, SENSORS_PER_NODE,
+                per_thread, std::thread::hardware_concurrency());
+    std::printf("%-8s %-12s %14s %16s\n", "threads", "routing", "msg/s", "route() cpu ns");
+    double log_ratio_sum = 0.0;
+    double worst = INFINITY;
+    int rows = 0;
+    for (size_t threads : {size_t(1), size_t(2), size_t(4), MAX_THREADS}) {
+        RunResult best[2] = {{0.0, INFINITY, 0}, {0.0, INFINITY, 0}};
+        for (int repeat = 0; repeat < REPEATS; ++repeat) {
+            for (bool global_lock : {true, false}) {
+                const RunResult r = run(threads, nodes, per_thread, global_lock);
+                if (r.discovered != nodes) {
+                    std::printf("CHECK FAILED: %zu of %zu nodes discovered\n", r.discovered, nodes);
+                    return 1;
+                }
+                RunResult& b = best[global_lock ? 0 : 1];
+                b.rate = std::max(b.rate, r.rate);
+                b.route_ns = std::min(b.route_ns, r.route_ns);
+                b.discovered = r.discovered;
+            }
+        }
+        for (bool global_lock : {true, false}) {
+            const RunResult& b = best[global_lock ? 0 : 1];
+            std::printf("%-8zu %-12s %14.0f %16.1f\n", threads, global_lock ? "global lock" : "per node", b.rate, b.route_ns);
+        }
+        const double ratio = best[0].route_ns / best[1].route_ns;
+        log_ratio_sum += std::log(ratio);
+        worst = std::min(worst, ratio);
+        ++rows;
+    }
+
+    const double mean_ratio = std::exp(log_ratio_sum / rows);
+    std::printf("\nper-node route() is %.2fx cheaper than the global lock, geometric mean\n", mean_ratio);
+    if (mean_ratio < MIN_MEAN_RATIO || worst < MIN_RATIO) {
+        std::printf("CHECK FAILED: per-node route() at %.2fx of the global lock on average, %.2fx at worst\n", mean_ratio,
+                    worst);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+    * @file bench_sensor_history.cpp
+    * @brief Per update cost of the TrackedSensor history, deque and full re-sum vs. ring with running sums.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Feeds a stream of readings (10 Hz, with a node reboot every 50000
+    * readings) into the old deque history, which re-summed the whole history
+    * for getAverageSpeed(), and into TrackedSensor, at several capacities, and
+    * times an update followed by the average speed query. Before any timing,
+    * every window query (whole history, last N readings, last T ms) is checked
+    * against a direct computation over the retained readings, across enough
+    * readings for the running sums to be rebased several times.
+    *
+    * Usage: bench_sensor_history [readings]
+*/
+
+// --- Imports ---
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../SensorModel.h"
+// --- End Imports ---
+
+namespace {
+
+// The history as TrackedSensor kept it before.
+class DequeHistory {
+    std::deque<SensorData> history_;
+    size_t max_history_size_;
+
+public:
+    explicit DequeHistory(size_t history_size) : max_history_size_(history_size) {}
+
+    void addDataPoint(const SensorData& data) {
+        history_.push_front(data);
+        if (history_.size() > max_history_size_) {
+            history_.pop_back();
+        }
+    }
+
+    double getAverageSpeed() const {
+        if (history_.empty()) return 0.0;
+        double sum = std::accumulate(history_.begin(), history_.end(), 0.0,
+            [](double sum, const SensorData& data) {
+                return sum + data.speed;
+            });
+        return sum / history_.size();
+    }
+};
+
+std::vector<SensorData> make_stream(size_t count) {
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> noise(0.0, 0.05);
+    std::vector<SensorData> stream(count);
+    long long clock = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 50000 == 0) clock = 1000; // reboot, millis() starts over
+        clock += 100;
+        stream[i].timestamp_ms = clock;
+        stream[i].range = 4.0 + 3.0 * std::sin(static_cast<double>(i) * 1e-3) + noise(rng);
+        stream[i].speed = 0.8 * std::cos(static_cast<double>(i) * 1e-3) + noise(rng);
+        stream[i].sequence = static_cast<uint32_t>(i);
+    }
+    return stream;
+}
+
+// Direct computation over stream[first, end).
+WindowStats reference(const std::vector<SensorData>& stream, size_t first, size_t end) {
+    WindowStats stats;
+    stats.count = end - first;
+    if (stats.count == 0) return stats;
+    stats.span_ms = stream[end - 1].timestamp_ms - stream[first].timestamp_ms;
+    auto series = [&](double SensorData::*field) {
+        SeriesStats s;
+        for (size_t i = first; i < end; ++i) s.sum += stream[i].*field;
+        s.mean = s.sum / static_cast<double>(stats.count);
+        if (stats.count > 1) {
+            for (size_t i = first; i < end; ++i) s.variance += (stream[i].*field - s.mean) * (stream[i].*field - s.mean);
+            s.variance /= static_cast<double>(stats.count);
+        }
+        return s;
+    };
+    stats.range = series(&SensorData::range);
+    stats.speed = series(&SensorData::speed);
+    return stats;
+}
+
+bool close(double a, double b, double scale) {
+    return std::fabs(a - b) <= 1e-9 * scale;
+}
+
+bool same(const WindowStats& a, const WindowStats& b) {
+    const double n = static_cast<double>(b.count > 0 ? b.count : 1);
+    return a.count == b.count && a.span_ms == b.span_ms
+        && close(a.range.sum, b.range.sum, 100.0 * n) && close(a.range.mean, b.range.mean, 100.0)
+        && close(a.range.variance, b.range.variance, 100.0)
+        && close(a.speed.sum, b.speed.sum, 100.0 * n) && close(a.speed.mean, b.speed.mean, 100.0)
+        && close(a.speed.variance, b.speed.variance, 100.0);
+}
+
+// Returns the number of queries that disagree with the reference.
+size_t check(const std::vector<SensorData>& stream, size_t capacity) {
+    TrackedSensor sensor("radar_A", capacity);
+    size_t failures = 0, clock_start = 0;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        if (i > 0 && stream[i].timestamp_ms < stream[i - 1].timestamp_ms) clock_start = i;
+        sensor.addDataPoint(stream[i]);
+        const size_t end = i + 1;
+        const size_t oldest = end > capacity ? end - capacity : 0;
+
+        // Checking every reading is quadratic in the capacity, sample instead.
+        if (i % 97 != 0 && i + 1 != stream.size()) continue;
+        failures += sensor.getLatestData().sequence != stream[i].sequence;
+        failures += sensor.getReading(sensor.size() - 1).sequence != stream[oldest].sequence;
+        failures += !same(sensor.getStats(), reference(stream, oldest, end));
+        const size_t n = 1 + i % (capacity + 3);
+        failures += !same(sensor.getStatsForLast(n), reference(stream, n < end - oldest ? end - n : oldest, end));
+        const long long ms = static_cast<long long>(i % 7) * 150;
+        size_t first = oldest > clock_start ? oldest : clock_start;
+        while (stream[first].timestamp_ms < stream[i].timestamp_ms - ms) ++first;
+        failures += !same(sensor.getStatsForLastMs(ms), reference(stream, first, end));
+    }
+    return failures;
+}
+
+template <typename History>
+double time_updates(const std::vector<SensorData>& stream, size_t capacity, double& sink) {
+    History history("radar_A", capacity);
+    auto start = std::chrono::steady_clock::now();
+    for (const SensorData& d : stream) {
+        history.addDataPoint(d);
+        sink += history.getAverageSpeed();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct NamedDequeHistory : DequeHistory {
+    NamedDequeHistory(const char*, size_t capacity) : DequeHistory(capacity) {}
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::vector<SensorData> stream = make_stream(count);
+    const size_t capacities[] = {1, 20, 200, 2000};
+
+    for (size_t capacity : capacities) {
+        const size_t failures = check(stream, capacity);
+        if (failures > 0) {
+            std::printf("CHECK FAILED: capacity %zu, %zu window queries disagree with the direct computation\n",
+                        capacity, failures);
+            return 1;
+        }
+    }
+
+    std::printf("readings: %zu, window queries match the direct computation\n", count);
+    std::printf("%-10s %18s %18s %10s\n", "capacity", "deque ns/update", "ring ns/update", "speedup");
+    double sink = 0.0;
+    for (size_t capacity : capacities) {
+        const double deque_s = time_updates<NamedDequeHistory>(stream, capacity, sink);
+        const double ring_s = time_updates<TrackedSensor>(stream, capacity, sink);
+        const double n = static_cast<double>(count);
+        std::printf("%-10zu %18.1f %18.1f %9.1fx\n", capacity, deque_s / n * 1e9, ring_s / n * 1e9, deque_s / ring_s);
+    }
+
+    TrackedSensor sensor("radar_A", 2000);
+    for (const SensorData& d : stream) sensor.addDataPoint(d);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        sink += sensor.getStatsForLastMs(static_cast<long long>(i % 200) * 10).range.variance;
+    }
+    const double query_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("last T ms query, capacity 2000: %.1f ns\n", query_s / static_cast<double>(count) * 1e9);
+    return sink == 0.12345 ? 2 : 0;
+}
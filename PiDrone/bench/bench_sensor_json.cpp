@@ -0,0 +1,213 @@
+/**
+    * @file bench_sensor_json.cpp
+    * @brief Equivalence fuzz and decode cost of the schema specialized JSON decoder.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Starts from a corpus of payloads shaped like the ones the ESP32 firmware
+    * publishes, plus unusual but valid variants (whitespace, unknown and nested
+    * keys, duplicates, exponents), and mutates them with byte flips, truncations
+    * and insertions. For every input SensorData::from_json_text must give the
+    * same fields, bit for bit, or throw when the generic parser throws. Then
+    * times both decoders on the unmutated firmware payloads.
+    *
+    * Usage: bench_sensor_json [messages] [mutations]
+*/
+
+// --- Imports ---
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "../SensorModel.h"
+// --- End Imports ---
+
+namespace {
+
+template <typename Fn>
+double time_it(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Outcome {
+    bool threw = false;
+    SensorData data;
+};
+
+Outcome generic(const std::string& payload) {
+    Outcome o;
+    try {
+        o.data = SensorData::from_json(nlohmann::json::parse(payload));
+    } catch (const std::exception&) {
+        o.threw = true;
+    }
+    return o;
+}
+
+Outcome fast(const std::string& payload) {
+    Outcome o;
+    try {
+        o.data = SensorData::from_json_text(payload);
+    } catch (const std::exception&) {
+        o.threw = true;
+    }
+    return o;
+}
+
+bool same_bits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+bool same(const Outcome& a, const Outcome& b) {
+    if (a.threw || b.threw) return a.threw == b.threw;
+    return same_bits(a.data.range, b.data.range) && same_bits(a.data.speed, b.data.speed)
+        && a.data.timestamp_ms == b.data.timestamp_ms && a.data.presence == b.data.presence;
+}
+
+const char* const CORPUS[] = {
+    "{\"presence\":true,\"ts\":1000123,\"range\":3.27,\"speed\":-0.84}",
+    "{\"presence\":false,\"ts\":1000123}",
+    "{\"range\":1.5,\"speed\":0.0,\"ts\":42}",
+    "{}",
+    " { \"range\" : 2.25 ,\n\t\"speed\" : -1e-2 , \"ts\" : 7 } \r\n",
+    "{\"range\":12,\"speed\":-3,\"ts\":-5,\"presence\":true}",
+    "{\"range\":-0,\"speed\":-0.0,\"ts\":-0}",
+    "{\"range\":1E3,\"speed\":2.5e+1,\"ts\":9223372036854775807}",
+    "{\"range\":0.1,\"range\":0.2,\"ts\":1,\"ts\":2}",
+    "{\"id\":\"radar_C4001\",\"range\":4.5,\"meta\":{\"fw\":[1,2,{\"x\":null}],\"ok\":true},\"ts\":3}",
+    "{\"range\":123456789012345678901234567890,\"ts\":1}",
+    "{\"range\":4.9406564584124654e-324,\"speed\":1.7976931348623157e308}",
+    "{\"range\":1e400}",
+    "{\"range\":1e-400}",
+    "{\"ts\":1.5}",
+    "{\"ts\":18446744073709551615}",
+    "{\"ts\":1e3}",
+    "{\"range\":\"3.2\"}",
+    "{\"range\":true,\"speed\":false}",
+    "{\"range\":null}",
+    "{\"presence\":1}",
+    "{\"note\":\"caf\\u00e9\",\"range\":1.0}",
+    "{\"note\":\"tab\\tquote\\\"\",\"range\":1.0}",
+    "{\"n\\u0061me\":1,\"r\\u0061nge\":2.0}",
+    "\xEF\xBB\xBF{\"range\":1.0}",
+    "[1,2,3]",
+    "3.5",
+    "",
+    "{\"range\":01}",
+    "{\"range\":1.}",
+    "{\"range\":.5}",
+    "{\"range\":+1}",
+    "{\"range\":1,}",
+    "{\"range\":1}}",
+    "{\"range\":1} x",
+    "{\"a\":[[[[[[[[[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]]]]]]]],\"range\":1}",
+};
+
+// Characters that move a payload across the interesting grammar boundaries.
+const char MUTATION_BYTES[] = "{}[]\":,.-+eE0159tfn \\\t\x01\x80";
+
+std::string mutate(std::string s, std::mt19937_64& rng) {
+    std::uniform_int_distribution<int> op(0, 3);
+    std::uniform_int_distribution<size_t> pick(0, sizeof(MUTATION_BYTES) - 2);
+    const size_t edits = 1 + rng() % 3;
+    for (size_t e = 0; e < edits; ++e) {
+        const size_t at = s.empty() ? 0 : rng() % (s.size() + 1);
+        switch (op(rng)) {
+            case 0:
+                if (at < s.size()) s[at] = MUTATION_BYTES[pick(rng)];
+                break;
+            case 1:
+                s.insert(s.begin() + static_cast<std::ptrdiff_t>(at), MUTATION_BYTES[pick(rng)]);
+                break;
+            case 2:
+                if (at < s.size()) s.erase(at, 1);
+                break;
+            default:
+                s.resize(at);
+                break;
+        }
+    }
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t mutations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> range(0.6, 12.0);
+    std::uniform_real_distribution<double> speed(-5.0, 5.0);
+    std::uniform_int_distribution<int> absent(0, 9);
+
+    // Firmware shaped payloads, same as RadarC4001::buildJsonPayload.
+    std::vector<std::string> json(count);
+    char buffer[256];
+    for (size_t i = 0; i < count; ++i) {
+        const long long ts = 1000000 + static_cast<long long>(i) * 100;
+        if (absent(rng) != 0) {
+            std::snprintf(buffer, sizeof(buffer), "{\"presence\":true,\"ts\":%lld,\"range\":%.2f,\"speed\":%.2f}",
+                          ts, range(rng), speed(rng));
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "{\"presence\":false,\"ts\":%lld}", ts);
+        }
+        json[i] = buffer;
+    }
+
+    // Equivalence: the corpus, the firmware payloads, then mutations of both.
+    std::vector<std::string> seeds(std::begin(CORPUS), std::end(CORPUS));
+    for (size_t i = 0; i < count && i < 1000; ++i) seeds.push_back(json[i]);
+
+    size_t checked = 0, accepted = 0, rejected = 0;
+    auto check = [&](const std::string& payload) {
+        SensorJsonFields fields;
+        accepted += SensorJsonParser::parse(payload, fields);
+        Outcome a = generic(payload);
+        Outcome b = fast(payload);
+        rejected += a.threw;
+        ++checked;
+        if (!same(a, b)) {
+            std::printf("MISMATCH on '%s': generic %s, fast %s\n", payload.c_str(),
+                        a.threw ? "threw" : "parsed", b.threw ? "threw" : "parsed");
+            return false;
+        }
+        return true;
+    };
+    for (const std::string& s : seeds) {
+        if (!check(s)) return 1;
+    }
+    for (size_t i = 0; i < mutations; ++i) {
+        if (!check(mutate(seeds[rng() % seeds.size()], rng))) return 1;
+    }
+    for (const std::string& p : json) {
+        SensorJsonFields fields;
+        if (!SensorJsonParser::parse(p, fields)) {
+            std::printf("firmware payload took the slow path: %s\n", p.c_str());
+            return 1;
+        }
+    }
+
+    double sink = 0.0;
+    double generic_s = time_it([&] {
+        for (const std::string& p : json) sink += SensorData::from_json(nlohmann::json::parse(p)).range;
+    });
+    double fast_s = time_it([&] {
+        for (const std::string& p : json) sink += SensorData::from_json_text(p).range;
+    });
+
+    const double n = static_cast<double>(count);
+    std::printf("equivalence: %zu inputs, %zu on the fast path, %zu rejected by both, no mismatch\n",
+                checked, accepted, rejected);
+    std::printf("messages: %zu\n", count);
+    std::printf("%-26s %10.1f ns/msg\n", "json::parse + from_json", generic_s / n * 1e9);
+    std::printf("%-26s %10.1f ns/msg\n", "from_json_text", fast_s / n * 1e9);
+    std::printf("schema decoder: %.1fx faster (checksum %.1f)\n", generic_s / fast_s, sink);
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+    * @file bench_tracker_contention.cpp
+    * @brief DroneTracker update throughput with N concurrent updater threads.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Compares the lock-free DroneTracker against the previous design, where every
+    * update from every NodeManager went through one mutex. Each thread owns a
+    * disjoint set of sensors, the same way NodeManagers do. Runs are noisy on a
+    * shared machine, every row is the best of REPEATS alternating runs.
+    *
+    * Checked: the lock-free tracker is ahead on the geometric mean over all
+    * thread counts and no row falls below MIN_RATIO of the mutex.
+    *
+    * Usage: bench_tracker_contention [updates_per_thread] [max_threads]
+*/
+
+// --- Imports ---
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../DroneTracker.h"
+#include "../SensorRegistry.h"
+#include "../Multilateration.h"
+// --- End Imports ---
+
+namespace {
+
+constexpr size_t NUM_SENSORS = 16;
+constexpr size_t REPEATS = 5;
+const double MIN_RATIO = 0.9;
+
+// The previous design, one mutex around every update and the solve. It wraps
+// the same DroneTracker, so both do exactly the same work (subset choice,
+// staleness, solve) and only the synchronization differs.
+class MutexTracker {
+    private:
+        std::mutex data_mutex_;
+        DroneTracker tracker_;
+
+    public:
+        MutexTracker(const std::map<std::string, Point>& positions, SensorRegistry& registry)
+            : tracker_(positions, registry) {}
+
+        std::optional<Fix> updateAndCalculate(SensorHandle sensor, double distance, long long timestamp_ms) {
+            std::lock_guard<std::mutex> lock(data_mutex_);
+            return tracker_.updateAndCalculate(sensor, distance, timestamp_ms);
+        }
+};
+
+template <typename Tracker>
+double run(Tracker& tracker, const std::vector<SensorHandle>& handles, size_t threads, size_t updates) {
+    std::atomic<bool> go{false};
+    std::atomic<size_t> fixes{0};
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {}
+            size_t local_fixes = 0;
+            for (size_t i = 0; i < updates; ++i) {
+                // Thread t owns sensors t, t + threads, t + 2 * threads, ...
+                size_t owned = (NUM_SENSORS - t + threads - 1) / threads;
+                size_t sensor = t + (i % owned) * threads;
+                double range = 3.0 + 0.001 * static_cast<double>(i % 1000);
+                if (tracker.updateAndCalculate(handles[sensor], range, static_cast<long long>(i))) {
+                    ++local_fixes;
+                }
+            }
+            fixes += local_fixes;
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) w.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(threads * updates) / elapsed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t updates = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+    if (max_threads > NUM_SENSORS) max_threads = NUM_SENSORS;
+
+    std::map<std::string, Point> positions;
+    for (size_t i = 0; i < NUM_SENSORS; ++i) {
+        double angle = 2.0 * M_PI * static_cast<double>(i) / NUM_SENSORS;
+        char id[32];
+        std::snprintf(id, sizeof(id), "esp32_%02zu/radar_A", i);
+        positions[id] = {5.0 * std::cos(angle), 5.0 * std::sin(angle)};
+    }
+
+    SensorRegistry registry;
+    std::vector<SensorHandle> handles;
+    for (const auto& pair : positions) handles.push_back(registry.intern_sensor(pair.first));
+
+    std::printf("updates per thread: %zu, sensors: %zu\n", updates, NUM_SENSORS);
+    std::printf("%8s %18s %18s %8s\n", "threads", "mutex upd/s", "lock-free upd/s", "ratio");
+
+    double log_ratio = 0.0;
+    size_t rows = 0;
+    double worst = 0.0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        MutexTracker locked(positions, registry);
+        DroneTracker lock_free(positions, registry);
+        double a = 0.0, b = 0.0;
+        for (size_t rep = 0; rep < REPEATS; ++rep) {
+            a = std::max(a, run(locked, handles, threads, updates));
+            b = std::max(b, run(lock_free, handles, threads, updates));
+        }
+        std::printf("%8zu %18.0f %18.0f %8.2f\n", threads, a, b, b / a);
+        log_ratio += std::log(b / a);
+        worst = rows == 0 ? b / a : std::min(worst, b / a);
+        ++rows;
+    }
+
+    const double mean_ratio = std::exp(log_ratio / static_cast<double>(rows));
+    std::printf("geometric mean ratio: %.2f\n", mean_ratio);
+    if (mean_ratio < 1.0 || worst < MIN_RATIO) {
+        std::printf("CHECK FAILED: lock-free at %.2fx of the mutex on average, %.2fx at worst\n", mean_ratio, worst);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,259 @@
+/**
+    * @file bench_zones.cpp
+    * @brief Zone-sharded tracking: several sites in one process, and drones crossing between zones.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * First runs 1 to 8 separate sites, each a ring of four nodes with two
+    * radars and its own drone, SITE_SPACING apart. Every site is one zone
+    * with its own DroneTracker, against all sensors in one tracker as before.
+    * Both are flooded for the throughput and paced at PACED_RATE msg/s for
+    * the accuracy, scored against the ground truth as in bench_scenario. One
+    * tracker combines ranges of sites a hundred meters apart into one solve,
+    * zoned every site is solved on its own.
+    *
+    * Then two adjacent zones with one drone flying from the middle of one to
+    * the middle of the other and back, to show the handoff: how many fixes
+    * were handed off, and how many of the fixes within ACCURATE_M of the
+    * drone are reported in the zone it actually was in. The rest are mostly
+    * fixes of the zone the drone is leaving, solved while some of its radars
+    * still hold the range from before they lost it; those are counted apart.
+    *
+    * Checked: every zoned site is located to within 0.5 m at p50, the
+    * crossing drone causes handoffs and at least 90 % of its accurate fixes
+    * are reported in the zone it was in.
+    *
+    * Usage: bench_zones [messages]
+*/
+
+// --- Imports ---
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ScenarioGenerator.h"
+#include "../IngestRouter.h"
+#include "../WorkStealingExecutor.h"
+#include "../ZonedTracker.h"
+#include "../SensorRegistry.h"
+// --- End Imports ---
+
+namespace {
+
+const double SITE_SPACING = 100.0;
+// Neighbouring zones for the handoff run, their areas just touch.
+const double CROSSING_SPACING = 14.0;
+const double PACED_RATE = 100000.0;
+// Fixes this close to the drone count as accurate for the handoff score.
+const double ACCURATE_M = 1.0;
+
+std::atomic<size_t> g_processed{0};
+
+// What the fix callback needs to score a fix, set up per run.
+struct Scoring {
+    const ScenarioGenerator* generator = nullptr;
+    std::vector<ZoneConfig> zones; // areas already resolved
+    std::unique_ptr<IngestClock::time_point[]> received;
+    std::unique_ptr<double[]> sim_time;
+    std::atomic<size_t> routed{0};
+    std::unique_ptr<double[]> errors;
+    std::atomic<size_t> fixes{0};
+    std::atomic<size_t> accurate{0};
+    std::atomic<size_t> right_zone{0};
+    size_t capacity = 0;
+};
+
+Scoring g_scoring;
+
+bool in_area(const ZoneConfig& zone, const Point& p) {
+    return p.x >= zone.area_min.x && p.x <= zone.area_max.x && p.y >= zone.area_min.y && p.y <= zone.area_max.y;
+}
+
+} // namespace
+
+void process_sensor_update(const std::string&, const TrackedSensor&) {
+    g_processed.fetch_add(1, std::memory_order_release);
+}
+
+// The message that led to the fix is the last one routed at or before received_at.
+void process_drone_location(const Fix& fix, IngestClock::time_point received_at) {
+    const size_t routed = g_scoring.routed.load(std::memory_order_acquire);
+    const IngestClock::time_point* begin = g_scoring.received.get();
+    const size_t index = static_cast<size_t>(std::upper_bound(begin, begin + routed, received_at) - begin);
+    if (index == 0) return;
+    const double t = g_scoring.sim_time[index - 1];
+    double best = 1e9;
+    Point nearest{};
+    for (size_t d = 0; d < g_scoring.generator->drone_count(); ++d) {
+        const Point p = g_scoring.generator->drone_position(d, t);
+        const double error = std::hypot(fix.position.x - p.x, fix.position.y - p.y);
+        if (error < best) {
+            best = error;
+            nearest = p;
+        }
+    }
+    if (best <= ACCURATE_M) {
+        g_scoring.accurate.fetch_add(1, std::memory_order_relaxed);
+        if (fix.zone < g_scoring.zones.size() && in_area(g_scoring.zones[fix.zone], nearest)) {
+            g_scoring.right_zone.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    const size_t slot = g_scoring.fixes.fetch_add(1, std::memory_order_relaxed);
+    if (slot < g_scoring.capacity) g_scoring.errors[slot] = best;
+}
+
+namespace {
+
+// Each site a ring of four nodes with two radars, radius 5 m, and a drone circling a 4 m square in it.
+ScenarioConfig sites(size_t count, double spacing) {
+    ScenarioConfig config;
+    config.dropout = 0.01;
+    for (size_t z = 0; z < count; ++z) {
+        ScenarioConfig ring = ScenarioConfig::ring(4, 2, 0);
+        const Point center{spacing * static_cast<double>(z), 0.0};
+        const Point ring_center{(ring.area_min.x + ring.area_max.x) / 2.0, (ring.area_min.y + ring.area_max.y) / 2.0};
+        for (size_t n = 0; n < ring.nodes.size(); ++n) {
+            ScenarioNode node = ring.nodes[n];
+            node.esp_id = "esp32_" + std::to_string(z * ring.nodes.size() + n + 1);
+            node.zone = "zone_" + std::to_string(z + 1);
+            for (ScenarioSensor& sensor : node.sensors) {
+                sensor.position = {sensor.position.x - ring_center.x + center.x, sensor.position.y - ring_center.y + center.y};
+            }
+            config.nodes.push_back(std::move(node));
+        }
+        ScenarioDrone drone;
+        drone.waypoints = {{center.x - 2.0, center.y - 2.0}, {center.x + 2.0, center.y - 2.0},
+                           {center.x + 2.0, center.y + 2.0}, {center.x - 2.0, center.y + 2.0}};
+        config.drones.push_back(drone);
+    }
+    return config;
+}
+
+// The areas ZonedTracker derives, bounding box of the sensors grown by the margin.
+std::vector<ZoneConfig> with_areas(std::vector<ZoneConfig> zones) {
+    for (ZoneConfig& zone : zones) {
+        zone.area_min = zone.area_max = zone.sensor_positions.begin()->second;
+        for (const auto& pair : zone.sensor_positions) {
+            zone.area_min = {std::min(zone.area_min.x, pair.second.x), std::min(zone.area_min.y, pair.second.y)};
+            zone.area_max = {std::max(zone.area_max.x, pair.second.x), std::max(zone.area_max.y, pair.second.y)};
+        }
+        zone.area_min = {zone.area_min.x - zone.margin_m, zone.area_min.y - zone.margin_m};
+        zone.area_max = {zone.area_max.x + zone.margin_m, zone.area_max.y + zone.margin_m};
+    }
+    return zones;
+}
+
+struct RunResult {
+    double rate;
+    size_t fixes;
+    double p50;
+    double inaccurate;
+    double right_zone;
+    uint64_t handed_off;
+};
+
+// rate in msg/s, 0 floods.
+RunResult run(const ScenarioConfig& config, const std::vector<ZoneConfig>& zones, size_t count, double rate) {
+    ScenarioGenerator generator(config);
+
+    g_scoring.generator = &generator;
+    g_scoring.zones = with_areas(zones);
+    g_scoring.received = std::make_unique<IngestClock::time_point[]>(count);
+    g_scoring.sim_time = std::make_unique<double[]>(count);
+    g_scoring.errors = std::make_unique<double[]>(count);
+    g_scoring.capacity = count;
+    g_scoring.routed = 0;
+    g_scoring.fixes = 0;
+    g_scoring.accurate = 0;
+    g_scoring.right_zone = 0;
+    g_processed = 0;
+
+    SensorRegistry registry;
+    ZonedTracker tracker(zones, registry);
+    WorkStealingExecutor executor;
+    RangeFilterConfig filter;
+    filter.require_presence = true;
+    filter.hampel = true;
+    IngestRouter router("drones/data", registry, tracker, executor, {}, filter);
+
+    size_t sent = 0;
+    auto start = IngestClock::now();
+    IngestMessage msg;
+    const auto period = std::chrono::duration<double>(rate > 0.0 ? 1.0 / rate : 0.0);
+    while (sent < count && generator.next(msg)) {
+        if (rate > 0.0) {
+            const auto due = start + std::chrono::duration_cast<IngestClock::duration>(period * static_cast<double>(sent));
+            while (IngestClock::now() < due) {
+                std::this_thread::yield();
+            }
+        }
+        msg.received_at = IngestClock::now();
+        g_scoring.received[sent] = msg.received_at;
+        g_scoring.sim_time[sent] = generator.time_s();
+        g_scoring.routed.store(sent + 1, std::memory_order_release);
+        router.route(std::move(msg));
+        msg = IngestMessage{};
+        ++sent;
+    }
+    while (g_processed.load(std::memory_order_acquire) < sent) {
+        std::this_thread::yield();
+    }
+    const double elapsed = std::chrono::duration<double>(IngestClock::now() - start).count();
+    router.clear();
+
+    RunResult result{static_cast<double>(sent) / elapsed, std::min(g_scoring.fixes.load(), count), 0.0, 0.0, 0.0, 0};
+    if (result.fixes > 0) {
+        double* errors = g_scoring.errors.get();
+        std::sort(errors, errors + result.fixes);
+        result.p50 = errors[result.fixes / 2];
+        const double accurate = static_cast<double>(g_scoring.accurate.load());
+        result.inaccurate = 1.0 - accurate / static_cast<double>(g_scoring.fixes.load());
+        result.right_zone = accurate > 0.0 ? static_cast<double>(g_scoring.right_zone.load()) / accurate : 0.0;
+    }
+    for (size_t z = 0; z < tracker.zone_count(); ++z) result.handed_off += tracker.handed_off(z);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    const size_t paced = std::min<size_t>(count, 100000);
+
+    std::printf("separate sites %.0f m apart, 8 radars and 1 drone each\n", SITE_SPACING);
+    std::printf("%-6s %-10s %14s %12s %12s\n", "sites", "trackers", "flood msg/s", "paced fixes", "err p50 m");
+    for (size_t n : {1, 2, 4, 8}) {
+        const ScenarioConfig config = sites(n, SITE_SPACING);
+        const std::vector<ZoneConfig> one = {ZoneConfig{"all", config.sensor_positions()}};
+        for (bool zoned : {false, true}) {
+            if (n == 1 && zoned) continue;
+            const std::vector<ZoneConfig>& zones = zoned ? config.zones() : one;
+            const RunResult flood = run(config, zones, count, 0.0);
+            const RunResult r = run(config, zones, paced, PACED_RATE);
+            std::printf("%-6zu %-10s %14.0f %12zu %12.3f\n", n, zoned ? "per zone" : "one", flood.rate, r.fixes, r.p50);
+            if ((zoned || n == 1) && (r.fixes == 0 || r.p50 > 0.5)) {
+                std::printf("CHECK FAILED: %zu sites located to %.3f m at p50\n", n, r.p50);
+                return 1;
+            }
+        }
+    }
+
+    ScenarioConfig crossing = sites(2, CROSSING_SPACING);
+    crossing.drones = {ScenarioDrone{{{0.0, 0.5}, {CROSSING_SPACING, 0.5}}, false, 2.0}};
+    const RunResult r = run(crossing, crossing.zones(), paced, PACED_RATE);
+    std::printf("\ntwo zones %.0f m apart, one drone flying between their centers\n", CROSSING_SPACING);
+    std::printf("fixes: %zu, err p50: %.3f m, off by more than %.0f m: %.1f %%, handed off: %llu\n", r.fixes, r.p50,
+                ACCURATE_M, r.inaccurate * 100.0, static_cast<unsigned long long>(r.handed_off));
+    std::printf("accurate fixes reported in the drone's zone: %.1f %%\n", r.right_zone * 100.0);
+    if (r.handed_off == 0 || r.right_zone < 0.9) {
+        std::printf("CHECK FAILED: handoff between neighbouring zones\n");
+        return 1;
+    }
+    return 0;
+}
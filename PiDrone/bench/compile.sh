@@ -0,0 +1,65 @@
+#!/bin/bash
+
+echo "--- Compiling Drone Tracker benchmarks ---"
+
+cd "$(dirname "$0")"
+
+TRACKER_SRCS="../DroneTracker.cpp ../Trilateration.cpp ../Multilateration.cpp ../SensorRegistry.cpp ../Epoch.cpp ../SubsetGrid.cpp"
+PIPELINE_SRCS="$TRACKER_SRCS ../ZonedTracker.cpp ../NodeManager.cpp ../RangeFilter.cpp ../Metrics.cpp ../WorkStealingExecutor.cpp ../ParticleFilter.cpp ../BatchMultilateration.cpp"
+
+build() {
+    local name=$1
+    shift
+    g++ -std=c++17 -O2 "$name.cpp" "$@" -o "$name" -I/usr/include/nlohmann -pthread
+    if [ $? -ne 0 ]; then
+        echo "--- Compilation of $name Failed! ---"
+        exit 1
+    fi
+}
+
+build bench_executor $PIPELINE_SRCS
+build bench_tracker_contention $TRACKER_SRCS
+build bench_batch_multilateration $TRACKER_SRCS ../BatchMultilateration.cpp
+build bench_track_filter ../TrackFilter.cpp
+build bench_multi_target ../MultiTargetTracker.cpp ../Assignment.cpp
+build bench_payload_decode
+build bench_sensor_json
+build bench_batch_frame -Iarduino_shim
+build bench_logging $PIPELINE_SRCS ../AsyncLogger.cpp
+build bench_journal $PIPELINE_SRCS ../IngestRouter.cpp ../Journal.cpp ../JournalIngestSource.cpp
+build bench_sensor_history
+build bench_range_filter $TRACKER_SRCS ../RangeFilter.cpp
+build bench_metrics $PIPELINE_SRCS ../IngestRouter.cpp
+build bench_micro $TRACKER_SRCS ../RangeFilter.cpp
+build bench_pipeline $PIPELINE_SRCS ../IngestRouter.cpp
+build bench_scenario $PIPELINE_SRCS ../IngestRouter.cpp ../ScenarioGenerator.cpp
+build bench_overload $PIPELINE_SRCS ../IngestRouter.cpp
+build bench_router $PIPELINE_SRCS ../IngestRouter.cpp
+build bench_zones $PIPELINE_SRCS ../IngestRouter.cpp ../ScenarioGenerator.cpp
+build bench_reload $TRACKER_SRCS ../ZonedTracker.cpp
+build bench_gdop $PIPELINE_SRCS ../IngestRouter.cpp ../ScenarioGenerator.cpp
+build bench_particles $TRACKER_SRCS ../RangeFilter.cpp ../ParticleFilter.cpp ../BatchMultilateration.cpp ../TrackFilter.cpp
+
+echo "--- Compiled Succesfully! ---"
+echo "Run with : ./bench_executor [total_messages] [max_nodes]"
+echo "           ./bench_tracker_contention [updates_per_thread] [max_threads]"
+echo "           ./bench_batch_multilateration [epochs] [sensors]"
+echo "           ./bench_track_filter [fixes] [fix_rate_hz]"
+echo "           ./bench_multi_target [scans] [max_targets]"
+echo "           ./bench_payload_decode [messages]"
+echo "           ./bench_sensor_json [messages] [mutations]"
+echo "           ./bench_batch_frame [cycles] [sensors]"
+echo "           ./bench_logging [messages] [log_path]"
+echo "           ./bench_journal [messages] [journal_path]"
+echo "           ./bench_sensor_history [readings]"
+echo "           ./bench_range_filter [epochs]"
+echo "           ./bench_metrics [messages]"
+echo "           ./bench_micro [calls_per_function]"
+echo "           ./bench_pipeline [nodes] [sensors_per_node] [messages] [rate_msg_per_s] [json|binary]"
+echo "           ./bench_scenario [messages]"
+echo "           ./bench_overload [messages] [work_us]"
+echo "           ./bench_router [messages_per_thread] [nodes]"
+echo "           ./bench_zones [messages]"
+echo "           ./bench_reload [updates_per_thread]"
+echo "           ./bench_gdop [messages]"
+echo "           ./bench_particles [particle_updates_per_row] [seconds_simulated]"
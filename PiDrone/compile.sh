@@ -5,15 +5,55 @@ echo "--- Compiling Drone Tracker (Pi Portion) ---"
 g++ -std=c++17 \
     main.cpp \
     NodeManager.cpp \
+    RangeFilter.cpp \
+    Metrics.cpp \
+    WorkStealingExecutor.cpp \
     DroneTracker.cpp \
+    ZonedTracker.cpp \
+    Epoch.cpp \
+    GeometryWatcher.cpp \
+    SubsetGrid.cpp \
+    ParticleFilter.cpp \
     Trilateration.cpp \
+    Multilateration.cpp \
+    BatchMultilateration.cpp \
+    TrackFilter.cpp \
+    MultiTargetTracker.cpp \
+    Assignment.cpp \
+    AsyncLogger.cpp \
+    SensorRegistry.cpp \
+    IngestRouter.cpp \
+    PahoIngestSource.cpp \
+    ReplayIngestSource.cpp \
+    JournalIngestSource.cpp \
+    Journal.cpp \
+    GeneratorIngestSource.cpp \
+    ScenarioGenerator.cpp \
+    ScenarioIngestSource.cpp \
     -o drone_tracker \
     -I/usr/include/nlohmann \
     -lpaho-mqttpp3 -lpaho-mqtt3as -pthread
 
+if [ $? -ne 0 ]; then
+    echo "--- Compilation Failed! ---"
+    exit 1
+fi
+
+echo "--- Compiling Scenario Generator ---"
+
+g++ -std=c++17 \
+    scenario_gen.cpp \
+    ScenarioGenerator.cpp \
+    ScenarioIngestSource.cpp \
+    Journal.cpp \
+    -o scenario_gen \
+    -I/usr/include/nlohmann \
+    -lpaho-mqttpp3 -lpaho-mqtt3as -pthread
+
 if [ $? -eq 0 ]; then
     echo "--- Compiled Succesfully! ---"
     echo "Run with : ./drone_tracker"
+    echo "           ./scenario_gen --ring 4 2 1 --broker tcp://localhost:1883"
 else
     echo "--- Compilation Failed! ---"
 fi
\ No newline at end of file
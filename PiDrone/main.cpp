@@ -1,133 +1,437 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <map>
 #include <chrono>
 #include <iomanip>
+#include <fstream>
 #include <memory>
 #include <csignal>
-#include "mqtt/async_client.h"
+#include <atomic>
+#include <thread>
+#include <pthread.h>
+#include <cstdlib>
+#include "ConsoleColors.h"
+#include "AsyncLogger.h"
+#include "PahoIngestSource.h"
+#include "JournalIngestSource.h"
+#include "ScenarioIngestSource.h"
+#include "Journal.h"
+#include "Metrics.h"
+#include "IngestRouter.h"
 #include "NodeManager.h"
-#include "DroneTracker.h"
+#include "WorkStealingExecutor.h"
+#include "ZonedTracker.h"
+#include "GeometryWatcher.h"
+#include "TrackFilter.h"
+#include "ParticleFilter.h"
+#include "MultiTargetTracker.h"
+#include "SensorRegistry.h"
 
 const std::string MQTT_SERVER   = ""; // IP of your pi
 const int         MQTT_PORT     = 1883;
 const std::string MQTT_BASE_TOPIC = "drones/data";
 const std::string MQTT_SUB_TOPIC  = MQTT_BASE_TOPIC + "/+/+";
 const int         QOS           = 1;
+const double      TRACK_OUTPUT_HZ = 10.0;
+const double      TARGET_SCAN_HZ  = 10.0;
+// Console output is written by a background thread, these caps keep a busy room from flooding the terminal.
+const LogFormat   LOG_FORMAT      = LogFormat::Text;
+const uint32_t    LOG_SENSOR_MAX_PER_S   = 200;
+const uint32_t    LOG_LOCATION_MAX_PER_S = 200;
+// Ranges are screened per sensor before they reach the solver, see RangeFilter.h.
+const bool           RANGE_REQUIRE_PRESENCE = true;
+const bool           RANGE_HAMPEL           = true;
+const RangeSmoothing RANGE_SMOOTHING        = RangeSmoothing::None;
+// Fixes use the sensors with the best geometry for where the drone is, see SubsetGrid.h.
+// A radar farther than its reach is never used, nor one that has not reported for a while.
+const bool           SUBSET_GRID            = true;
+const double         RADAR_MAX_RANGE_M      = 12.0;
+const double         SENSOR_STALE_AFTER_S   = 2.0;
+// --particles runs a ParticleFilter on the raw ranges next to the fixes, on this many threads (0 one per core).
+const size_t         PARTICLE_THREADS       = 0;
+// Live, a stalled worker should skip to each sensor's newest range rather than hold up every node.
+// Replays and simulations run flat out and must not lose anything, they block instead.
+const OverloadPolicy LIVE_OVERLOAD_POLICY = OverloadPolicy::LatestPerSensor;
+const size_t         NODE_QUEUE_CAPACITY  = 4096;
+// How often --metrics rewrites its Prometheus text file. Timing a message costs about 0.2 us,
+// nothing at sensor rates, time only every Nth message when replaying or generating floods.
+const auto        METRICS_EXPORT_INTERVAL = std::chrono::seconds(5);
+const uint32_t    METRICS_SAMPLE_EVERY    = 1;
+// How often --simulate writes the true drone positions to --truth, in simulated time.
+const double      TRUTH_HZ                = 10.0;
+// Sensor positions, measured in meters between your esp32s, see ZonedTracker.h for the format.
+// Edits are picked up while running within one poll interval, or right away on SIGHUP.
+const std::string DEFAULT_ZONES_PATH      = "sensors.json";
+const auto        GEOMETRY_POLL_INTERVAL  = std::chrono::seconds(1);
 
-const std::string FORE_GREEN    = "\033[32m";
-const std::string FORE_YELLOW   = "\033[33m";
-const std::string FORE_CYAN     = "\033[36m";
-const std::string FORE_RED      = "\033[31m";
-const std::string STYLE_BRIGHT  = "\033[1m";
-const std::string STYLE_RESET   = "\033[0m";
+// Declared first so it is destroyed last, everything below may still log while shutting down.
+std::unique_ptr<AsyncLogger> g_log;
+std::unique_ptr<JournalWriter> g_journal;
+std::unique_ptr<std::ofstream> g_truth;
+std::unique_ptr<IngestSource> g_source;
+// Declared before the router so it outlives the NodeManagers feeding it.
+std::unique_ptr<ParticleFilter> g_particles;
+std::unique_ptr<IngestRouter> g_router;
+// One track filter and one target tracker per zone, indexed by Fix::zone.
+std::vector<std::unique_ptr<TrackFilter>> g_track_filters;
+std::vector<std::unique_ptr<MultiTargetTracker>> g_targets;
+std::unique_ptr<GeometryWatcher> g_geometry;
+// Only filled when the site has more than one zone, fixes and tracks are then logged with their zone.
+std::vector<std::string> g_zone_names;
 
-std::unique_ptr<mqtt::async_client> g_client;
-std::map<std::string, std::unique_ptr<NodeManager>> g_node_managers;
-std::mutex g_map_mutex;
+const char* zone_name(size_t zone) {
+    return zone < g_zone_names.size() ? g_zone_names[zone].c_str() : "";
+}
+
+// The particle filter does not care about zones, it tracks over the whole site.
+std::map<std::string, Point> all_sensor_positions(const std::vector<ZoneConfig>& zones) {
+    std::map<std::string, Point> positions;
+    for (const ZoneConfig& zone : zones) positions.insert(zone.sensor_positions.begin(), zone.sensor_positions.end());
+    return positions;
+}
 
 void process_sensor_update(const std::string& esp_id, const TrackedSensor& sensor) {
-    SensorData latest = sensor.getLatestData();
-    std::cout << FORE_CYAN << "UPDATE | ESP: " << std::left << std::setw(10) << esp_id
-              << " | Sensor: " << std::left << std::setw(9) << sensor.getId()
-              << std::fixed << std::setprecision(2)
-              << " | Range: " << std::setw(6) << latest.range << " m"
-              << " | Speed: " << std::setw(5) << latest.speed << " m/s"
-              << STYLE_RESET << std::endl;
+    const SensorData& latest = sensor.getLatestData();
+    g_log->log(LogCategory::Sensor, LogKind::SensorUpdate, [&](LogRecord& r) {
+        r.set_text(esp_id, sensor.getId());
+        r.values[0] = latest.range;
+        r.values[1] = latest.speed;
+    });
 }
 
-void process_drone_location(const Point& drone_pos) {
-    std::cout << STYLE_BRIGHT << FORE_GREEN << ">>>>>> LOCATION (X,Y): (" 
-              << std::fixed << std::setprecision(2) << std::setw(6) << drone_pos.x << ", " 
-              << std::setw(6) << drone_pos.y << ")"
-              << STYLE_RESET << std::endl;
+void process_drone_location(const Fix& fix, IngestClock::time_point received_at) {
+    if (fix.zone < g_track_filters.size()) {
+        // A fix handed off to a neighbouring zone brings the drone's track along, unless that zone already has one.
+        if (fix.source_zone != fix.zone && fix.source_zone < g_track_filters.size()) {
+            g_track_filters[fix.source_zone]->hand_over(*g_track_filters[fix.zone], received_at);
+            g_targets[fix.source_zone]->hand_over(fix.position, *g_targets[fix.zone]);
+        }
+        g_track_filters[fix.zone]->update(fix, received_at);
+        g_targets[fix.zone]->add_fix(fix);
+    }
+    g_log->log(LogCategory::Location, LogKind::Location, [&](LogRecord& r) {
+        r.values[0] = fix.position.x;
+        r.values[1] = fix.position.y;
+        r.values[2] = fix.residual_rms;
+        r.values[3] = fix.condition_number;
+        r.count = static_cast<uint32_t>(fix.sensors_used);
+        r.set_text(zone_name(fix.zone));
+    });
 }
 
-class callback : public virtual mqtt::callback {
-    DroneTracker& tracker_;
+void process_track_state(size_t zone, const TrackState& track) {
+    // The particle filter has no output thread of its own, it is logged at the first zone's track rate.
+    if (g_particles && zone == 0) {
+        const ParticleEstimate estimate = g_particles->estimate();
+        if (estimate.valid) {
+            g_log->log(LogCategory::Track, LogKind::Track, [&](LogRecord& r) {
+                r.values[0] = estimate.position.x;
+                r.values[1] = estimate.position.y;
+                r.values[2] = estimate.velocity.x;
+                r.values[3] = estimate.velocity.y;
+                r.values[4] = estimate.position_sigma;
+                r.set_text("particles");
+            });
+        }
+    }
+    if (!track.valid) return;
+    g_log->log(LogCategory::Track, LogKind::Track, [&](LogRecord& r) {
+        r.values[0] = track.position.x;
+        r.values[1] = track.position.y;
+        r.values[2] = track.velocity.x;
+        r.values[3] = track.velocity.y;
+        r.values[4] = track.position_sigma;
+        if (zone < g_zone_names.size()) r.set_text("", g_zone_names[zone]);
+    });
+}
 
-public:
-    callback(DroneTracker& tracker) : tracker_(tracker) {}
+void process_target_event(size_t zone, const TargetState& target) {
+    g_log->log(LogCategory::Target, LogKind::TargetEvent, [&](LogRecord& r) {
+        r.flag = target.status == TrackStatus::Confirmed;
+        r.id = target.id;
+        r.values[0] = target.position.x;
+        r.values[1] = target.position.y;
+        r.count = target.hits;
+        r.set_text(zone_name(zone));
+    });
+}
 
-    void connection_lost(const std::string& cause) override {
-        std::cerr << FORE_RED << "\n---> Connection lost: " << cause << std::endl;
-        exit(1);
+/**
+    * @brief Takes SIGINT, SIGTERM and SIGHUP on a thread of its own instead of in a handler.
+    *
+    * They are blocked in every other thread, so this runs as ordinary code and
+    * may print and lock. A stop signal only stops the source, main's join()
+    * then tears the pipeline down once nothing is routing any more. Returns
+    * on the first stop signal, main sends one itself when it is done.
+*/
+void signal_loop(sigset_t signals, const std::atomic<bool>& exiting) {
+    while (true) {
+        int signum = 0;
+        if (sigwait(&signals, &signum) != 0) continue;
+        if (signum == SIGHUP) {
+            if (g_geometry) g_geometry->request_reload();
+            continue;
+        }
+        if (!exiting.load()) std::cout << "\nCaught signal, shutting down..." << std::endl;
+        g_source->stop();
+        return;
     }
+}
 
-    void connected(const std::string& cause) override {
-        std::cout << FORE_CYAN << "---> Successfully connected to MQTT Broker." << STYLE_RESET << std::endl;
-        g_client->subscribe(MQTT_SUB_TOPIC, QOS);
-        std::cout << FORE_CYAN << "---> Subscribed to '" << MQTT_SUB_TOPIC << "'. Waiting for data..." << STYLE_RESET << std::endl;
-    }
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [--journal <path>] [--replay <path> | --simulate <path> [--truth <path>]] [--speed <x>] [--zones <path>] [--metrics <path>] [--particles <n>]\n"
+              << "  --journal <path>  record every received message to a journal file\n"
+              << "  --replay <path>   read messages from a journal instead of the MQTT broker\n"
+              << "  --simulate <path> feed the pipeline from a simulated site, see ScenarioGenerator.h\n"
+              << "  --truth <path>    with --simulate, write the true drone positions as CSV, t_s,drone,x,y\n"
+              << "  --speed <x>       replay or simulate at x times the recorded pace, 0 as fast as possible (default 1)\n"
+              << "  --zones <path>    sensor positions grouped into zones, see ZonedTracker.h (default " << DEFAULT_ZONES_PATH << "),\n"
+              << "                    reloaded when the file changes or on SIGHUP\n"
+              << "  --metrics <path>  record stage latencies and counters, written to path in Prometheus text format\n"
+              << "  --particles <n>   also track with a particle filter of n particles fed the raw ranges, see ParticleFilter.h" << std::endl;
+}
 
-    void message_arrived(mqtt::const_message_ptr msg) override {
-        try {
-            std::string topic = msg->get_topic();
-            if (topic.find(MQTT_BASE_TOPIC) != 0) return;
+int main(int argc, char* argv[]) {
+    // Before any thread is started, they all inherit the mask, see signal_loop().
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
 
-            std::string topic_path = topic.substr(MQTT_BASE_TOPIC.length() + 1);
-            size_t first_slash = topic_path.find('/');
-            if (first_slash == std::string::npos) return;
-            
-            std::string esp_id = topic_path.substr(0, first_slash);
+    std::string journal_path, replay_path, metrics_path, scenario_path, truth_path, zones_path;
+    double replay_speed = 1.0;
+    size_t particle_count = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--journal" && i + 1 < argc) journal_path = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc) replay_path = argv[++i];
+        else if (arg == "--speed" && i + 1 < argc) replay_speed = std::atof(argv[++i]);
+        else if (arg == "--metrics" && i + 1 < argc) metrics_path = argv[++i];
+        else if (arg == "--simulate" && i + 1 < argc) scenario_path = argv[++i];
+        else if (arg == "--truth" && i + 1 < argc) truth_path = argv[++i];
+        else if (arg == "--zones" && i + 1 < argc) zones_path = argv[++i];
+        else if (arg == "--particles" && i + 1 < argc) particle_count = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if ((!replay_path.empty() && !scenario_path.empty()) || (!truth_path.empty() && scenario_path.empty())) {
+        print_usage(argv[0]);
+        return 1;
+    }
 
-            std::lock_guard<std::mutex> lock(g_map_mutex);
-            if (g_node_managers.find(esp_id) == g_node_managers.end()) {
-                std::cout << STYLE_BRIGHT << FORE_YELLOW << "--> Discovered new ESP node: " << esp_id << STYLE_RESET << std::endl;
-                g_node_managers[esp_id] = std::make_unique<NodeManager>(esp_id, tracker_);
-            }
-            g_node_managers[esp_id]->add_message(msg);
+    std::cout << "--- Multi-Sensor Drone Tracker Initializing ---" << std::endl;
 
-        } catch (const std::exception& e) {
-            std::cerr << FORE_RED << "[ERROR] in message_arrived: " << e.what() << STYLE_RESET << std::endl;
+    AsyncLoggerConfig log_config;
+    log_config.format = LOG_FORMAT;
+    log_config.limits[static_cast<size_t>(LogCategory::Sensor)].max_per_second = LOG_SENSOR_MAX_PER_S;
+    log_config.limits[static_cast<size_t>(LogCategory::Location)].max_per_second = LOG_LOCATION_MAX_PER_S;
+    g_log = std::make_unique<AsyncLogger>(log_config);
+
+    // A simulated site brings its own layout, a zones file given as well wins.
+    if (zones_path.empty() && scenario_path.empty()) zones_path = DEFAULT_ZONES_PATH;
+    std::vector<ZoneConfig> zones;
+    ScenarioConfig scenario;
+    try {
+        if (!scenario_path.empty()) {
+            scenario = load_scenario(scenario_path);
+            zones = scenario.zones();
         }
+        if (!zones_path.empty()) zones = load_zones(zones_path);
+    } catch (const std::runtime_error& e) {
+        std::cerr << FORE_RED << "---> CRITICAL: " << e.what() << STYLE_RESET << std::endl;
+        return 1;
+    }
+    for (const ZoneConfig& zone : zones) {
+        std::cout << "---> " << zone.sensor_positions.size() << " sensor positions loaded for trilateration in zone " << zone.name << "." << std::endl;
+    }
+    if (zones.size() > 1) {
+        for (const ZoneConfig& zone : zones) g_zone_names.push_back(zone.name);
     }
-};
 
-void signal_handler(int signum) {
-    std::cout << "\nCaught signal, shutting down..." << std::endl;
-    g_node_managers.clear();
-    if (g_client && g_client->is_connected()) {
-        g_client->disconnect()->wait();
+    SubsetSelectionConfig selection;
+    selection.grid = SUBSET_GRID;
+    selection.max_range_m = scenario_path.empty() ? RADAR_MAX_RANGE_M : scenario.max_range_m;
+    // Replayed and simulated messages arrive speed times faster than they were sent, or all at once.
+    selection.stale_after_s = SENSOR_STALE_AFTER_S;
+    if (!replay_path.empty() || !scenario_path.empty()) {
+        selection.stale_after_s = replay_speed > 0.0 ? SENSOR_STALE_AFTER_S / replay_speed : 0.0;
     }
-    exit(signum);
-}
 
-int main(int argc, char* argv[]) {
-    signal(SIGINT, signal_handler);
-    signal(SIGTERM, signal_handler);
+    SensorRegistry registry;
+    std::unique_ptr<ZonedTracker> tracker;
+    try {
+        tracker = std::make_unique<ZonedTracker>(zones, registry, selection);
+        if (particle_count > 0) {
+            ParticleFilterConfig particles;
+            particles.particles = particle_count;
+            particles.threads = PARTICLE_THREADS;
+            particles.max_range_m = selection.max_range_m;
+            if (!scenario_path.empty()) particles.min_range_m = scenario.min_range_m;
+            g_particles = std::make_unique<ParticleFilter>(all_sensor_positions(zones), registry, particles);
+            std::cout << "---> Particle filter of " << g_particles->particles() << " particles on "
+                      << g_particles->threads() << " threads." << std::endl;
+        }
+    } catch (const std::runtime_error& e) {
+        std::cerr << FORE_RED << "---> CRITICAL: " << e.what() << STYLE_RESET << std::endl;
+        return 1;
+    }
+    if (!zones_path.empty()) {
+        g_geometry = std::make_unique<GeometryWatcher>(zones_path, *tracker, registry,
+            [&registry](const std::vector<ZoneConfig>& reloaded, const std::string& error) {
+                if (!error.empty()) {
+                    std::cerr << FORE_RED << "---> Keeping the current sensor positions: " << error << STYLE_RESET << std::endl;
+                    return;
+                }
+                size_t sensors = 0;
+                for (const ZoneConfig& zone : reloaded) sensors += zone.sensor_positions.size();
+                if (g_particles) g_particles->set_sensors(all_sensor_positions(reloaded), registry);
+                std::cout << STYLE_BRIGHT << FORE_YELLOW << "--> Reloaded " << sensors << " sensor positions." << STYLE_RESET << std::endl;
+            });
+        g_geometry->start(GEOMETRY_POLL_INTERVAL);
+        std::cout << "---> Watching " << zones_path << " for new sensor positions." << std::endl;
+    }
+    for (size_t zone = 0; zone < tracker->zone_count(); ++zone) {
+        g_track_filters.push_back(std::make_unique<TrackFilter>());
+        // Interleaved ids, a target keeps its id when it is handed to another zone.
+        MultiTargetConfig targets;
+        targets.first_id = static_cast<uint32_t>(zone + 1);
+        targets.id_stride = static_cast<uint32_t>(tracker->zone_count());
+        g_targets.push_back(std::make_unique<MultiTargetTracker>(targets, [zone](const TargetState& target) {
+            process_target_event(zone, target);
+        }));
+    }
+    WorkStealingExecutor executor;
+    std::cout << "---> Processing nodes on " << executor.size() << " worker threads." << std::endl;
 
-    std::cout << "--- Multi-Sensor Drone Tracker Initializing ---" << std::endl;
+    RangeFilterConfig range_filter;
+    range_filter.require_presence = RANGE_REQUIRE_PRESENCE;
+    range_filter.hampel = RANGE_HAMPEL;
+    range_filter.smoothing = RANGE_SMOOTHING;
+    NodeQueueConfig queue_config;
+    queue_config.capacity = NODE_QUEUE_CAPACITY;
+    if (replay_path.empty() && scenario_path.empty()) queue_config.policy = LIVE_OVERLOAD_POLICY;
+    g_router = std::make_unique<IngestRouter>(MQTT_BASE_TOPIC, registry, *tracker, executor, [](const std::string& esp_id) {
+        std::cout << STYLE_BRIGHT << FORE_YELLOW << "--> Discovered new ESP node: " << esp_id << STYLE_RESET << std::endl;
+    }, range_filter, queue_config, g_particles.get());
 
-    // Define sensor positions here, This is dependant on your room layout / each person. You need to measure the distance in meters between your esp32s
-    std::map<std::string, Point> sensor_positions = {
-        {"esp32_1/radar_A", {0.0, 0.0}},
-        {"esp32_2/radar_A", {5.0, 0.0}},
-        {"esp32_3/radar_A", {2.5, 4.33}}
-    };
-    std::cout << "---> " << sensor_positions.size() << " sensor positions loaded for trilateration." << std::endl;
-
-    DroneTracker tracker(sensor_positions);
-    
-    std::string server_address = "tcp://" + MQTT_SERVER + ":" + std::to_string(MQTT_PORT);
-    g_client = std::make_unique<mqtt::async_client>(server_address, "drone_tracker_client");
-    
-    callback cb(tracker);
-    g_client->set_callback(cb);
-
-    mqtt::connect_options conn_opts;
-    conn_opts.set_clean_session(true);
+    IngestHandler handler = g_router->handler();
+    try {
+        if (!journal_path.empty()) {
+            g_journal = std::make_unique<JournalWriter>(journal_path);
+            std::cout << "---> Recording received messages to " << journal_path << std::endl;
+            handler = [](IngestMessage&& msg) {
+                g_journal->append(msg);
+                g_router->route(std::move(msg));
+            };
+        }
+        if (!replay_path.empty()) {
+            g_source = std::make_unique<JournalIngestSource>(replay_path, replay_speed);
+            std::cout << "---> Replaying " << replay_path << " at " << (replay_speed > 0.0 ? std::to_string(replay_speed) + "x" : "full speed") << std::endl;
+        }
+        if (!scenario_path.empty()) {
+            ScenarioIngestSource::TruthHandler on_truth;
+            if (!truth_path.empty()) {
+                g_truth = std::make_unique<std::ofstream>(truth_path);
+                if (!*g_truth) throw std::runtime_error("Cannot create " + truth_path);
+                *g_truth << "t_s,drone,x,y\n";
+                on_truth = [](double t, size_t drone, const Point& p) {
+                    *g_truth << t << ',' << drone << ',' << p.x << ',' << p.y << '\n';
+                };
+            }
+            g_source = std::make_unique<ScenarioIngestSource>(scenario, replay_speed, on_truth, TRUTH_HZ);
+            std::cout << "---> Simulating " << scenario_path << " at " << (replay_speed > 0.0 ? std::to_string(replay_speed) + "x" : "full speed") << std::endl;
+        }
+    } catch (const std::runtime_error& e) {
+        std::cerr << FORE_RED << "---> CRITICAL: " << e.what() << STYLE_RESET << std::endl;
+        return 1;
+    }
+    PahoIngestSource* broker = nullptr;
+    if (!g_source) {
+        std::string server_address = "tcp://" + MQTT_SERVER + ":" + std::to_string(MQTT_PORT);
+        auto paho = std::make_unique<PahoIngestSource>(server_address, "drone_tracker_client", MQTT_SUB_TOPIC, QOS);
+        broker = paho.get();
+        g_source = std::move(paho);
+    }
+
+    if (!metrics_path.empty()) {
+        PipelineMetrics& metrics = pipeline_metrics();
+        metrics.add_series({"pidrone_queued_messages", "Messages waiting in the NodeManager queues.", "gauge",
+                            [] { return static_cast<double>(g_router->queued()); }});
+        metrics.add_series({"pidrone_dropped_messages_total", "Messages evicted from a full NodeManager queue.", "counter",
+                            [] { return static_cast<double>(g_router->dropped()); }});
+        metrics.add_series({"pidrone_coalesced_messages_total", "Readings overwritten by a newer one of the same sensor before processing.",
+                            "counter", [] { return static_cast<double>(g_router->coalesced()); }});
+        metrics.add_series({"pidrone_log_dropped_total", "Log records dropped because the log ring was full.", "counter",
+                            [] { return static_cast<double>(g_log->dropped()); }});
+        if (tracker->zone_count() > 1) {
+            metrics.add_series({"pidrone_zone_handoffs_total", "Fixes solved by one zone and handed off to a neighbouring one.",
+                                "counter", [zoned = tracker.get()] {
+                                    uint64_t total = 0;
+                                    for (size_t z = 0; z < zoned->zone_count(); ++z) total += zoned->handed_off(z);
+                                    return static_cast<double>(total);
+                                }});
+        }
+        if (g_geometry) {
+            metrics.add_series({"pidrone_geometry_reloads_total", "Changes of the zones file applied while running.",
+                                "counter", [] { return static_cast<double>(g_geometry->reloads()); }});
+            metrics.add_series({"pidrone_geometry_reload_failures_total", "Changes of the zones file rejected as unreadable or invalid.",
+                                "counter", [] { return static_cast<double>(g_geometry->failures()); }});
+        }
+        if (broker) {
+            metrics.add_series({"pidrone_ingest_errors_total", "Broker messages dropped because handling them threw.",
+                                "counter", [broker] { return static_cast<double>(broker->handler_errors()); }});
+        }
+        if (g_journal) {
+            metrics.add_series({"pidrone_journal_dropped_total", "Messages not journaled because the disk fell behind.",
+                                "counter", [] { return static_cast<double>(g_journal->dropped()); }});
+        }
+        metrics.set_sample_every(METRICS_SAMPLE_EVERY);
+        metrics.enable(true);
+        metrics.start_export(metrics_path, METRICS_EXPORT_INTERVAL);
+        std::cout << "---> Writing pipeline metrics to " << metrics_path << std::endl;
+    }
 
+    for (size_t zone = 0; zone < g_track_filters.size(); ++zone) {
+        g_track_filters[zone]->start_output(TRACK_OUTPUT_HZ, [zone](const TrackState& track) { process_track_state(zone, track); });
+        g_targets[zone]->start_scans(TARGET_SCAN_HZ);
+    }
+
+    std::atomic<bool> exiting{false};
+    std::thread signal_thread(signal_loop, signals, std::cref(exiting));
     try {
-        g_client->connect(conn_opts)->wait();
+        g_source->start(std::move(handler));
     } catch (const mqtt::exception& exc) {
         std::cerr << FORE_RED << "---> CRITICAL: Could not connect to " << MQTT_SERVER << ". Error: " << exc.what() << STYLE_RESET << std::endl;
+        exiting = true;
+        pthread_kill(signal_thread.native_handle(), SIGTERM);
+        signal_thread.join();
         return 1;
     }
 
-    while (true) {
-        std::this_thread::sleep_for(std::chrono::hours(1));
+    // Blocks until the broker connection is lost, the replay is done or a signal stopped the source,
+    // ingest runs on the source's thread.
+    bool ok = g_source->join();
+    exiting = true;
+    pthread_kill(signal_thread.native_handle(), SIGTERM);
+    signal_thread.join();
+    if (g_geometry) g_geometry->stop();
+    g_router->clear();
+    for (size_t zone = 0; zone < g_track_filters.size(); ++zone) {
+        g_track_filters[zone]->stop_output();
+        g_targets[zone]->stop_scans();
     }
-
-    return 0;
+    pipeline_metrics().stop_export();
+    if (g_router->dropped() > 0 || g_router->coalesced() > 0) {
+        std::cerr << FORE_YELLOW << "---> Processing fell behind, " << g_router->dropped() << " messages dropped and "
+                  << g_router->coalesced() << " readings coalesced." << STYLE_RESET << std::endl;
+    }
+    if (g_journal && g_journal->dropped() > 0) {
+        std::cerr << FORE_RED << "---> Journal dropped " << g_journal->dropped() << " messages, the disk could not keep up." << STYLE_RESET << std::endl;
+    }
+    return ok ? 0 : 1;
 }
\ No newline at end of file
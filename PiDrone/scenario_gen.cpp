@@ -0,0 +1,172 @@
+/**
+    * @file scenario_gen.cpp
+    * @brief Publishes simulated sensor traffic to a broker, or writes it to a journal, with its ground truth.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Stand-in for a site full of sensor nodes, see ScenarioGenerator.h. With
+    * --broker it publishes every message on its topic at the simulated pace
+    * (or --speed times faster), for a drone_tracker subscribed to that broker.
+    * Without, it writes the traffic to a journal as fast as the disk takes it,
+    * stamped with simulated time, for drone_tracker --replay. The ground truth
+    * goes to --truth as CSV (t_s,drone,x,y).
+*/
+
+#include <iostream>
+#include <string>
+#include <memory>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include "mqtt/async_client.h"
+#include "ConsoleColors.h"
+#include "Journal.h"
+#include "ScenarioGenerator.h"
+#include "ScenarioIngestSource.h"
+
+const int    QOS          = 0;
+const double TRUTH_HZ     = 10.0;
+// Journals need an end, scenarios that run forever are cut off here unless --duration says otherwise.
+const double DEFAULT_JOURNAL_DURATION_S = 60.0;
+// Wait for the broker to take a publish every this many messages, so a slow broker cannot make the client buffer without end.
+const size_t PUBLISH_WINDOW = 1024;
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " (--scenario <path> | --ring <nodes> <sensors_per_node> <drones>)\n"
+              << "           [--duration <s>] [--format json|binary] [--broker <uri> [--speed <x>]] [--journal <path>] [--truth <path>]\n"
+              << "  --scenario <path>  scenario file, see ScenarioGenerator.h\n"
+              << "  --ring <n> <m> <d> n nodes on a circle with m radars each and d drones flying at random\n"
+              << "  --duration <s>     simulated seconds, overrides the scenario\n"
+              << "  --format <f>       payload format, overrides the scenario\n"
+              << "  --broker <uri>     publish to this broker, e.g. tcp://localhost:1883\n"
+              << "  --speed <x>        publish at x times the simulated pace, 0 as fast as possible (default 1)\n"
+              << "  --journal <path>   record the traffic to a journal, at full speed unless publishing\n"
+              << "  --truth <path>     write the drone positions as CSV, t_s,drone,x,y" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string scenario_path, broker, journal_path, truth_path, format;
+    size_t ring_nodes = 0, ring_sensors = 0, ring_drones = 0;
+    double duration_s = -1.0, speed = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--scenario" && i + 1 < argc) scenario_path = argv[++i];
+        else if (arg == "--ring" && i + 3 < argc) {
+            ring_nodes = std::strtoull(argv[++i], nullptr, 10);
+            ring_sensors = std::strtoull(argv[++i], nullptr, 10);
+            ring_drones = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--duration" && i + 1 < argc) duration_s = std::atof(argv[++i]);
+        else if (arg == "--format" && i + 1 < argc) format = argv[++i];
+        else if (arg == "--broker" && i + 1 < argc) broker = argv[++i];
+        else if (arg == "--speed" && i + 1 < argc) speed = std::atof(argv[++i]);
+        else if (arg == "--journal" && i + 1 < argc) journal_path = argv[++i];
+        else if (arg == "--truth" && i + 1 < argc) truth_path = argv[++i];
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (scenario_path.empty() == (ring_nodes == 0) || (broker.empty() && journal_path.empty())
+        || (!format.empty() && format != "json" && format != "binary")) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    ScenarioConfig config;
+    std::unique_ptr<JournalWriter> journal;
+    FILE* truth = nullptr;
+    try {
+        config = scenario_path.empty() ? ScenarioConfig::ring(ring_nodes, ring_sensors, ring_drones) : load_scenario(scenario_path);
+        if (duration_s >= 0.0) config.duration_s = duration_s;
+        if (broker.empty() && config.duration_s <= 0.0) config.duration_s = DEFAULT_JOURNAL_DURATION_S;
+        if (!format.empty()) config.format = format == "binary" ? PayloadFormat::Binary : PayloadFormat::Json;
+        if (!journal_path.empty()) journal = std::make_unique<JournalWriter>(journal_path);
+    } catch (const std::runtime_error& e) {
+        std::cerr << FORE_RED << "---> CRITICAL: " << e.what() << STYLE_RESET << std::endl;
+        return 1;
+    }
+    if (!truth_path.empty()) {
+        truth = std::fopen(truth_path.c_str(), "w");
+        if (!truth) {
+            std::cerr << FORE_RED << "---> CRITICAL: Cannot create " << truth_path << STYLE_RESET << std::endl;
+            return 1;
+        }
+        std::fputs("t_s,drone,x,y\n", truth);
+    }
+    auto write_truth = [truth](double t, size_t drone, const Point& p) {
+        if (truth) std::fprintf(truth, "%.3f,%zu,%.4f,%.4f\n", t, drone, p.x, p.y);
+    };
+
+    std::cout << "--- Scenario: " << config.sensor_positions().size() << " sensors on " << config.nodes.size() << " nodes, "
+              << config.drones.size() << " drones, "
+              << (config.duration_s > 0.0 ? std::to_string(config.duration_s) + " s" : std::string("until stopped")) << " ---" << std::endl;
+
+    uint64_t generated = 0, lost = 0;
+    const auto start = std::chrono::steady_clock::now();
+    if (broker.empty()) {
+        // Only a journal: no reason to wait, the records carry the simulated time.
+        ScenarioGenerator generator(config);
+        uint64_t truth_tick = 0;
+        IngestMessage msg;
+        while (generator.next(msg)) {
+            for (; static_cast<double>(truth_tick) / TRUTH_HZ <= generator.time_s(); ++truth_tick) {
+                for (size_t d = 0; d < generator.drone_count(); ++d) {
+                    const double t = static_cast<double>(truth_tick) / TRUTH_HZ;
+                    write_truth(t, d, generator.drone_position(d, t));
+                }
+            }
+            msg.received_at = IngestClock::time_point(std::chrono::duration_cast<IngestClock::duration>(
+                std::chrono::duration<double>(generator.time_s())));
+            while (!journal->append(msg)) {
+                std::this_thread::yield();
+            }
+        }
+        generated = generator.generated();
+        lost = generator.dropped();
+    } else {
+        mqtt::async_client client(broker, "scenario_gen");
+        try {
+            mqtt::connect_options conn_opts;
+            conn_opts.set_clean_session(true);
+            client.connect(conn_opts)->wait();
+        } catch (const mqtt::exception& exc) {
+            std::cerr << FORE_RED << "---> CRITICAL: Could not connect to " << broker << ". Error: " << exc.what() << STYLE_RESET << std::endl;
+            return 1;
+        }
+        std::cout << FORE_CYAN << "---> Publishing to " << broker << " at "
+                  << (speed > 0.0 ? std::to_string(speed) + "x" : std::string("full speed")) << STYLE_RESET << std::endl;
+
+        ScenarioIngestSource source(config, speed, write_truth, TRUTH_HZ);
+        bool failed = false;
+        size_t published = 0;
+        source.start([&](IngestMessage&& msg) {
+            if (failed) return;
+            if (journal) journal->append(msg);
+            try {
+                auto token = client.publish(mqtt::make_message(msg.topic, msg.payload, QOS, false));
+                if (++published % PUBLISH_WINDOW == 0) token->wait();
+            } catch (const mqtt::exception& exc) {
+                std::cerr << FORE_RED << "---> Publish failed: " << exc.what() << STYLE_RESET << std::endl;
+                failed = true;
+                source.stop();
+            }
+        });
+        source.join();
+        generated = source.generator().generated();
+        lost = source.generator().dropped();
+        try {
+            client.disconnect()->wait();
+        } catch (const mqtt::exception& exc) {
+            std::cerr << FORE_RED << "[ERROR] while disconnecting: " << exc.what() << STYLE_RESET << std::endl;
+        }
+        if (failed) return 1;
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    journal.reset();
+    if (truth) std::fclose(truth);
+    std::cout << "--- " << generated << " messages in " << elapsed << " s (" << static_cast<double>(generated) / elapsed
+              << " msg/s), " << lost << " lost to dropout ---" << std::endl;
+    return 0;
+}
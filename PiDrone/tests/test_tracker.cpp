@@ -0,0 +1,411 @@
+/**
+    * @file test_tracker.cpp
+    * @brief Behaviour checks for the multilateration solvers, DroneTracker, SensorRegistry, binary payload decoding and the zone handoff of tracks.
+    * @version 1.0
+    * @date 2026-10-16
+    *
+    * Every case builds its own registry and tracker, feeds exact ranges to a
+    * known target and checks the fix that comes back. Registered with ctest,
+    * prints one line per case and exits non-zero if any check failed.
+    *
+    * Usage: test_tracker
+*/
+
+// --- Imports ---
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../DroneTracker.h"
+#include "../MultiTargetTracker.h"
+#include "../Multilateration.h"
+#include "../SensorModel.h"
+#include "../SensorRegistry.h"
+#include "../TrackFilter.h"
+#include "../Trilateration.h"
+// --- End Imports ---
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::printf("CHECK FAILED: %s (%s:%d)\n", #cond, __FILE__, __LINE__);     \
+            ++failures;                                                               \
+        }                                                                             \
+    } while (0)
+
+constexpr double EPS = 1e-6;
+
+double range_to(const Point& sensor, const Point& target) {
+    return std::hypot(sensor.x - target.x, sensor.y - target.y);
+}
+
+bool near(const Point& a, const Point& b, double tolerance = EPS) {
+    return std::hypot(a.x - b.x, a.y - b.y) <= tolerance;
+}
+
+// Corners of a 10 m square, one sensor per node like the ESP32 deployment.
+std::map<std::string, Point> square_layout() {
+    return {{"esp-a/s1", {0.0, 0.0}}, {"esp-b/s1", {10.0, 0.0}},
+            {"esp-c/s1", {10.0, 10.0}}, {"esp-d/s1", {0.0, 10.0}}};
+}
+
+struct Setup {
+    SensorRegistry registry;
+    std::map<std::string, Point> positions;
+    std::map<std::string, SensorHandle> handles;
+
+    explicit Setup(std::map<std::string, Point> layout) : positions(std::move(layout)) {
+        for (const auto& pair : positions) {
+            handles[pair.first] = registry.intern_sensor(pair.first);
+        }
+    }
+};
+
+SubsetSelectionConfig without_grid() {
+    SubsetSelectionConfig selection;
+    selection.grid = false;
+    return selection;
+}
+
+void test_trilaterate_exact() {
+    const Point target{3.0, 4.0};
+    const Point s1{0.0, 0.0}, s2{10.0, 0.0}, s3{0.0, 10.0};
+    const std::optional<Point> p = trilaterate(s1, range_to(s1, target), s2, range_to(s2, target), s3, range_to(s3, target));
+    CHECK(p.has_value());
+    CHECK(p && near(*p, target));
+}
+
+void test_subset_solver_exact() {
+    const std::vector<Point> positions = {{0.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}, {0.0, 10.0}};
+    const Point target{6.5, 2.25};
+    double ranges[SubsetSolver::MAX_SENSORS];
+    for (size_t i = 0; i < positions.size(); ++i) ranges[i] = range_to(positions[i], target);
+
+    SubsetSolver solver(0b1111, positions);
+    CHECK(solver.valid());
+    CHECK(solver.slots().size() == 4);
+    const std::optional<Fix> fix = solver.solve(ranges);
+    CHECK(fix.has_value());
+    if (fix) {
+        CHECK(near(fix->position, target));
+        CHECK(fix->residual_rms < EPS);
+        CHECK(fix->sensors_used == 4);
+        CHECK(fix->sensor_mask == 0b1111);
+    }
+
+    // Three of the four, the slots outside the mask are never read.
+    ranges[1] = -1.0;
+    SubsetSolver three(0b1101, positions);
+    const std::optional<Fix> partial = three.solve(ranges);
+    CHECK(partial && near(partial->position, target));
+    CHECK(partial && partial->sensors_used == 3);
+}
+
+void test_subset_solver_rejects_collinear() {
+    const std::vector<Point> positions = {{0.0, 0.0}, {5.0, 0.0}, {10.0, 0.0}};
+    SubsetSolver solver(0b111, positions);
+    CHECK(!solver.valid());
+    const double ranges[3] = {5.0, 5.0, 5.0};
+    CHECK(!solver.solve(ranges).has_value());
+}
+
+void test_engine_caches_solvers() {
+    MultilaterationEngine engine({{0.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}, {0.0, 10.0}});
+    const SubsetSolver* first = engine.solver(0b0111);
+    CHECK(first != nullptr);
+    CHECK(engine.solver(0b0111) == first);
+    CHECK(engine.solver(0b1110) != first);
+}
+
+void test_engine_evicts_when_full() {
+    // 12 sensors around a circle give 4017 subsets of three or more.
+    std::vector<Point> positions;
+    for (int i = 0; i < 12; ++i) {
+        positions.push_back({10.0 * std::cos(i * M_PI / 6.0), 10.0 * std::sin(i * M_PI / 6.0)});
+    }
+    MultilaterationEngine engine(positions);
+    std::vector<uint64_t> masks;
+    for (uint64_t mask = 0; mask < (uint64_t(1) << 12); ++mask) {
+        if (__builtin_popcountll(mask) >= 3) masks.push_back(mask);
+    }
+
+    // More subsets than the cache holds, each still gets a cached solver that stays until evicted.
+    const size_t cached = MultilaterationEngine::CACHE_SLOTS + MultilaterationEngine::CACHE_SLOTS / 2;
+    for (size_t i = 0; i < cached; ++i) {
+        const SubsetSolver* solver = engine.solver(masks[i]);
+        CHECK(solver != nullptr);
+        CHECK(solver && solver->mask() == masks[i]);
+        CHECK(engine.solver(masks[i]) == solver);
+    }
+
+    // Once nothing more may be parked, misses solve without caching.
+    size_t uncached = 0;
+    for (size_t i = cached; i < masks.size(); ++i) {
+        if (!engine.solver(masks[i])) ++uncached;
+    }
+    CHECK(uncached > 0);
+    CHECK(engine.cached_masks().size() <= MultilaterationEngine::CACHE_SLOTS);
+
+    const Point target{1.5, -2.0};
+    double ranges[12];
+    for (int i = 0; i < 12; ++i) ranges[i] = range_to(positions[i], target);
+    const std::optional<Fix> fix = engine.solve(masks.back(), ranges);
+    CHECK(fix && near(fix->position, target));
+}
+
+void test_tracker_needs_three_sensors() {
+    Setup setup(square_layout());
+    DroneTracker tracker(setup.positions, setup.registry, without_grid());
+    const Point target{2.0, 7.0};
+
+    CHECK(!tracker.updateAndCalculate(setup.handles["esp-a/s1"], range_to(setup.positions["esp-a/s1"], target)));
+    CHECK(!tracker.updateAndCalculate(setup.handles["esp-b/s1"], range_to(setup.positions["esp-b/s1"], target)));
+    const std::optional<Fix> fix = tracker.updateAndCalculate(setup.handles["esp-c/s1"], range_to(setup.positions["esp-c/s1"], target));
+    CHECK(fix && near(fix->position, target));
+    CHECK(fix && fix->sensors_used == 3);
+
+    const std::optional<Fix> all = tracker.updateAndCalculate(setup.handles["esp-d/s1"], range_to(setup.positions["esp-d/s1"], target));
+    CHECK(all && near(all->position, target));
+    CHECK(all && all->sensors_used == 4);
+}
+
+void test_tracker_ignores_unknown_sensor() {
+    Setup setup(square_layout());
+    DroneTracker tracker(setup.positions, setup.registry, without_grid());
+    const SensorHandle stranger = setup.registry.intern_sensor("esp-z/s1");
+    CHECK(stranger != INVALID_SENSOR);
+    CHECK(!tracker.tracks(stranger));
+    CHECK(!tracker.updateAndCalculate(stranger, 1.0));
+}
+
+void test_tracker_withdraw() {
+    Setup setup(square_layout());
+    DroneTracker tracker(setup.positions, setup.registry, without_grid());
+    const Point target{5.0, 5.0};
+    for (const auto& pair : setup.handles) {
+        tracker.updateAndCalculate(pair.second, range_to(setup.positions[pair.first], target));
+    }
+
+    // A withdrawn sensor's old range stays out until it reports again.
+    tracker.withdraw(setup.handles["esp-d/s1"]);
+    const std::optional<Fix> without = tracker.updateAndCalculate(setup.handles["esp-a/s1"], range_to(setup.positions["esp-a/s1"], target));
+    CHECK(without && without->sensors_used == 3);
+    const std::optional<Fix> back = tracker.updateAndCalculate(setup.handles["esp-d/s1"], range_to(setup.positions["esp-d/s1"], target));
+    CHECK(back && back->sensors_used == 4);
+}
+
+void test_tracker_drops_stale() {
+    Setup setup(square_layout());
+    SubsetSelectionConfig selection = without_grid();
+    selection.stale_after_s = 1.0;
+    DroneTracker tracker(setup.positions, setup.registry, selection);
+    const Point target{4.0, 1.0};
+    const IngestClock::time_point start = IngestClock::now();
+
+    tracker.updateAndCalculate(setup.handles["esp-d/s1"], range_to(setup.positions["esp-d/s1"], target), 0, start);
+    const IngestClock::time_point later = start + std::chrono::seconds(5);
+    tracker.updateAndCalculate(setup.handles["esp-a/s1"], range_to(setup.positions["esp-a/s1"], target), 0, later);
+    tracker.updateAndCalculate(setup.handles["esp-b/s1"], range_to(setup.positions["esp-b/s1"], target), 0, later);
+    const std::optional<Fix> fix = tracker.updateAndCalculate(setup.handles["esp-c/s1"], range_to(setup.positions["esp-c/s1"], target), 0, later);
+    CHECK(fix && fix->sensors_used == 3);
+    CHECK(fix && near(fix->position, target));
+}
+
+void test_tracker_grid_selection() {
+    // Ring of eight around the origin, the grid picks a well conditioned subset per cell.
+    std::map<std::string, Point> ring;
+    for (int i = 0; i < 8; ++i) {
+        const double angle = i * M_PI / 4.0;
+        ring["esp-" + std::to_string(i) + "/s1"] = {8.0 * std::cos(angle), 8.0 * std::sin(angle)};
+    }
+    Setup setup(ring);
+    DroneTracker tracker(setup.positions, setup.registry);
+    const Point target{1.5, -2.0};
+
+    std::optional<Fix> last;
+    for (int round = 0; round < 3; ++round) {
+        for (const auto& pair : setup.handles) {
+            std::optional<Fix> fix = tracker.updateAndCalculate(pair.second, range_to(setup.positions[pair.first], target));
+            if (fix) last = fix;
+        }
+    }
+    CHECK(last.has_value());
+    CHECK(last && near(last->position, target, 1e-3));
+    CHECK(last && last->sensors_used >= DroneTracker::MIN_SENSORS);
+    CHECK(last && last->dop > 0.0);
+}
+
+void test_tracker_reload() {
+    Setup setup(square_layout());
+    DroneTracker tracker(setup.positions, setup.registry, without_grid());
+
+    // esp-d moves, ranges measured from its new position must solve to the target.
+    setup.positions["esp-d/s1"] = {-5.0, 5.0};
+    tracker.reload(setup.positions, setup.registry);
+    const Point target{3.0, 3.0};
+    std::optional<Fix> fix;
+    for (const auto& pair : setup.handles) {
+        fix = tracker.updateAndCalculate(pair.second, range_to(setup.positions[pair.first], target));
+    }
+    CHECK(fix && fix->sensors_used == 4);
+    CHECK(fix && near(fix->position, target));
+
+    // Removed sensors are no longer tracked.
+    setup.positions.erase("esp-d/s1");
+    tracker.reload(setup.positions, setup.registry);
+    CHECK(!tracker.tracks(setup.handles["esp-d/s1"]));
+}
+
+void test_registry_full() {
+    SensorRegistry registry(2, 3);
+    CHECK(registry.intern_sensor("esp-a/s1") != INVALID_SENSOR);
+    CHECK(registry.intern_sensor("esp-a/s2") != INVALID_SENSOR);
+    CHECK(registry.intern_sensor("esp-b/s1") != INVALID_SENSOR);
+    // Sensor table full.
+    CHECK(registry.intern_sensor("esp-b/s2") == INVALID_SENSOR);
+    // Known ids still resolve to their handle.
+    CHECK(registry.intern_sensor("esp-a/s1") == registry.find_sensor("esp-a/s1"));
+    // Node table full.
+    CHECK(registry.intern_node("esp-c") == INVALID_NODE);
+    CHECK(registry.intern_sensor("no-slash") == INVALID_SENSOR);
+}
+
+Fix fix_at(const Point& position, uint16_t zone, uint16_t source_zone) {
+    Fix fix;
+    fix.position = position;
+    fix.sensors_used = 3;
+    fix.zone = zone;
+    fix.source_zone = source_zone;
+    return fix;
+}
+
+void test_track_filter_hand_over() {
+    TrackFilter north, south;
+    const IngestClock::time_point start = IngestClock::now();
+    for (int i = 0; i < 10; ++i) {
+        north.update(fix_at({1.0 * i, 0.0}, 0, 0), start + std::chrono::milliseconds(100 * i));
+    }
+    const IngestClock::time_point at = start + std::chrono::seconds(1);
+    const TrackState before = north.extrapolate(at);
+
+    CHECK(north.hand_over(south, at));
+    const TrackState moved = south.extrapolate(at);
+    CHECK(moved.valid);
+    CHECK(moved.updates == before.updates);
+    CHECK(near(moved.position, before.position));
+    CHECK(near(moved.velocity, before.velocity));
+    CHECK(!north.extrapolate(at).valid);
+
+    // Nothing to hand over any more, and a zone with a live track keeps its own.
+    CHECK(!north.hand_over(south, at));
+    north.update(fix_at({20.0, 0.0}, 0, 0), at);
+    CHECK(!north.hand_over(south, at));
+}
+
+void test_targets_hand_over() {
+    MultiTargetConfig config;
+    config.confirm_hits = 1;
+    MultiTargetTracker north(config), south(config);
+    const IngestClock::time_point start = IngestClock::now();
+    north.add_fix(fix_at({4.0, 4.0}, 0, 0));
+    north.process_scan(start);
+    CHECK(north.tracks().size() == 1);
+    const uint32_t id = north.tracks().empty() ? 0 : north.tracks()[0].id;
+
+    CHECK(!north.hand_over({30.0, 30.0}, south));
+    CHECK(north.hand_over({4.5, 4.0}, south));
+    north.process_scan(start);
+    south.process_scan(start);
+    CHECK(north.tracks().empty());
+    CHECK(south.tracks().size() == 1);
+    CHECK(!south.tracks().empty() && south.tracks()[0].id == id);
+}
+
+std::string binary_payload(float range, float speed) {
+    std::string payload(BINARY_PAYLOAD_SIZE, '\0');
+    payload[0] = static_cast<char>(BINARY_PAYLOAD_MAGIC);
+    payload[1] = static_cast<char>(BINARY_PAYLOAD_VERSION);
+    payload[3] = static_cast<char>(BINARY_FLAG_PRESENCE);
+    std::memcpy(&payload[12], &range, sizeof(range));
+    std::memcpy(&payload[16], &speed, sizeof(speed));
+    return payload;
+}
+
+std::string batch_frame(const std::string& sensor_id, const std::string& reading) {
+    std::string frame(BATCH_FRAME_HEADER_SIZE, '\0');
+    frame[0] = static_cast<char>(BATCH_FRAME_MAGIC);
+    frame[1] = static_cast<char>(BATCH_FRAME_VERSION);
+    frame[2] = 1;
+    frame += static_cast<char>(sensor_id.size());
+    frame += sensor_id;
+    frame += reading;
+    return frame;
+}
+
+bool rejected(const std::string& payload) {
+    try {
+        SensorData::from_binary(payload);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+void test_binary_payload_rejects_non_finite() {
+    const std::string good = binary_payload(12.5f, -1.0f);
+    CHECK(!rejected(good));
+    CHECK(BatchFrameView(batch_frame("s1", good)).valid());
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    for (const std::string& bad : {binary_payload(nan, 0.0f), binary_payload(inf, 0.0f),
+                                   binary_payload(1.0f, -inf), binary_payload(1.0f, nan)}) {
+        CHECK(!BinaryPayloadView(bad).valid());
+        CHECK(rejected(bad));
+        CHECK(!BatchFrameView(batch_frame("s1", bad)).valid());
+    }
+}
+
+} // namespace
+
+int main() {
+    struct Case {
+        const char* name;
+        void (*run)();
+    };
+    const Case cases[] = {
+        {"trilaterate_exact", test_trilaterate_exact},
+        {"subset_solver_exact", test_subset_solver_exact},
+        {"subset_solver_rejects_collinear", test_subset_solver_rejects_collinear},
+        {"engine_caches_solvers", test_engine_caches_solvers},
+        {"engine_evicts_when_full", test_engine_evicts_when_full},
+        {"tracker_needs_three_sensors", test_tracker_needs_three_sensors},
+        {"tracker_ignores_unknown_sensor", test_tracker_ignores_unknown_sensor},
+        {"tracker_withdraw", test_tracker_withdraw},
+        {"tracker_drops_stale", test_tracker_drops_stale},
+        {"tracker_grid_selection", test_tracker_grid_selection},
+        {"tracker_reload", test_tracker_reload},
+        {"registry_full", test_registry_full},
+        {"track_filter_hand_over", test_track_filter_hand_over},
+        {"targets_hand_over", test_targets_hand_over},
+        {"binary_payload_rejects_non_finite", test_binary_payload_rejects_non_finite},
+    };
+    for (const Case& c : cases) {
+        const int before = failures;
+        c.run();
+        std::printf("%-34s %s\n", c.name, failures == before ? "ok" : "FAILED");
+    }
+    if (failures) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}